@@ -0,0 +1,387 @@
+#ifndef DDBENCH_JSON_HPP
+#define DDBENCH_JSON_HPP
+
+#include <charconv>   // for to_chars
+#include <cstddef>    // for size_t
+#include <exception>  // for exception
+#include <stdexcept>  // for runtime_error
+#include <string>     // for string
+#include <utility>    // for move, pair
+#include <vector>     // for vector
+
+/**
+ * Minimal JSON value for the ddbench scenario, result and baseline files.
+ * Objects keep their members in insertion order so that written files are
+ * stable under diffs.
+ */
+class Json {
+   public:
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    using Array = std::vector<Json>;
+    using Object = std::vector<std::pair<std::string, Json>>;
+
+   private:
+    Type        type_{Type::Null};
+    bool        boolean{};
+    double      real{};
+    std::string text;
+    Array       array;
+    Object      object;
+
+    class Parser {
+        std::string const& s;
+        size_t             p{};
+
+        [[noreturn]] void fail(char const* what) const {
+            throw std::runtime_error("Json: " + std::string(what) +
+                                     " at offset " + std::to_string(p));
+        }
+
+        void skipSpace() {
+            while (p < s.size() && (s[p] == ' ' || s[p] == '\t' ||
+                                    s[p] == '\n' || s[p] == '\r')) {
+                ++p;
+            }
+        }
+
+        bool consume(char const* word) {
+            auto const n = std::char_traits<char>::length(word);
+            if (s.compare(p, n, word) != 0) {
+                return false;
+            }
+            p += n;
+            return true;
+        }
+
+        std::string parseString() {
+            std::string out;
+            ++p;  // opening quote
+            while (p < s.size() && s[p] != '"') {
+                char c = s[p++];
+                if (c == '\\') {
+                    if (p >= s.size()) {
+                        fail("unterminated escape");
+                    }
+                    switch (c = s[p++]) {
+                        case 'n':
+                            c = '\n';
+                            break;
+                        case 't':
+                            c = '\t';
+                            break;
+                        case 'r':
+                            c = '\r';
+                            break;
+                        case '"':
+                        case '\\':
+                        case '/':
+                            break;
+                        default:
+                            fail("unsupported escape");
+                    }
+                }
+                out.push_back(c);
+            }
+            if (p >= s.size()) {
+                fail("unterminated string");
+            }
+            ++p;  // closing quote
+            return out;
+        }
+
+        Json parseValue() {
+            skipSpace();
+            if (p >= s.size()) {
+                fail("unexpected end");
+            }
+            char const c = s[p];
+            if (c == '{') {
+                Json v = Json::makeObject();
+                ++p;
+                skipSpace();
+                if (p < s.size() && s[p] == '}') {
+                    ++p;
+                    return v;
+                }
+                while (true) {
+                    skipSpace();
+                    if (p >= s.size() || s[p] != '"') {
+                        fail("expected member name");
+                    }
+                    auto key = parseString();
+                    skipSpace();
+                    if (p >= s.size() || s[p++] != ':') {
+                        fail("expected ':'");
+                    }
+                    v.set(key, parseValue());
+                    skipSpace();
+                    if (p < s.size() && s[p] == ',') {
+                        ++p;
+                    } else if (p < s.size() && s[p] == '}') {
+                        ++p;
+                        return v;
+                    } else {
+                        fail("expected ',' or '}'");
+                    }
+                }
+            }
+            if (c == '[') {
+                Json v = Json::makeArray();
+                ++p;
+                skipSpace();
+                if (p < s.size() && s[p] == ']') {
+                    ++p;
+                    return v;
+                }
+                while (true) {
+                    v.push(parseValue());
+                    skipSpace();
+                    if (p < s.size() && s[p] == ',') {
+                        ++p;
+                    } else if (p < s.size() && s[p] == ']') {
+                        ++p;
+                        return v;
+                    } else {
+                        fail("expected ',' or ']'");
+                    }
+                }
+            }
+            if (c == '"') {
+                return Json(parseString());
+            }
+            if (consume("true")) {
+                return Json(true);
+            }
+            if (consume("false")) {
+                return Json(false);
+            }
+            if (consume("null")) {
+                return {};
+            }
+            size_t     used = 0;
+            auto const sub = s.substr(p, 64);
+            double     d = 0;
+            try {
+                d = std::stod(sub, &used);
+            } catch (std::exception const&) {
+                fail("unexpected character");
+            }
+            p += used;
+            return Json(d);
+        }
+
+       public:
+        explicit Parser(std::string const& _s) : s(_s) {}
+
+        Json parse() {
+            Json v = parseValue();
+            skipSpace();
+            if (p != s.size()) {
+                fail("trailing characters");
+            }
+            return v;
+        }
+    };
+
+    static void quote(std::string& out, std::string const& t) {
+        out.push_back('"');
+        for (char c : t) {
+            switch (c) {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                default:
+                    out.push_back(c);
+            }
+        }
+        out.push_back('"');
+    }
+
+    void dump(std::string& out, int indent) const {
+        auto const newline = [&](int k) {
+            out.push_back('\n');
+            out.append(static_cast<size_t>(k) * 2, ' ');
+        };
+        switch (type_) {
+            case Type::Null:
+                out += "null";
+                break;
+            case Type::Bool:
+                out += boolean ? "true" : "false";
+                break;
+            case Type::Number: {
+                char buf[32];
+                auto r = std::to_chars(buf, buf + sizeof(buf), real);
+                out.append(buf, r.ptr);
+                break;
+            }
+            case Type::String:
+                quote(out, text);
+                break;
+            case Type::Array:
+                out.push_back('[');
+                for (auto i = 0UL; i < array.size(); ++i) {
+                    out += (i == 0) ? "" : ",";
+                    newline(indent + 1);
+                    array[i].dump(out, indent + 1);
+                }
+                if (!array.empty()) {
+                    newline(indent);
+                }
+                out.push_back(']');
+                break;
+            case Type::Object:
+                out.push_back('{');
+                for (auto i = 0UL; i < object.size(); ++i) {
+                    out += (i == 0) ? "" : ",";
+                    newline(indent + 1);
+                    quote(out, object[i].first);
+                    out += ": ";
+                    object[i].second.dump(out, indent + 1);
+                }
+                if (!object.empty()) {
+                    newline(indent);
+                }
+                out.push_back('}');
+                break;
+        }
+    }
+
+   public:
+    Json() = default;
+
+    explicit Json(bool b) : type_(Type::Bool), boolean(b) {}
+
+    explicit Json(double d) : type_(Type::Number), real(d) {}
+
+    explicit Json(std::string s) : type_(Type::String), text(std::move(s)) {}
+
+    explicit Json(char const* s) : Json(std::string(s)) {}
+
+    static Json makeArray() {
+        Json v;
+        v.type_ = Type::Array;
+        return v;
+    }
+
+    static Json makeObject() {
+        Json v;
+        v.type_ = Type::Object;
+        return v;
+    }
+
+    /**
+     * Parses a document.
+     * @param s the text.
+     * @return the value.
+     * @exception std::runtime_error the text is not valid JSON.
+     */
+    static Json parse(std::string const& s) { return Parser(s).parse(); }
+
+    [[nodiscard]] Type type() const { return type_; }
+
+    [[nodiscard]] bool isNull() const { return type_ == Type::Null; }
+
+    [[nodiscard]] double asNumber() const {
+        if (type_ != Type::Number) {
+            throw std::runtime_error("Json: number expected");
+        }
+        return real;
+    }
+
+    [[nodiscard]] bool asBool() const {
+        if (type_ != Type::Bool) {
+            throw std::runtime_error("Json: boolean expected");
+        }
+        return boolean;
+    }
+
+    [[nodiscard]] std::string const& asString() const {
+        if (type_ != Type::String) {
+            throw std::runtime_error("Json: string expected");
+        }
+        return text;
+    }
+
+    [[nodiscard]] Array const& asArray() const {
+        if (type_ != Type::Array) {
+            throw std::runtime_error("Json: array expected");
+        }
+        return array;
+    }
+
+    [[nodiscard]] Object const& asObject() const {
+        if (type_ != Type::Object) {
+            throw std::runtime_error("Json: object expected");
+        }
+        return object;
+    }
+
+    /**
+     * Gets a member of an object.
+     * @param key the member name.
+     * @return the member, or a null value if it is absent or this value is
+     * null.
+     */
+    [[nodiscard]] Json const& operator[](std::string const& key) const {
+        static Json const none;
+        if (isNull()) {
+            return none;
+        }
+        for (auto const& [k, v] : asObject()) {
+            if (k == key) {
+                return v;
+            }
+        }
+        return none;
+    }
+
+    /**
+     * Gets a numeric member with a default.
+     */
+    [[nodiscard]] double number(std::string const& key, double dflt) const {
+        auto const& v = (*this)[key];
+        return v.isNull() ? dflt : v.asNumber();
+    }
+
+    /**
+     * Sets a member of an object, replacing an existing one.
+     */
+    Json& set(std::string const& key, Json v) {
+        static_cast<void>(asObject());
+        for (auto& [k, old] : object) {
+            if (k == key) {
+                old = std::move(v);
+                return *this;
+            }
+        }
+        object.emplace_back(key, std::move(v));
+        return *this;
+    }
+
+    Json& push(Json v) {
+        static_cast<void>(asArray());
+        array.push_back(std::move(v));
+        return *this;
+    }
+
+    /**
+     * Writes the value with two-space indentation.
+     * @return the text.
+     */
+    [[nodiscard]] std::string dump() const {
+        std::string out;
+        dump(out, 0);
+        out.push_back('\n');
+        return out;
+    }
+};
+
+#endif  // DDBENCH_JSON_HPP
@@ -0,0 +1,494 @@
+/**
+ * ddbench: end-to-end timings of the DdStructure pipeline.
+ *
+ * Usage:
+ *   ddbench SCENARIOS [--out RESULT] [--baseline BASELINE]
+ *           [--time-tolerance T] [--memory-tolerance M] [--time-floor MS]
+ *           [--counters]
+ *
+ * SCENARIOS is a JSON file of the form
+ *   {"scenarios": [{"name": "comb", "spec": "combination",
+ *                   "params": {"n": 200, "k": 40},
+ *                   "pipeline": ["build", "reduce", "evaluate"],
+ *                   "repetitions": 5}]}
+ * with the specs
+ *   combination  n, k           k-subsets of n items
+ *   simpath      rows, cols     simple corner-to-corner paths of a grid
+ *   random       levels, width, density, seed
+ * and the steps
+ *   build        construct the diagram from the spec (must come first)
+ *   subset       ZDD subsetting by sets of at most params.subset_max_items
+ *   reduce       ZDD reduction, or BDD reduction if params.reduction is "bdd"
+ *   evaluate     count the paths to the 1-terminal
+ *   enumerate    iterate over at most params.enumerate_limit sets
+ *
+ * Every repetition runs the whole pipeline. The result records, for each
+ * step, the node count and the median, minimum and maximum time, and for
+ * each scenario the peak resident memory. With --counters, it also records
+ * under "counters" the hardware performance counters of every pipeline
+ * phase per repetition (see DdProfile; events the system does not provide
+ * are omitted, and counters are not checked against the baseline). Reading
+ * the counters costs system calls inside the timed steps, so they are off
+ * by default and timings meant for a baseline are taken without them.
+ * With a baseline, node counts and results must match exactly, median times
+ * may exceed the baseline by the time tolerance (ignoring differences below
+ * the floor) and peak memory by the memory tolerance; a scenario can
+ * override both tolerances with "tolerance": {"time": T, "memory": M}. The
+ * exit code is 1 if any check fails.
+ */
+
+#include <sys/resource.h>  // for getrusage
+
+#include <ModernDD/NodeBddProfile.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/FrontierManager.hpp>
+#include <ModernDD/spec/PathSpec.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/BenchNode.hpp"
+#include "Json.hpp"
+
+/**
+ * Sets of at most k of n items, for subsetting.
+ */
+class ItemLimit : public DdSpec<ItemLimit, int, 2> {
+    int const n;
+    int const k;
+
+   public:
+    ItemLimit(int _n, int _k) : n(_n), k(_k) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state += value;
+        if (state > k) {
+            return 0;
+        }
+        return (--level == 0) ? -1 : level;
+    }
+};
+
+/**
+ * Pseudo-random diagram: the state is a column in [0, width) chosen by
+ * hashing the parent state, the level and the branch, and an arc at
+ * level 1 reaches the 1-terminal with the given probability.
+ */
+class RandomDd : public DdSpec<RandomDd, int, 2> {
+    int const      levels;
+    int const      width;
+    uint64_t const threshold;
+    uint64_t const seed;
+
+    [[nodiscard]] uint64_t mix(int state, int level, int value) const {
+        uint64_t x = seed ^ (uint64_t(state) << 32U) ^
+                     (uint64_t(level) << 1U) ^ uint64_t(value);
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27U)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31U);
+    }
+
+   public:
+    RandomDd(int _levels, int _width, double density, uint64_t _seed)
+        : levels(_levels),
+          width(std::max(_width, 1)),
+          threshold(static_cast<uint64_t>(density * 1048576.0)),
+          seed(_seed) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return levels;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        auto const h = mix(state, level, value);
+        if (--level == 0) {
+            return ((h >> 44U) < threshold) ? -1 : 0;
+        }
+        state = static_cast<int>(h % static_cast<uint64_t>(width));
+        return level;
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+
+struct StepResult {
+    std::string         name;
+    size_t              nodes{};
+    std::vector<double> ms;
+};
+
+struct ScenarioResult {
+    std::vector<StepResult> steps;
+    double                  paths{-1};
+    double                  enumerated{-1};
+    long                    peakKb{};
+    Json                    counters;  ///< Null unless counted.
+};
+
+/**
+ * Resets the peak resident set size of the process where the kernel
+ * allows it, so that the peak of each scenario is measured separately.
+ */
+void resetPeakMemory() {
+    std::ofstream f("/proc/self/clear_refs");
+    if (f) {
+        f << "5";
+    }
+}
+
+long peakMemoryKb() {
+    std::ifstream f("/proc/self/status");
+    std::string   line;
+    while (std::getline(f, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::stol(line.substr(6));
+        }
+    }
+    rusage u{};
+    getrusage(RUSAGE_SELF, &u);
+    return u.ru_maxrss;
+}
+
+template <typename SPEC>
+ScenarioResult run(SPEC const& spec,
+                   int         topLevel,
+                   Json const& scenario,
+                   bool        counters) {
+    auto const& params = scenario["params"];
+    auto const  reps =
+        std::max(1, static_cast<int>(scenario.number("repetitions", 1)));
+    bool const bdd = !params["reduction"].isNull() &&
+                     params["reduction"].asString() == "bdd";
+    auto const maxItems =
+        static_cast<int>(params.number("subset_max_items", topLevel));
+    auto const limit = params.number("enumerate_limit", 1e6);
+
+    ScenarioResult result;
+    for (auto const& s : scenario["pipeline"].asArray()) {
+        result.steps.push_back({s.asString(), 0, {}});
+    }
+    if (result.steps.empty() || result.steps.front().name != "build") {
+        throw std::runtime_error("the pipeline must start with build");
+    }
+
+    DdProfile                            profile;
+    std::optional<DdProfile::Activation> on;
+    if (counters) {
+        on.emplace(profile);
+    }
+    resetPeakMemory();
+    for (int r = 0; r < reps; ++r) {
+        std::optional<DdStructure<PathCountNode>> dd;
+        for (auto& step : result.steps) {
+            auto const t0 = Clock::now();
+            if (step.name == "build") {
+                dd.emplace(spec);
+            } else if (step.name == "subset") {
+                dd->zddSubset(ItemLimit(topLevel, maxItems));
+            } else if (step.name == "reduce") {
+                bdd ? dd->bddReduce() : dd->reduceZdd();
+            } else if (step.name == "evaluate") {
+                PathCountEval eval;
+                result.paths = dd->evaluate_backward(eval);
+            } else if (step.name == "enumerate") {
+                double n = 0;
+                for (auto it = dd->begin(); it != dd->end() && n < limit;
+                     ++it) {
+                    ++n;
+                }
+                result.enumerated = n;
+            } else {
+                throw std::runtime_error("unknown step " + step.name);
+            }
+            auto const t1 = Clock::now();
+            step.ms.push_back(
+                std::chrono::duration<double, std::milli>(t1 - t0).count());
+            step.nodes = dd->size();
+        }
+    }
+    result.peakKb = peakMemoryKb();
+    if (!counters) {
+        return result;
+    }
+
+    result.counters = Json::makeObject();
+    for (auto p = 0UL; p < DD_PHASE_COUNT; ++p) {
+        auto const total = profile.total(static_cast<DdPhase>(p));
+        if (total.calls == 0) {
+            continue;
+        }
+        Json phase = Json::makeObject();
+        phase.set("calls", Json(static_cast<double>(total.calls) / reps));
+        for (auto k = 0UL; k < PERF_EVENT_COUNT; ++k) {
+            if (profile.available(static_cast<PerfEvent>(k))) {
+                phase.set(PERF_EVENT_NAMES[k],
+                          Json(static_cast<double>(total.value[k]) / reps));
+            }
+        }
+        result.counters.set(DD_PHASE_NAMES[p], phase);
+    }
+    return result;
+}
+
+ScenarioResult run(Json const& scenario, bool counters) {
+    auto const& params = scenario["params"];
+    auto const& spec = scenario["spec"].asString();
+    auto const  param = [&](char const* key) {
+        if (params[key].isNull()) {
+            throw std::runtime_error("spec " + spec + " needs params." + key);
+        }
+        return static_cast<int>(params[key].asNumber());
+    };
+
+    if (spec == "combination") {
+        return run(Combination(param("n"), param("k")), param("n"), scenario,
+                   counters);
+    }
+    if (spec == "simpath") {
+        auto const g = Graph::grid(param("rows"), param("cols"));
+        auto const t = g.numVertices() - 1;
+        return run(SimplePathSpec(g, 0, t), g.numEdges(), scenario,
+                   counters);
+    }
+    if (spec == "random") {
+        auto const seed = static_cast<uint64_t>(params.number("seed", 1));
+        return run(RandomDd(param("levels"), param("width"),
+                            params.number("density", 0.5), seed),
+                   param("levels"), scenario, counters);
+    }
+    throw std::runtime_error("unknown spec " + spec);
+}
+
+double median(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    auto const m = v.size() / 2;
+    return (v.size() % 2 == 1) ? v[m] : (v[m - 1] + v[m]) / 2;
+}
+
+Json toJson(Json const& scenario, ScenarioResult const& r) {
+    Json out = Json::makeObject();
+    out.set("name", scenario["name"]);
+    out.set("spec", scenario["spec"]);
+    out.set("repetitions", Json(static_cast<double>(r.steps[0].ms.size())));
+    out.set("peak_rss_kb", Json(static_cast<double>(r.peakKb)));
+    if (r.paths >= 0) {
+        out.set("paths", Json(r.paths));
+    }
+    if (r.enumerated >= 0) {
+        out.set("enumerated", Json(r.enumerated));
+    }
+    Json steps = Json::makeArray();
+    for (auto const& s : r.steps) {
+        Json step = Json::makeObject();
+        step.set("step", Json(s.name));
+        step.set("nodes", Json(static_cast<double>(s.nodes)));
+        step.set("median_ms", Json(median(s.ms)));
+        step.set("min_ms", Json(*std::min_element(s.ms.begin(), s.ms.end())));
+        step.set("max_ms", Json(*std::max_element(s.ms.begin(), s.ms.end())));
+        steps.push(step);
+    }
+    out.set("steps", steps);
+    if (!r.counters.isNull()) {
+        out.set("counters", r.counters);
+    }
+    return out;
+}
+
+struct Tolerance {
+    double time{0.10};
+    double memory{0.20};
+    double floorMs{1.0};
+};
+
+/**
+ * Compares a scenario result with its baseline and reports each check.
+ * @return the number of failed checks.
+ */
+int compare(Json const& result,
+            Json const& base,
+            Tolerance   tol,
+            Json const& scenario) {
+    auto const& t = scenario["tolerance"];
+    if (!t.isNull()) {
+        tol.time = t.number("time", tol.time);
+        tol.memory = t.number("memory", tol.memory);
+    }
+
+    auto const& name = result["name"].asString();
+    int         failed = 0;
+    auto const  report = [&](std::string const& what, bool ok,
+                            std::string const& detail) {
+        std::cout << (ok ? "  ok    " : "  FAIL  ") << name << " " << what
+                  << ": " << detail << "\n";
+        failed += ok ? 0 : 1;
+    };
+    auto const ratio = [](double now, double then) {
+        std::ostringstream os;
+        os.precision(6);
+        os << now << " vs " << then;
+        if (then > 0) {
+            os << " (" << std::showpos << 100 * (now / then - 1)
+               << std::noshowpos << "%)";
+        }
+        return os.str();
+    };
+
+    for (char const* key : {"paths", "enumerated"}) {
+        auto const& now = result[key];
+        auto const& then = base[key];
+        if (!now.isNull() && !then.isNull()) {
+            auto const a = now.asNumber();
+            auto const b = then.asNumber();
+            report(key, std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b)),
+                   ratio(a, b));
+        }
+    }
+
+    auto const& steps = result["steps"].asArray();
+    auto const& baseSteps = base["steps"].asArray();
+    for (auto i = 0UL; i < steps.size(); ++i) {
+        auto const& s = steps[i];
+        auto const  step = s["step"].asString();
+        if (i >= baseSteps.size() ||
+            baseSteps[i]["step"].asString() != step) {
+            report(step, true, "no baseline");
+            continue;
+        }
+        auto const& b = baseSteps[i];
+        auto const  nodes = s["nodes"].asNumber();
+        auto const  baseNodes = b["nodes"].asNumber();
+        report(step + " nodes", nodes == baseNodes, ratio(nodes, baseNodes));
+
+        auto const now = s["median_ms"].asNumber();
+        auto const then = b["median_ms"].asNumber();
+        report(step + " time",
+               now <= then * (1 + tol.time) || now - then < tol.floorMs,
+               ratio(now, then) + " ms");
+    }
+
+    auto const mem = result["peak_rss_kb"].asNumber();
+    auto const baseMem = base["peak_rss_kb"].asNumber();
+    report("peak memory", mem <= baseMem * (1 + tol.memory),
+           ratio(mem, baseMem) + " kB");
+    return failed;
+}
+
+Json load(std::string const& path) {
+    std::ifstream f(path);
+    if (!f) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    std::stringstream ss;
+    ss << f.rdbuf();
+    return Json::parse(ss.str());
+}
+
+int main(int argc, char** argv) {
+    std::string scenarioPath;
+    std::string outPath;
+    std::string baselinePath;
+    Tolerance   tol;
+    bool        counters = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string const arg = argv[i];
+            auto const        value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::runtime_error(arg + " needs a value");
+                }
+                return argv[++i];
+            };
+            if (arg == "--out") {
+                outPath = value();
+            } else if (arg == "--baseline") {
+                baselinePath = value();
+            } else if (arg == "--time-tolerance") {
+                tol.time = std::stod(value());
+            } else if (arg == "--memory-tolerance") {
+                tol.memory = std::stod(value());
+            } else if (arg == "--time-floor") {
+                tol.floorMs = std::stod(value());
+            } else if (arg == "--counters") {
+                counters = true;
+            } else if (scenarioPath.empty() && arg[0] != '-') {
+                scenarioPath = arg;
+            } else {
+                throw std::runtime_error("unknown argument " + arg);
+            }
+        }
+        if (scenarioPath.empty()) {
+            throw std::runtime_error("no scenario file");
+        }
+    } catch (std::exception const& e) {
+        std::cerr << "ddbench: " << e.what() << "\n"
+                  << "usage: ddbench SCENARIOS [--out RESULT] "
+                     "[--baseline BASELINE] [--time-tolerance T] "
+                     "[--memory-tolerance M] [--time-floor MS] "
+                     "[--counters]\n";
+        return 2;
+    }
+
+    try {
+        auto const scenarios = load(scenarioPath);
+        Json       results = Json::makeObject();
+        Json       list = Json::makeArray();
+        for (auto const& scenario : scenarios["scenarios"].asArray()) {
+            auto const& name = scenario["name"].asString();
+            std::cerr << "ddbench: running " << name << "\n";
+            list.push(toJson(scenario, run(scenario, counters)));
+        }
+        results.set("scenarios", list);
+
+        if (!outPath.empty()) {
+            std::ofstream f(outPath);
+            f << results.dump();
+        } else if (baselinePath.empty()) {
+            std::cout << results.dump();
+        }
+
+        if (baselinePath.empty()) {
+            return 0;
+        }
+        auto const  baseline = load(baselinePath);
+        int         failed = 0;
+        auto const& scenarioList = scenarios["scenarios"].asArray();
+        auto const& resultList = results["scenarios"].asArray();
+        for (auto i = 0UL; i < resultList.size(); ++i) {
+            auto const& name = resultList[i]["name"].asString();
+            Json const* base = nullptr;
+            for (auto const& b : baseline["scenarios"].asArray()) {
+                if (b["name"].asString() == name) {
+                    base = &b;
+                }
+            }
+            if (base == nullptr) {
+                std::cout << "  new   " << name << ": no baseline\n";
+                continue;
+            }
+            failed += compare(resultList[i], *base, tol, scenarioList[i]);
+        }
+        std::cout << (failed == 0 ? "ddbench: no regression\n"
+                                  : "ddbench: " + std::to_string(failed) +
+                                        " check(s) failed\n");
+        return failed == 0 ? 0 : 1;
+    } catch (std::exception const& e) {
+        std::cerr << "ddbench: " << e.what() << "\n";
+        return 2;
+    }
+}
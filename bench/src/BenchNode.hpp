@@ -0,0 +1,87 @@
+#ifndef BENCH_NODE_HPP
+#define BENCH_NODE_HPP
+
+#include <ModernDD/NodeBase.hpp>     // for NodeBase
+#include <ModernDD/NodeBddEval.hpp>  // for Eval
+#include <ModernDD/NodeBddSpec.hpp>  // for DdSpec
+#include <ModernDD/NodeId.hpp>       // for NodeId
+#include <cstddef>                   // for size_t
+
+/**
+ * Minimal node type for the benchmarks.
+ * It carries the node label bookkeeping that DdReducer expects.
+ */
+class BenchNode : public NodeBase {
+    NodeId label{};
+    NodeId ptr{};
+
+   public:
+    BenchNode() = default;
+    BenchNode(size_t i, size_t j) : NodeBase(i, j) {}
+    BenchNode(NodeId f0, NodeId f1) : NodeBase(f0, f1) {}
+
+    void set_node_id_label(NodeId f) { label = f; }
+
+    void set_ptr_node_id(NodeId f) { ptr = f; }
+
+    [[nodiscard]] NodeId get_ptr_node_id() const { return ptr; }
+};
+
+/**
+ * Benchmark node with the number of paths to the 1-terminal, as a double
+ * so that the counts of large diagrams do not wrap.
+ */
+struct PathCountNode : BenchNode {
+    using BenchNode::BenchNode;
+
+    double count{};
+};
+
+/**
+ * Counts the paths to the 1-terminal, which are the sets of a ZDD.
+ */
+class PathCountEval : public Eval<PathCountNode, double> {
+   public:
+    void initialize_node(PathCountNode& n) const override { n.count = 0; }
+
+    void initialize_root_node(PathCountNode& n) const override { n.count = 1; }
+
+    void evalNode(PathCountNode& n) const override {
+        auto* nodes = get_table();
+        n.count = nodes->node(n[0]).count + nodes->node(n[1]).count;
+    }
+
+    double get_objective(PathCountNode& n) const override { return n.count; }
+};
+
+/**
+ * k-subsets of n items.
+ */
+class Combination : public DdSpec<Combination, int, 2> {
+    int n;
+    int k;
+
+   public:
+    Combination(int _n, int _k) : n(_n), k(_k) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state += value;
+        if (--level == 0) {
+            return (state == k) ? -1 : 0;
+        }
+        if (state > k) {
+            return 0;
+        }
+        if (state + level < k) {
+            return 0;
+        }
+        return level;
+    }
+};
+
+#endif  // BENCH_NODE_HPP
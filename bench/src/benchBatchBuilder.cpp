@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddBatchBuilder.hpp>
+#include <ModernDD/util/ThreadPool.hpp>
+#include <vector>
+
+#include "BenchNode.hpp"
+
+static std::vector<Combination> makeSpecs(int count) {
+    std::vector<Combination> specs;
+    for (int i = 0; i < count; ++i) {
+        specs.emplace_back(100 + i % 50, 5 + i % 20);
+    }
+    return specs;
+}
+
+static void BM_SerialBuilds(benchmark::State& st) {
+    auto const specs = makeSpecs(static_cast<int>(st.range(0)));
+    for (auto _ : st) {
+        for (auto const& spec : specs) {
+            DdStructure<BenchNode> dd(spec);
+            dd.reduceZdd();
+            benchmark::DoNotOptimize(dd.root());
+        }
+    }
+}
+
+static void BM_BatchBuilds(benchmark::State& st) {
+    auto const                specs = makeSpecs(static_cast<int>(st.range(0)));
+    ThreadPool                pool;
+    DdBatchBuilder<BenchNode> batch(pool, DdBuildMethod::BreadthFirst, true);
+    for (auto _ : st) {
+        auto results = batch.build(specs);
+        benchmark::DoNotOptimize(results.data());
+    }
+}
+
+BENCHMARK(BM_SerialBuilds)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BatchBuilds)
+    ->Arg(100)
+    ->Arg(500)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddQuery.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/FrontierManager.hpp>
+#include <ModernDD/spec/PathSpec.hpp>
+#include <random>
+#include <vector>
+
+#include "BenchNode.hpp"
+
+/**
+ * Diagram 0: simple paths of the 9x9 grid, wide and irregular, so that the
+ * queries of a block rarely meet. Diagram 1: 20-subsets of 400 items, at
+ * most 21 nodes per level, so that they meet all the time.
+ */
+static DdStructure<BenchNode> const& diagram(int64_t which) {
+    static DdStructure<BenchNode> paths = [] {
+        auto const             g = Graph::grid(9, 9);
+        DdStructure<BenchNode> x(SimplePathSpec(g, 0, 80));
+        x.reduceZdd();
+        return x;
+    }();
+    static DdStructure<BenchNode> subsets = [] {
+        DdStructure<BenchNode> x(Combination(400, 20));
+        x.reduceZdd();
+        return x;
+    }();
+    return (which == 0) ? paths : subsets;
+}
+
+/**
+ * Random members of the family, every other one with one item flipped.
+ */
+static DdBitSlices makeQueries(DdStructure<BenchNode> const& dd) {
+    auto const   top = dd.root().row();
+    size_t const count = 1UL << 16;
+    DdBitSlices  s(top, count);
+    std::mt19937 gen(1);
+    for (auto q = 0UL; q < count; ++q) {
+        NodeId f = dd.root();
+        while (f.row() > 0) {
+            int b = static_cast<int>(gen() % 2);
+            if (dd.child(f, b) == 0) {
+                b = 1 - b;
+            }
+            if (b) {
+                s.set(q, f.row());
+            }
+            f = dd.child(f, b);
+        }
+        if (q % 2) {
+            auto const i = 1 + gen() % top;
+            s.set(q, i, !s.get(q, i));
+        }
+    }
+    return s;
+}
+
+static DdBitSlices const& queries(int64_t which) {
+    static DdBitSlices const paths = makeQueries(diagram(0));
+    static DdBitSlices const subsets = makeQueries(diagram(1));
+    return (which == 0) ? paths : subsets;
+}
+
+static void BM_WalkEach(benchmark::State& st) {
+    auto const&                    dd = diagram(st.range(0));
+    auto const&                    x = queries(st.range(0));
+    std::vector<std::vector<char>> rows(x.size());
+    for (auto q = 0UL; q < x.size(); ++q) {
+        rows[q].resize(x.topLevel() + 1);
+        for (auto i = 1UL; i <= x.topLevel(); ++i) {
+            rows[q][i] = x.get(q, i);
+        }
+    }
+    for (auto _ : st) {
+        size_t found = 0;
+        for (auto const& r : rows) {
+            NodeId f = dd.root();
+            bool   ok = true;
+            for (auto i = x.topLevel(); i >= 1 && ok; --i) {
+                if (f.row() == i) {
+                    f = dd.child(f, r[i]);
+                } else {
+                    ok = !r[i];
+                }
+            }
+            found += (ok && f == 1) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    st.SetItemsProcessed(st.iterations() * x.size());
+}
+
+static void BM_Batched(benchmark::State& st) {
+    auto const&             dd = diagram(st.range(0));
+    auto const&             x = queries(st.range(0));
+    DdBatchQuery<BenchNode> query(dd);
+    for (auto _ : st) {
+        auto result = query.contains(x);
+        benchmark::DoNotOptimize(result);
+    }
+    st.SetItemsProcessed(st.iterations() * x.size());
+}
+
+BENCHMARK(BM_WalkEach)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Batched)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddEval.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "BenchNode.hpp"
+
+constexpr double inf = std::numeric_limits<double>::infinity();
+
+struct PathNode : BenchNode {
+    using BenchNode::BenchNode;
+
+    size_t level{};
+    double cost{};
+    double bound{};
+};
+
+/**
+ * Cheapest set of a ZDD, taking item i costs w[i].
+ */
+class CheapestSet : public BoundedEval<PathNode, double> {
+    std::vector<double> const& w;
+
+   public:
+    explicit CheapestSet(std::vector<double> const& _w) : w(_w) {}
+
+    void initialize_node(PathNode& n) const override { n.cost = inf; }
+
+    void initialize_root_node(PathNode& n) const override { n.cost = 0.0; }
+
+    void evalNode(PathNode& n) const override {
+        auto& nodes = *get_table();
+        for (auto b = 0UL; b < 2; ++b) {
+            auto& c = nodes.node(n[b]);
+            c.cost = std::min(c.cost, n.cost + (b ? w[n.level] : 0.0));
+        }
+    }
+
+    double get_objective(PathNode& n) const override { return n.cost; }
+
+    double cost(PathNode const& n) const override { return n.cost; }
+
+    double completion_bound(PathNode const& n) const override {
+        return n.bound;
+    }
+};
+
+/**
+ * Pricing-like instance: sets of k out of n items with mostly positive
+ * reduced costs; the bounds are the sums of the negative costs below.
+ */
+struct Instance {
+    std::vector<double>   w;
+    DdStructure<PathNode> dd;
+
+    Instance(int n, int k, int negatives) : w(n + 1), dd(Combination(n, k)) {
+        for (auto i = 1; i <= n; ++i) {
+            w[i] = (i % (n / negatives) == 0) ? -1.0 : 0.25 + (i * 37 % 11);
+        }
+        dd.reduceZdd();
+        auto&  table = *dd.getDiagram();
+        double sum = 0.0;
+        for (auto i = 0UL; i < table.numRows(); ++i) {
+            sum += std::min(0.0, w[i]);
+            for (auto& it : table[i]) {
+                it.level = i;
+                it.bound = sum;
+            }
+        }
+    }
+};
+
+static void BM_ForwardEval(benchmark::State& st) {
+    Instance    inst(static_cast<int>(st.range(0)), 20, 8);
+    CheapestSet eval(inst.w);
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(inst.dd.evaluate_forward(eval));
+    }
+    st.counters["nodes"] = static_cast<double>(inst.dd.size());
+}
+
+static void BM_BoundedEval(benchmark::State& st) {
+    Instance    inst(static_cast<int>(st.range(0)), 20, 8);
+    CheapestSet eval(inst.w);
+    auto const  cutoff = static_cast<double>(st.range(1));
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(
+            inst.dd.evaluate_forward_bounded(eval, cutoff));
+    }
+    st.counters["nodes"] = static_cast<double>(inst.dd.size());
+}
+
+BENCHMARK(BM_ForwardEval)->Arg(400)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BoundedEval)
+    ->Args({400, 0})
+    ->Args({400, 2})
+    ->Args({400, 1000})
+    ->Unit(benchmark::kMillisecond);
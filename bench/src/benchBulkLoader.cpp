@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddBulkLoader.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "BenchNode.hpp"
+
+/**
+ * Loads a pool of sets generated in ZddLoadOrder: the bits of increasing
+ * codes, each code a random step after the previous one. The steps keep
+ * the pool sparse in its low items, as in a pool of columns.
+ */
+static void BM_BulkLoad(benchmark::State& st) {
+    auto const       numSets = static_cast<size_t>(st.range(0));
+    size_t const     n = 40;
+    std::vector<int> set;
+    for (auto _ : st) {
+        std::mt19937_64          rng(1);
+        ZddBulkLoader<BenchNode> loader(n);
+        uint64_t                 code = 0;
+        for (auto k = 0UL; k < numSets; ++k) {
+            code += 1 + rng() % 4096;
+            set.clear();
+            for (auto i = 0UL; i < n; ++i) {
+                if ((code >> i & 1U) != 0) {
+                    set.push_back(static_cast<int>(i + 1));
+                }
+            }
+            loader.add(set);
+        }
+        auto const dd = loader.finish();
+        st.counters["nodes"] = static_cast<double>(dd.size());
+    }
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+
+BENCHMARK(BM_BulkLoad)
+    ->Arg(100000)
+    ->Arg(10000000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddChain.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <algorithm>
+
+#include "BenchNode.hpp"
+
+/**
+ * Sets of n items in which the upper half is free and the lower half is
+ * split in pairs, at most one item of a pair and exactly k items in total
+ * being chosen there.
+ */
+class Mixed : public DdSpec<Mixed, int, 2> {
+    int const n;
+    int const k;
+
+   public:
+    Mixed(int _n, int _k) : n(_n), k(_k) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    /**
+     * The state is twice the number of items chosen in the lower half, plus
+     * 1 while the upper item of the current pair is chosen.
+     */
+    int getChild(int& state, int level, int value) const {
+        if (level <= n / 2) {
+            bool const upper = (level % 2) == 0;
+            if (value && !upper && (state & 1)) {
+                return 0;
+            }
+            state += value ? 2 : 0;
+            state = upper ? ((state & ~1) | value) : (state & ~1);
+        }
+        int const chosen = state / 2;
+        if (--level == 0) {
+            return (chosen == k) ? -1 : 0;
+        }
+        if (chosen > k || chosen + (std::min(level, n / 2) + 1) / 2 < k) {
+            return 0;
+        }
+        return level;
+    }
+};
+
+static void BM_ChainReduce(benchmark::State& st) {
+    auto const             n = static_cast<int>(st.range(0));
+    DdStructure<BenchNode> zdd(Mixed(n, 10));
+    DdStructure<BenchNode> bdd(zdd);
+    zdd.reduceZdd();
+    bdd.bddReduce();
+    size_t chained = 0;
+    for (auto _ : st) {
+        ChainDd const c(zdd, true, n);
+        chained = c.size();
+        benchmark::DoNotOptimize(c.root());
+    }
+    st.counters["zdd"] = static_cast<double>(zdd.size());
+    st.counters["bdd"] = static_cast<double>(bdd.size());
+    st.counters["chain"] = static_cast<double>(chained);
+}
+
+static void BM_ChainCount(benchmark::State& st) {
+    auto const             n = static_cast<int>(st.range(0));
+    DdStructure<BenchNode> zdd(Mixed(n, 10));
+    zdd.reduceZdd();
+    ChainDd const c(zdd, true, n);
+    for (auto _ : st) {
+        auto x = c.evaluate<double>(
+            [](bool b) { return b ? 1.0 : 0.0; },
+            [](int, double c0, double c1) { return c0 + c1; });
+        benchmark::DoNotOptimize(x);
+    }
+}
+
+BENCHMARK(BM_ChainReduce)->Arg(100)->Arg(400)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ChainCount)->Arg(100)->Arg(400)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+
+#include "BenchNode.hpp"
+
+static void BM_BreadthFirstZdd(benchmark::State& st) {
+    auto const n = static_cast<int>(st.range(0));
+    auto const k = static_cast<int>(st.range(1));
+    for (auto _ : st) {
+        DdStructure<BenchNode> dd(Combination(n, k));
+        dd.reduceZdd();
+        benchmark::DoNotOptimize(dd.root());
+        st.counters["nodes"] = static_cast<double>(dd.size());
+    }
+}
+
+static void BM_DepthFirstZdd(benchmark::State& st) {
+    auto const n = static_cast<int>(st.range(0));
+    auto const k = static_cast<int>(st.range(1));
+    for (auto _ : st) {
+        DdStructure<BenchNode> dd(Combination(n, k),
+                                  DdBuildMethod::DepthFirstZdd);
+        benchmark::DoNotOptimize(dd.root());
+        st.counters["nodes"] = static_cast<double>(dd.size());
+    }
+}
+
+BENCHMARK(BM_BreadthFirstZdd)
+    ->Args({1000, 4})
+    ->Args({4000, 4})
+    ->Args({1000, 32})
+    ->Args({4000, 32});
+BENCHMARK(BM_DepthFirstZdd)
+    ->Args({1000, 4})
+    ->Args({4000, 4})
+    ->Args({1000, 32})
+    ->Args({4000, 32});
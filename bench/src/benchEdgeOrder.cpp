@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/EdgeOrder.hpp>
+#include <ModernDD/spec/ForestSpec.hpp>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "BenchNode.hpp"
+
+static Graph shuffledGrid(int n) {
+    auto             g = Graph::grid(n, n);
+    std::vector<int> order(g.numEdges());
+    std::iota(order.begin(), order.end(), 0);
+    std::mt19937 gen(1);
+    std::shuffle(order.begin(), order.end(), gen);
+    return EdgeOrderOptimizer(g).apply(order);
+}
+
+static void BM_ShuffledOrder(benchmark::State& st) {
+    auto const g = shuffledGrid(static_cast<int>(st.range(0)));
+    for (auto _ : st) {
+        DdStructure<BenchNode> dd(SpanningTreeSpec{g});
+        dd.reduceZdd();
+        benchmark::DoNotOptimize(dd.root());
+        st.counters["width"] = FrontierManager(g).maxFrontierSize();
+        st.counters["nodes"] = static_cast<double>(dd.size());
+    }
+}
+
+static void BM_OptimizedOrder(benchmark::State& st) {
+    auto const g = shuffledGrid(static_cast<int>(st.range(0)));
+    for (auto _ : st) {
+        EdgeOrderOptimizer const opt(g);
+        auto const               order = opt.best();
+        DdStructure<BenchNode>   dd(SpanningTreeSpec{opt.apply(order.edges)});
+        dd.reduceZdd();
+        benchmark::DoNotOptimize(dd.root());
+        st.counters["width"] = order.width;
+        st.counters["nodes"] = static_cast<double>(dd.size());
+    }
+}
+
+static void BM_OptimizeOnly(benchmark::State& st) {
+    auto const g = shuffledGrid(static_cast<int>(st.range(0)));
+    for (auto _ : st) {
+        EdgeOrderOptimizer const opt(g);
+        auto const               order = opt.best();
+        benchmark::DoNotOptimize(order.width);
+    }
+}
+
+BENCHMARK(BM_ShuffledOrder)->Arg(4)->Arg(5)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_OptimizedOrder)
+    ->Arg(4)
+    ->Arg(5)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_OptimizeOnly)
+    ->Arg(8)
+    ->Arg(32)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddEdgeValued.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "BenchNode.hpp"
+
+struct Load {
+    int64_t weight;
+    int64_t cost;
+};
+
+/**
+ * Pricing-like knapsack: the state carries the cost added since the last
+ * node, which the edge-valued builder factors out.
+ */
+class Knapsack : public DdSpec<Knapsack, Load, 2> {
+    std::vector<int64_t> weights;
+    std::vector<int64_t> costs;
+    int64_t              capacity;
+
+   public:
+    Knapsack(int n, int64_t _capacity, unsigned seed) : capacity(_capacity) {
+        std::mt19937 gen(seed);
+        for (int i = 0; i < n; ++i) {
+            weights.push_back(1 + static_cast<int64_t>(gen() % 20));
+            costs.push_back(static_cast<int64_t>(gen() % 1000) - 500);
+        }
+    }
+
+    int getRoot(Load& s) const {
+        s = {0, 0};
+        return static_cast<int>(weights.size());
+    }
+
+    int getChild(Load& s, int level, int value) const {
+        if (value) {
+            s.weight += weights[level - 1];
+            s.cost += costs[level - 1];
+            if (s.weight > capacity) {
+                return 0;
+            }
+        }
+        if (--level == 0) {
+            return -1;
+        }
+        return level;
+    }
+
+    int64_t factorOffset(Load& s, int) const {
+        auto const c = s.cost;
+        s.cost = 0;
+        return c;
+    }
+};
+
+static void BM_CostInState(benchmark::State& st) {
+    Knapsack const spec(static_cast<int>(st.range(0)), 40, 1);
+    size_t         built = 0;
+    size_t         nodes = 0;
+    for (auto _ : st) {
+        DdStructure<BenchNode> dd(spec);
+        built = dd.size();
+        dd.reduceZdd();
+        nodes = dd.size();
+        benchmark::DoNotOptimize(dd.root());
+    }
+    st.counters["built"] = static_cast<double>(built);
+    st.counters["nodes"] = static_cast<double>(nodes);
+}
+
+static void BM_EdgeValued(benchmark::State& st) {
+    Knapsack const spec(static_cast<int>(st.range(0)), 40, 1);
+    size_t         built = 0;
+    size_t         nodes = 0;
+    for (auto _ : st) {
+        EdgeValuedDd<> dd(spec);
+        built = dd.size();
+        dd.reduceZdd();
+        nodes = dd.size();
+        benchmark::DoNotOptimize(dd.minimum());
+    }
+    st.counters["built"] = static_cast<double>(built);
+    st.counters["nodes"] = static_cast<double>(nodes);
+}
+
+BENCHMARK(BM_CostInState)->Arg(16)->Arg(24)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EdgeValued)->Arg(16)->Arg(24)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/util/Executor.hpp>
+#include <ModernDD/util/ThreadPool.hpp>
+#include <functional>
+#include <memory>
+
+#include "BenchNode.hpp"
+
+/**
+ * Sets whose weight sum is below a bound; the levels are thousands of nodes
+ * wide.
+ */
+class Capacity : public DdSpec<Capacity, int, 2> {
+    int const n;
+    int const bound;
+
+   public:
+    Capacity(int _n, int _bound) : n(_n), bound(_bound) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state += value * (level * 7919 % 1000);
+        if (state >= bound) {
+            return 0;
+        }
+        return (--level == 0) ? -1 : level;
+    }
+};
+
+/**
+ * Builds and reduces on the calling thread (0), a ThreadPool (1), OpenMP
+ * (2) or a caller-owned pool behind ExternalExecutor (3).
+ */
+static void BM_BuildAndReduce(benchmark::State& st) {
+    auto const                kind = st.range(0);
+    auto const                threads = static_cast<size_t>(st.range(1));
+    ThreadPool                pool(threads);
+    std::unique_ptr<Executor> executor;
+    if (kind == 2) {
+        executor = std::make_unique<OpenMpExecutor>(threads);
+    } else if (kind == 3) {
+        executor = std::make_unique<ExternalExecutor>(
+            [&](std::function<void()> task) { pool.submit(std::move(task)); },
+            threads);
+    }
+    Executor* const used = (kind == 1) ? &pool : executor.get();
+
+    for (auto _ : st) {
+        DdStructure<BenchNode> dd;
+        if (used == nullptr) {
+            dd = DdStructure<BenchNode>(Capacity(60, 40000));
+        } else {
+            dd = DdStructure<BenchNode>(Capacity(60, 40000), *used);
+        }
+        dd.reduceZdd();
+        benchmark::DoNotOptimize(dd.root());
+    }
+}
+
+BENCHMARK(BM_BuildAndReduce)
+    ->Args({0, 1})
+    ->Args({1, 4})
+    ->Args({2, 4})
+    ->Args({3, 4})
+    ->Unit(benchmark::kMillisecond);
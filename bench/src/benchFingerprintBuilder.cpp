@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <array>
+
+#include "BenchNode.hpp"
+
+/**
+ * Sets of k items out of n whose items fall into 32 classes by residue;
+ * the state records the count of each class, 128 bytes.
+ */
+class ClassCounts : public DdSpec<ClassCounts, std::array<int, 32>, 2> {
+    int const n;
+    int const k;
+
+   public:
+    ClassCounts(int _n, int _k) : n(_n), k(_k) {}
+
+    int getRoot(std::array<int, 32>& s) const {
+        s.fill(0);
+        return n;
+    }
+
+    int getChild(std::array<int, 32>& s, int level, int value) const {
+        if (value != 0) {
+            ++s[level % 32];
+        }
+        int total = 0;
+        for (auto c : s) {
+            total += c;
+        }
+        if (--level == 0) {
+            return (total == k) ? -1 : 0;
+        }
+        return (total > k || total + level < k) ? 0 : level;
+    }
+
+    size_t hashCode(std::array<int, 32> const& s) const {
+        size_t h = 0;
+        for (auto c : s) {
+            h = h * 31 + static_cast<size_t>(c);
+        }
+        return h;
+    }
+};
+
+static void BM_BreadthFirstBuild(benchmark::State& st) {
+    auto const n = static_cast<int>(st.range(0));
+    for (auto _ : st) {
+        DdStructure<BenchNode> dd(ClassCounts(n, 5));
+        benchmark::DoNotOptimize(dd.root());
+    }
+}
+
+static void BM_FingerprintBuild(benchmark::State& st) {
+    auto const n = static_cast<int>(st.range(0));
+    auto const verify = st.range(1) != 0;
+    for (auto _ : st) {
+        FingerprintReport      report;
+        DdStructure<BenchNode> dd(ClassCounts(n, 5), report, verify);
+        benchmark::DoNotOptimize(dd.root());
+        st.counters["lookups"] = static_cast<double>(report.lookups);
+        st.counters["nodes"] = static_cast<double>(report.entries);
+        st.counters["bound"] = report.collisionBound;
+    }
+}
+
+BENCHMARK(BM_BreadthFirstBuild)->Arg(48)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FingerprintBuild)
+    ->Args({48, 0})
+    ->Args({48, 1})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,190 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/ForestSpec.hpp>
+#include <ModernDD/spec/MatchingSpec.hpp>
+#include <ModernDD/spec/PathSpec.hpp>
+#include <cassert>
+#include <vector>
+
+#include "BenchNode.hpp"
+
+/**
+ * The hand-rolled mate-array spec of the Simpath test (example2.cpp), with
+ * an int per vertex of a window that is shifted along the grid.
+ */
+class Simpath : public PodArrayDdSpec<Simpath, int, 2> {
+    using Edge = std::pair<int, int>;
+
+    int const         rows;
+    int const         cols;
+    int const         numVertex;  // V = {1..numVertex}
+    int const         numEdge;    // E = {0..numEdge-1}
+    int const         mateSize;
+    std::vector<Edge> edges;
+
+    class MateArray {
+        int* const array;
+        int const  offset;
+        int const  size;
+
+       public:
+        MateArray(int* state, int _offset, int _size)
+            : array(state - _offset),
+              offset(_offset),
+              size(_size) {}
+
+        int& operator[](int v) {
+            assert(0 <= v - offset && v - offset < size);
+            return array[v];
+        }
+    };
+
+   public:
+    Simpath(int _rows, int _cols)
+        : rows(_rows),
+          cols(_cols),
+          numVertex(_rows * _cols),
+          numEdge(_rows * _cols * 2 - _rows - _cols),
+          mateSize(cols + 1) {
+        edges.reserve(numEdge);
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+                int v = i * cols + j + 1;
+                if (j + 1 < cols)
+                    edges.emplace_back(v, v + 1);
+                if (i + 1 < rows)
+                    edges.emplace_back(v, v + cols);
+            }
+        }
+        assert(edges.size() == size_t(numEdge));
+
+        setArraySize(mateSize);
+    }
+
+    int getRoot(int* state) const {
+        MateArray mate(state, 1, mateSize);
+        mate[1] = -1;
+        for (int v = 2; v <= mateSize; ++v) {
+            mate[v] = (v == numVertex) ? -1 : v;
+        }
+        return numEdge;
+    }
+
+    int getChild(int* state, int level, int take) const {
+        int e = numEdge - level;
+        assert(0 <= e && e < numEdge);
+        int       v1 = edges[e].first;
+        int       v2 = edges[e].second;
+        MateArray mate(state, v1, mateSize);
+
+        if (take) {
+            int w1 = mate[v1];
+            int w2 = mate[v2];
+
+            if (w1 == 0 || w2 == 0)
+                return 0;  // already visited
+            if (w1 == v2)
+                return 0;  // cycle made
+
+            if (w1 < 0 && w2 < 0) {  // s-t path completed
+                for (int v = v1 + 1; v < v1 + mateSize; ++v) {
+                    if (v == v2)
+                        continue;
+                    if (mate[v] != 0 && mate[v] != v)
+                        return 0;  // endpoint found
+                }
+                return -1;  // OK
+            }
+
+            mate[v1] = 0;
+            mate[v2] = 0;
+            if (w1 > 0)
+                mate[w1] = w2;
+            if (w2 > 0)
+                mate[w2] = w1;
+        }
+
+        if (e + 1 < numEdge) {
+            int vv = edges[e + 1].first;
+            int d = vv - v1;
+            if (d > 0) {
+                for (int v = v1; v < vv; ++v) {  // check leaving elements
+                    if (mate[v] != 0 && mate[v] != v)
+                        return 0;  // endpoint found
+                }
+                for (int v = vv; v < v1 + mateSize; ++v) {  // shift elements
+                    mate[v - d] = mate[v];
+                }
+                for (int v = v1 + mateSize; v < vv + mateSize;
+                     ++v) {  // init new elements
+                    mate[v - d] = (v == numVertex) ? -1 : v;
+                }
+            }
+        }
+
+        return level - 1;
+    }
+};
+
+static void BM_TestSimpath(benchmark::State& st) {
+    auto const n = static_cast<int>(st.range(0));
+    for (auto _ : st) {
+        DdStructure<BenchNode> dd(Simpath(n, n));
+        dd.reduceZdd();
+        benchmark::DoNotOptimize(dd.root());
+        st.counters["nodes"] = static_cast<double>(dd.size());
+    }
+}
+
+static void BM_SimplePathSpec(benchmark::State& st) {
+    auto const n = static_cast<int>(st.range(0));
+    auto const g = Graph::grid(n, n);
+    for (auto _ : st) {
+        DdStructure<BenchNode> dd(SimplePathSpec(g, 0, g.numVertices() - 1));
+        dd.reduceZdd();
+        benchmark::DoNotOptimize(dd.root());
+        st.counters["nodes"] = static_cast<double>(dd.size());
+    }
+}
+
+static void BM_SpanningTreeSpec(benchmark::State& st) {
+    auto const n = static_cast<int>(st.range(0));
+    auto const g = Graph::grid(n, n);
+    for (auto _ : st) {
+        DdStructure<BenchNode> dd(SpanningTreeSpec{g});
+        dd.reduceZdd();
+        benchmark::DoNotOptimize(dd.root());
+        st.counters["nodes"] = static_cast<double>(dd.size());
+    }
+}
+
+static void BM_PerfectMatchingSpec(benchmark::State& st) {
+    auto const n = static_cast<int>(st.range(0));
+    auto const g = Graph::grid(n, n);
+    for (auto _ : st) {
+        DdStructure<BenchNode> dd(MatchingSpec(g, true));
+        dd.reduceZdd();
+        benchmark::DoNotOptimize(dd.root());
+        st.counters["nodes"] = static_cast<double>(dd.size());
+    }
+}
+
+BENCHMARK(BM_TestSimpath)
+    ->Arg(6)
+    ->Arg(8)
+    ->Arg(9)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SimplePathSpec)
+    ->Arg(6)
+    ->Arg(8)
+    ->Arg(9)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SpanningTreeSpec)
+    ->Arg(6)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PerfectMatchingSpec)
+    ->Arg(8)
+    ->Arg(12)
+    ->Unit(benchmark::kMillisecond);
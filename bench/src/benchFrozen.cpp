@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddFrozen.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/FrontierManager.hpp>
+#include <ModernDD/spec/PathSpec.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "BenchNode.hpp"
+
+static DdStructure<BenchNode> const& paths() {
+    static DdStructure<BenchNode> dd = [] {
+        auto const             g = Graph::grid(9, 9);
+        DdStructure<BenchNode> x(SimplePathSpec(g, 0, 80));
+        x.reduceZdd();
+        return x;
+    }();
+    return dd;
+}
+
+static void BM_CountTable(benchmark::State& st) {
+    auto const& dd = paths();
+    auto const& table = *dd.getDiagram();
+    for (auto _ : st) {
+        std::vector<std::vector<uint64_t>> count{{0, 1}};
+        count.resize(table.numRows());
+        for (auto i = 1UL; i < table.numRows(); ++i) {
+            count[i].resize(table[i].size());
+            for (auto j = 0UL; j < table[i].size(); ++j) {
+                NodeId const f0 = table.child(i, j, 0);
+                NodeId const f1 = table.child(i, j, 1);
+                count[i][j] = count[f0.row()][f0.col()] +
+                              count[f1.row()][f1.col()];
+            }
+        }
+        benchmark::DoNotOptimize(count[dd.root().row()][dd.root().col()]);
+    }
+    st.counters["bytes"] = static_cast<double>(dd.size() * sizeof(BenchNode));
+}
+
+static void BM_CountFrozen(benchmark::State& st) {
+    FrozenDd const frozen(paths());
+    for (auto _ : st) {
+        auto n = frozen.evaluate<uint64_t>(
+            [](bool b) { return b ? 1UL : 0UL; },
+            [](int, uint64_t c0, uint64_t c1) { return c0 + c1; });
+        benchmark::DoNotOptimize(n);
+    }
+    st.counters["bytes"] = static_cast<double>(frozen.bytes());
+}
+
+static void BM_Freeze(benchmark::State& st) {
+    for (auto _ : st) {
+        FrozenDd const frozen(paths());
+        benchmark::DoNotOptimize(frozen.root());
+    }
+}
+
+BENCHMARK(BM_CountTable)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CountFrozen)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Freeze)->Unit(benchmark::kMillisecond);
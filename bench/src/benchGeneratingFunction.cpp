@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddGeneratingFunction.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <cstdint>
+
+#include "BenchNode.hpp"
+
+/**
+ * Wide spec: subsets whose weight sum is divisible by m, up to m states per
+ * level.
+ */
+class WeightModulo : public DdSpec<WeightModulo, int, 2> {
+    int const n;
+    int const m;
+
+   public:
+    WeightModulo(int _n, int _m) : n(_n), m(_m) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state = (state + value * (level * 7919 % m)) % m;
+        if (--level == 0) {
+            return (state == 0) ? -1 : 0;
+        }
+        return level;
+    }
+};
+
+template <typename C>
+static void BM_CountBySize(benchmark::State& st) {
+    auto const             n = static_cast<int>(st.range(0));
+    DdStructure<BenchNode> dd(WeightModulo(n, 500));
+    dd.reduceZdd();
+    DdGeneratingFunction<BenchNode, C> const gf(static_cast<size_t>(n));
+    for (auto _ : st) {
+        auto const counts = gf.evaluate(dd);
+        benchmark::DoNotOptimize(counts.data());
+    }
+    st.counters["nodes"] = static_cast<double>(dd.size());
+}
+
+BENCHMARK_TEMPLATE(BM_CountBySize, uint64_t)
+    ->Arg(100)
+    ->Unit(benchmark::kMillisecond);
+__extension__ typedef unsigned __int128 Wide;
+
+BENCHMARK_TEMPLATE(BM_CountBySize, Wide)
+    ->Arg(100)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_CountBySize, ModularCount<1000000007>)
+    ->Arg(100)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/PathSpec.hpp>
+#include <ModernDD/util/HashPolicy.hpp>
+#include <ModernDD/util/MyHashTable.hpp>
+#include <vector>
+
+#include "BenchNode.hpp"
+
+/**
+ * The nodes of an unreduced path diagram, the keys of the reducer's unique
+ * tables.
+ */
+static std::vector<NodeBase> const& diagramNodes() {
+    static std::vector<NodeBase> const nodes = [] {
+        std::vector<NodeBase>  v;
+        DdStructure<BenchNode> dd(SimplePathSpec(Graph::grid(8, 8), 0, 63));
+        auto const&            table = *dd.getDiagram();
+        for (auto i = 1UL; i < table.numRows(); ++i) {
+            for (auto j = 0UL; j < table[i].size(); ++j) {
+                v.emplace_back(table.child(i, j, 0), table.child(i, j, 1));
+            }
+        }
+        return v;
+    }();
+    return nodes;
+}
+
+template <typename P>
+struct PolicyHasher {
+    size_t operator()(NodeBase const& n) const { return n.hashWith<P>(); }
+
+    bool operator()(NodeBase const& a, NodeBase const& b) const {
+        return a == b;
+    }
+};
+
+template <typename P>
+static void BM_HashNodes(benchmark::State& st) {
+    auto const&           nodes = diagramNodes();
+    PolicyHasher<P> const hasher;
+    for (auto _ : st) {
+        size_t h = 0;
+        for (auto const& n : nodes) {
+            h ^= hasher(n);
+        }
+        benchmark::DoNotOptimize(h);
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * nodes.size()));
+}
+
+template <typename P>
+static void BM_UniqueTable(benchmark::State& st) {
+    auto const& nodes = diagramNodes();
+    size_t      collisions = 0;
+    size_t      size = 0;
+    for (auto _ : st) {
+        MyHashTable<NodeBase, PolicyHasher<P>, PolicyHasher<P>> table(
+            nodes.size() / 4);
+        for (auto const& n : nodes) {
+            if (!(n == NodeBase())) {
+                table.add(n);
+            }
+        }
+        collisions = table.collisions();
+        size = table.size();
+        benchmark::DoNotOptimize(size);
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * nodes.size()));
+    st.counters["keys"] = static_cast<double>(size);
+    st.counters["collisions"] = static_cast<double>(collisions);
+}
+
+/**
+ * End-to-end reduction with the policy the library was configured with.
+ */
+static void BM_ReduceConfigured(benchmark::State& st) {
+    DdStructure<BenchNode> const dd(SimplePathSpec(Graph::grid(8, 8), 0, 63));
+    for (auto _ : st) {
+        DdStructure<BenchNode> copy(dd);
+        copy.reduceZdd();
+        benchmark::DoNotOptimize(copy.size());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_HashNodes, MultiplicativeHash);
+BENCHMARK_TEMPLATE(BM_HashNodes, Mix64Hash);
+BENCHMARK_TEMPLATE(BM_UniqueTable, MultiplicativeHash)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_UniqueTable, Mix64Hash)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReduceConfigured)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+
+#include "BenchNode.hpp"
+
+/**
+ * One search node: fix a variable near the top and undo it.
+ */
+static void BM_CopyPerSearchNode(benchmark::State& st) {
+    DdStructure<BenchNode> dd(Combination(static_cast<int>(st.range(0)), 40));
+    dd.reduceZdd();
+    for (auto _ : st) {
+        DdStructure<BenchNode> child(dd);
+        child.fix(static_cast<int>(st.range(0)) - 20, true);
+        benchmark::DoNotOptimize(child.root());
+    }
+}
+
+static void BM_CheckpointPerSearchNode(benchmark::State& st) {
+    DdStructure<BenchNode> dd(Combination(static_cast<int>(st.range(0)), 40));
+    dd.reduceZdd();
+    for (auto _ : st) {
+        dd.checkpoint();
+        dd.fix(static_cast<int>(st.range(0)) - 20, true);
+        benchmark::DoNotOptimize(dd.root());
+        dd.rollback();
+    }
+}
+
+BENCHMARK(BM_CopyPerSearchNode)->Arg(500)->Arg(2000);
+BENCHMARK(BM_CheckpointPerSearchNode)->Arg(500)->Arg(2000);
@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+
+#include "BenchNode.hpp"
+
+/**
+ * Wide spec: subsets whose weight sum is divisible by m, up to m states per
+ * level.
+ */
+class WeightModulo : public DdSpec<WeightModulo, int, 2> {
+    int const n;
+    int const m;
+
+   public:
+    WeightModulo(int _n, int _m) : n(_n), m(_m) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state = (state + value * (level * 7919 % m)) % m;
+        if (--level == 0) {
+            return (state == 0) ? -1 : 0;
+        }
+        return level;
+    }
+};
+
+static void BM_BreadthFirstConstruct(benchmark::State& st) {
+    auto const n = static_cast<int>(st.range(0));
+    auto const m = static_cast<int>(st.range(1));
+    for (auto _ : st) {
+        DdStructure<BenchNode> dd(WeightModulo(n, m));
+        benchmark::DoNotOptimize(dd.root());
+        st.counters["nodes"] = static_cast<double>(dd.size());
+    }
+}
+
+static void BM_PipelinedConstruct(benchmark::State& st) {
+    auto const n = static_cast<int>(st.range(0));
+    auto const m = static_cast<int>(st.range(1));
+    for (auto _ : st) {
+        DdStructure<BenchNode> dd(WeightModulo(n, m), DdBuildMethod::Pipelined);
+        benchmark::DoNotOptimize(dd.root());
+        st.counters["nodes"] = static_cast<double>(dd.size());
+    }
+}
+
+BENCHMARK(BM_BreadthFirstConstruct)
+    ->Args({100, 1000})
+    ->Args({100, 20000})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PipelinedConstruct)
+    ->Args({100, 1000})
+    ->Args({100, 20000})
+    ->Unit(benchmark::kMillisecond);
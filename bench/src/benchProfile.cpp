@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddProfile.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/PathSpec.hpp>
+
+#include "BenchNode.hpp"
+
+/**
+ * Build and reduce with no active profile, the cost of the instrumentation
+ * when it is unused.
+ */
+static void BM_Unprofiled(benchmark::State& st) {
+    auto const g = Graph::grid(static_cast<int>(st.range(0)),
+                               static_cast<int>(st.range(0)));
+    SimplePathSpec const spec(g, 0, g.numVertices() - 1);
+    for (auto _ : st) {
+        DdStructure<BenchNode> dd(spec);
+        dd.reduceZdd();
+        benchmark::DoNotOptimize(dd.size());
+    }
+}
+
+/**
+ * Build and reduce with an active profile, which reads the counters at the
+ * start and end of every level of every phase.
+ */
+static void BM_Profiled(benchmark::State& st) {
+    auto const g = Graph::grid(static_cast<int>(st.range(0)),
+                               static_cast<int>(st.range(0)));
+    SimplePathSpec const spec(g, 0, g.numVertices() - 1);
+    DdProfile            profile;
+    for (auto _ : st) {
+        DdProfile::Activation const on(profile);
+        DdStructure<BenchNode>      dd(spec);
+        dd.reduceZdd();
+        benchmark::DoNotOptimize(dd.size());
+    }
+    auto const construct = profile.total(DdPhase::Construct);
+    auto const reduce = profile.total(DdPhase::Reduce);
+    auto const n = static_cast<double>(st.iterations());
+    st.counters["scopes"] =
+        static_cast<double>(construct.calls + reduce.calls) / n;
+    for (auto k = 0UL; k < PERF_EVENT_COUNT; ++k) {
+        if (profile.available(static_cast<PerfEvent>(k))) {
+            st.counters[PERF_EVENT_NAMES[k]] =
+                static_cast<double>(construct.value[k] + reduce.value[k]) / n;
+        }
+    }
+}
+
+BENCHMARK(BM_Unprofiled)->Arg(6)->Arg(8)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Profiled)->Arg(6)->Arg(8)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,26 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+
+#include "BenchNode.hpp"
+
+static void BM_BuildAgain(benchmark::State& st) {
+    auto const n = static_cast<int>(st.range(0));
+    DdStructure<BenchNode> dd(Combination(n, n / 4));
+    for (auto _ : st) {
+        DdStructure<PathCountNode> other(Combination(n, n / 4));
+        benchmark::DoNotOptimize(other.root());
+    }
+}
+
+static void BM_Rebind(benchmark::State& st) {
+    auto const n = static_cast<int>(st.range(0));
+    DdStructure<BenchNode> dd(Combination(n, n / 4));
+    for (auto _ : st) {
+        auto other = dd.rebind<PathCountNode>();
+        benchmark::DoNotOptimize(other.root());
+    }
+}
+
+BENCHMARK(BM_BuildAgain)->Arg(400)->Arg(1600)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Rebind)->Arg(400)->Arg(1600)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddStatistics.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/FrontierManager.hpp>
+#include <ModernDD/spec/PathSpec.hpp>
+#include <ModernDD/util/ThreadPool.hpp>
+#include <sstream>
+
+#include "BenchNode.hpp"
+
+static DdStructure<BenchNode> const& paths(int n) {
+    static DdStructure<BenchNode> dd;
+    static int                    built = 0;
+    if (built != n) {
+        auto const g = Graph::grid(n, n);
+        dd = DdStructure<BenchNode>(SimplePathSpec(g, 0, n * n - 1));
+        dd.reduceZdd();
+        built = n;
+    }
+    return dd;
+}
+
+static void BM_DumpDot(benchmark::State& st) {
+    auto const& dd = paths(static_cast<int>(st.range(0)));
+    for (auto _ : st) {
+        std::ostringstream os;
+        dd.getDiagram()->dumpDot(os);
+        benchmark::DoNotOptimize(os.str().size());
+    }
+    st.counters["nodes"] = static_cast<double>(dd.size());
+}
+
+static void BM_GraphWriter(benchmark::State& st) {
+    auto const& dd = paths(static_cast<int>(st.range(0)));
+    for (auto _ : st) {
+        std::ostringstream os;
+        DdGraphWriter(os).write(dd, DdGraphFormat::Dot);
+        benchmark::DoNotOptimize(os.str().size());
+    }
+}
+
+static void BM_Statistics(benchmark::State& st) {
+    auto const& dd = paths(static_cast<int>(st.range(0)));
+    ThreadPool  pool(static_cast<size_t>(st.range(1)));
+    DdStatisticsCollector<BenchNode> collector(st.range(1) > 1 ? &pool
+                                                               : nullptr);
+    for (auto _ : st) {
+        auto s = collector.collect(dd);
+        benchmark::DoNotOptimize(s.useful);
+    }
+}
+
+BENCHMARK(BM_DumpDot)->Arg(9)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GraphWriter)->Arg(9)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Statistics)
+    ->Args({9, 1})
+    ->Args({9, 4})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <ModernDD/NodeBddFile.hpp>
+#include <ModernDD/NodeBddStreamSubsetter.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <cstdio>
+#include <string>
+
+#include "BenchNode.hpp"
+
+/**
+ * Wide spec: subsets whose weight sum is divisible by m, up to m states per
+ * level.
+ */
+class WeightModulo : public DdSpec<WeightModulo, int, 2> {
+    int const n;
+    int const m;
+
+   public:
+    WeightModulo(int _n, int _m) : n(_n), m(_m) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state = (state + value * (level * 7919 % m)) % m;
+        if (--level == 0) {
+            return (state == 0) ? -1 : 0;
+        }
+        return level;
+    }
+};
+
+/**
+ * Sets of at most k items.
+ */
+class AtMost : public DdSpec<AtMost, int, 2> {
+    int const n;
+    int const k;
+
+   public:
+    AtMost(int _n, int _k) : n(_n), k(_k) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state += value;
+        if (state > k) {
+            return 0;
+        }
+        return (--level == 0) ? -1 : level;
+    }
+};
+
+static void BM_InMemorySubset(benchmark::State& st) {
+    auto const n = static_cast<int>(st.range(0));
+    DdStructure<BenchNode> const input(WeightModulo(n, 500));
+    for (auto _ : st) {
+        auto dd = input;
+        dd.zddSubset(AtMost(n, n / 4));
+        benchmark::DoNotOptimize(dd.root());
+    }
+}
+
+static void BM_StreamSubset(benchmark::State& st) {
+    auto const  n = static_cast<int>(st.range(0));
+    std::string in = "bench_stream_subset_in.dd";
+    std::string out = "bench_stream_subset_out.dd";
+    saveDd(DdStructure<BenchNode>(WeightModulo(n, 500)), in);
+    {
+        DdFile const file(in);
+        for (auto _ : st) {
+            zddSubsetFile(file, AtMost(n, n / 4), out);
+        }
+    }
+    std::remove(in.c_str());
+    std::remove(out.c_str());
+}
+
+BENCHMARK(BM_InMemorySubset)->Arg(60)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StreamSubset)->Arg(60)->Unit(benchmark::kMillisecond);
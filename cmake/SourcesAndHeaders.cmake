@@ -9,11 +9,26 @@ set(exe_sources
 
 set(headers
     include/ModernDD/NodeBase.hpp  
+    include/ModernDD/NodeBddBatchBuilder.hpp
     include/ModernDD/NodeBddBuilder.hpp
+    include/ModernDD/NodeBddBulkLoader.hpp
+    include/ModernDD/NodeBddChain.hpp
+    include/ModernDD/NodeBddDfsBuilder.hpp
     include/ModernDD/NodeBddDumper.hpp
+    include/ModernDD/NodeBddEdgeValued.hpp
     include/ModernDD/NodeBddEval.hpp
+    include/ModernDD/NodeBddFile.hpp
+    include/ModernDD/NodeBddFingerprintBuilder.hpp
+    include/ModernDD/NodeBddFixer.hpp
+    include/ModernDD/NodeBddFrozen.hpp
+    include/ModernDD/NodeBddGeneratingFunction.hpp
+    include/ModernDD/NodeBddPartitionedBuilder.hpp
+    include/ModernDD/NodeBddProfile.hpp
+    include/ModernDD/NodeBddQuery.hpp
     include/ModernDD/NodeBddReducer.hpp
     include/ModernDD/NodeBddSpec.hpp
+    include/ModernDD/NodeBddStatistics.hpp
+    include/ModernDD/NodeBddStreamSubsetter.hpp
     include/ModernDD/NodeBddStructure.hpp
     include/ModernDD/NodeBddSweeper.hpp
     include/ModernDD/NodeBddTable.hpp
@@ -28,4 +43,52 @@ set(test_sources
   src/test.cpp
   src/testRandomDd.cpp
   src/testSizeConstraint.cpp
+  src/testDfsBuilder.cpp
+  src/testPipelinedBuilder.cpp
+  src/testBatchBuilder.cpp
+  src/testRebuildBelow.cpp
+  src/testFix.cpp
+  src/testJournal.cpp
+  src/testCanonicalize.cpp
+  src/testFrontierSpecs.cpp
+  src/testEdgeOrder.cpp
+  src/testRebind.cpp
+  src/testStatistics.cpp
+  src/testFrozen.cpp
+  src/testBatchQuery.cpp
+  src/testChain.cpp
+  src/testEdgeValued.cpp
+  src/testHashPolicy.cpp
+  src/testProfile.cpp
+  src/testPartitionedBuilder.cpp
+  src/testStreamSubset.cpp
+  src/testFingerprintBuilder.cpp
+  src/testBoundedEval.cpp
+  src/testExecutor.cpp
+  src/testBulkLoader.cpp
+  src/testGeneratingFunction.cpp
+)
+
+set(bench_sources
+  src/benchDfsBuilder.cpp
+  src/benchPipelinedBuilder.cpp
+  src/benchBatchBuilder.cpp
+  src/benchJournal.cpp
+  src/benchFrontierSpecs.cpp
+  src/benchEdgeOrder.cpp
+  src/benchRebind.cpp
+  src/benchStatistics.cpp
+  src/benchFrozen.cpp
+  src/benchBatchQuery.cpp
+  src/benchChain.cpp
+  src/benchEdgeValued.cpp
+  src/benchHashPolicy.cpp
+  src/benchProfile.cpp
+  src/benchPartitionedBuilder.cpp
+  src/benchStreamSubset.cpp
+  src/benchFingerprintBuilder.cpp
+  src/benchBoundedEval.cpp
+  src/benchExecutor.cpp
+  src/benchBulkLoader.cpp
+  src/benchGeneratingFunction.cpp
 )
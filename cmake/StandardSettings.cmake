@@ -12,6 +12,13 @@ option(${PROJECT_NAME}_USE_ALT_NAMES "Use alternative names for the project, suc
 
 option(${PROJECT_NAME}_WARNINGS_AS_ERRORS "Treat compiler warnings as errors." OFF)
 
+#
+# Hashing
+#
+# Currently supporting: MultiplicativeHash (default), Mix64Hash.
+
+set(${PROJECT_NAME}_HASH_POLICY "" CACHE STRING "Hash policy for nodes and spec states (see util/HashPolicy.hpp); empty selects the default.")
+
 #
 # Package managers
 #
@@ -32,6 +39,13 @@ option(${PROJECT_NAME}_USE_GOOGLE_MOCK "Use the GoogleMock project for extending
 
 option(${PROJECT_NAME}_USE_CATCH2 "Use the Catch2 project for creating unit tests." OFF)
 
+#
+# Benchmarks
+#
+# Currently supporting: Google Benchmark.
+
+option(${PROJECT_NAME}_ENABLE_BENCHMARKS "Enable benchmarks for the project (from the `bench` subfolder)." OFF)
+
 #
 # Static analyzers
 #
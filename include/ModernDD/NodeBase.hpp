@@ -6,6 +6,7 @@
 #include <cstddef>                              // for size_t
 #include <ostream>                              // for operator<<, ostream
 #include "NodeId.hpp"                           // for NodeId, operator<<
+#include "util/HashPolicy.hpp"                  // for DdHash
 
 class NodeBase : public std::array<NodeId, 2> {
    public:
@@ -19,12 +20,24 @@ class NodeBase : public std::array<NodeId, 2> {
     NodeBase& operator=(NodeBase&& src) = default;
     ~NodeBase() = default;
 
-    [[nodiscard]] size_t hash() const {
+    [[nodiscard]] size_t hash() const { return hashWith<DdHash>(); }
+
+    /**
+     * Gets the hash code of this node under a hash policy.
+     * @tparam P the hash policy.
+     * @return the hash code.
+     */
+    template <typename P>
+    [[nodiscard]] size_t hashWith() const {
         size_t h = 0;
         for (auto const& it : *this) {
-            boost::hash_combine(h, it.code());
+            if constexpr (P::historical) {
+                boost::hash_combine(h, it.code());
+            } else {
+                h = P::combine(h, it.code());
+            }
         }
-        return h;
+        return P::finish(h);
     }
 
     // bool operator==(NodeBase const& o) const { return *this == o; }
@@ -0,0 +1,85 @@
+#ifndef NODE_BDD_BATCH_BUILDER_HPP
+#define NODE_BDD_BATCH_BUILDER_HPP
+
+#include <chrono>                // for steady_clock, duration
+#include <cstddef>               // for size_t
+#include <utility>               // for move
+#include <vector>                // for vector
+#include "NodeBddStructure.hpp"  // for DdStructure, DdBuildMethod
+#include "util/Executor.hpp"     // for Executor, forChunks, maxChunks
+#include "util/MyList.hpp"       // for MyListBlockReuse
+
+/**
+ * Result of one build in a batch.
+ */
+template <typename T>
+struct DdBuildResult {
+    DdStructure<T> dd;         ///< The diagram.
+    double         seconds{};  ///< Wall-clock construction time.
+};
+
+/**
+ * Builds many independent diagrams on a shared executor.
+ * Each diagram is built serially by one worker. The specs are split into
+ * up to four chunks per worker, and within a chunk the spec node storage
+ * released by a build is reused by the next one (see MyListBlockReuse) and
+ * freed at the end of the chunk.
+ * @tparam T the node type.
+ */
+template <typename T>
+class DdBatchBuilder {
+    Executor&     executor;
+    DdBuildMethod method;
+    bool          reduce;
+
+   public:
+    /**
+     * Constructor.
+     * @param _executor the executor, e.g. a ThreadPool.
+     * @param _method construction engine of every build.
+     * @param _reduce apply reduceZdd after a breadth-first build.
+     */
+    explicit DdBatchBuilder(Executor&     _executor,
+                            DdBuildMethod _method = DdBuildMethod::BreadthFirst,
+                            bool          _reduce = false)
+        : executor(_executor),
+          method(_method),
+          reduce(_reduce) {}
+
+    /**
+     * Builds a diagram for every spec.
+     * @param specs DD specs.
+     * @return the diagrams and their timings in the order of @p specs.
+     */
+    template <typename SPEC>
+    std::vector<DdBuildResult<T>> build(std::vector<SPEC> const& specs) const {
+        std::vector<DdBuildResult<T>> results(specs.size());
+
+        forChunks(&executor, specs.size(), 1, maxChunks(&executor),
+                  [&](size_t begin, size_t end, size_t) {
+                      MyListBlockReuse const reuse;
+                      for (auto i = begin; i < end; ++i) {
+                          results[i] = buildOne(specs[i]);
+                      }
+                  });
+
+        return results;
+    }
+
+   private:
+    template <typename SPEC>
+    DdBuildResult<T> buildOne(SPEC const& spec) const {
+        auto const     start = std::chrono::steady_clock::now();
+        DdStructure<T> dd(spec, method);
+        if (reduce && (method == DdBuildMethod::BreadthFirst ||
+                       method == DdBuildMethod::Pipelined ||
+                       method == DdBuildMethod::Fingerprinted)) {
+            dd.reduceZdd();
+        }
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        return {std::move(dd), elapsed.count()};
+    }
+};
+
+#endif  // NODE_BDD_BATCH_BUILDER_HPP
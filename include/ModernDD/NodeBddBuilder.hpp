@@ -25,24 +25,32 @@
 #ifndef NODE_BDD_BUILDER_HPP
 #define NODE_BDD_BUILDER_HPP
 
+#include <algorithm>            // for min
 #include <cassert>              // for assert
 #include <cstddef>              // for size_t
 #include <cstdint>              // for int64_t
 #include <ext/alloc_traits.h>   // for __alloc_traits<>::value_type
 #include <memory>               // for allocator_traits<>::value_type
+#include <stdexcept>            // for runtime_error
+#include <thread>               // for thread, yield
 #include <unordered_set>        // for unordered_set
+#include <utility>              // for pair
 #include <vector>               // for vector
+#include "NodeBddProfile.hpp"   // for DdProfile, DdPhase
 #include "NodeBddSweeper.hpp"   // for DdSweeper
 #include "NodeBddTable.hpp"     // for NodeTableEntity, TableHandler
 #include "NodeBranchId.hpp"     // for NodeBranchId
 #include "NodeId.hpp"           // for NodeId
 #include "util/DataTable.hpp"   // for DataTable
+#include "util/Executor.hpp"    // for Executor, forChunks, maxChunks
 #include "util/MemoryPool.hpp"  // for MemoryPools
 #include "util/MyList.hpp"      // for MyList, MyListOnPool, MyListOnPool<>:...
+#include "util/SpscQueue.hpp"   // for SpscQueue
 
 class BuilderBase {
    protected:
     static size_t const headerSize = 1;
+    static size_t const parallelGrain = 1024;  ///< Least nodes per chunk.
 
     /* SpecNode
      * ┌────────┬────────┬────────┬─────
@@ -91,6 +99,135 @@ class BuilderBase {
             return spec.equal_to(state(p), state(q), static_cast<int>(level));
         }
     };
+
+    /**
+     * Merges a state reaching the 1-terminal into the 1-terminal state.
+     * @param spec the spec.
+     * @param one the 1-terminal state, made from @p s if @p first.
+     * @param first whether @p s is the first state reaching the 1-terminal.
+     * @param s the state.
+     * @return 0 if merge_states drops @p s, 1 if @p s joins the 1-terminal
+     * state and 2 if it becomes the 1-terminal state, in which case the
+     * earlier edges to the 1-terminal must go to the 0-terminal.
+     */
+    template <typename SPEC>
+    static int mergeOneState(SPEC& spec, void* one, bool first, void* s) {
+        if (first) {
+            spec.get_copy(one, s);
+            return 2;
+        }
+        switch (spec.merge_states(one, s)) {
+            case 1:
+                spec.destruct(one);
+                spec.get_copy(one, s);
+                return 2;
+            case 2:
+                return 0;
+            default:
+                return 1;
+        }
+    }
+
+    /**
+     * Merges a state reaching the 1-terminal into the 1-terminal state,
+     * recording the new edge to the 1-terminal.
+     * @param spec the spec.
+     * @param one the 1-terminal state.
+     * @param oneSrcPtr the edges to the 1-terminal, empty before the first.
+     * @param output the diagram holding the edges.
+     * @param s the state.
+     * @param i the level of the parent.
+     * @param jj the column of the parent.
+     * @param b the branch.
+     * @return the 1-terminal, or the 0-terminal if merge_states drops it.
+     */
+    template <typename SPEC, typename T>
+    static NodeId mergeIntoOne(SPEC&                      spec,
+                               void*                      one,
+                               std::vector<NodeBranchId>& oneSrcPtr,
+                               NodeTableEntity<T>&        output,
+                               void*                      s,
+                               size_t                     i,
+                               size_t                     jj,
+                               size_t                     b) {
+        switch (mergeOneState(spec, one, oneSrcPtr.empty(), s)) {
+            case 0:
+                return 0;
+            case 2:
+                while (!oneSrcPtr.empty()) {  // forward to 0-terminal
+                    NodeBranchId const& nbi = oneSrcPtr.back();
+                    assert(nbi.row >= i);
+                    output[nbi.row][nbi.col][nbi.val] = 0;
+                    oneSrcPtr.pop_back();
+                }
+                break;
+            default:
+                break;
+        }
+        oneSrcPtr.emplace_back(i, jj, b);
+        return 1;
+    }
+
+    /**
+     * Inserts a scheduled node into the unique table of its level, merging
+     * its state with an equal one.
+     * @param spec the spec.
+     * @param uniq the unique table of the level.
+     * @param p the scheduled node, whose state is canonical.
+     * @param p0 receives the node of the equal state, if any.
+     * @return -1 if the state is new, or else what merge_states(p0, p)
+     * returns; on 1, @p p takes the place of @p p0 in @p uniq.
+     */
+    template <typename SPEC, typename UNIQ>
+    static int insertState(SPEC& spec, UNIQ& uniq, SpecNode* p,
+                           SpecNode*& p0) {
+        auto aux = uniq.insert(p);
+        if (aux.second) {
+            return -1;
+        }
+
+        p0 = *aux.first;
+        int const r = spec.merge_states(state(p0), state(p));
+        if (r == 1) {
+            uniq.erase(aux.first);
+            uniq.insert(p);
+        }
+        return r;
+    }
+
+    /**
+     * Schedules the child state made in @p pp, the front node of level
+     * i - 1. The node stays there if the child is at that level, and a new
+     * front node is allocated; otherwise the state is moved to its level.
+     * @param spec the spec.
+     * @param table the scheduled nodes of every level.
+     * @param specNodeSize the size of a scheduled node.
+     * @param pp the front node of level i - 1, updated.
+     * @param i the level of the parent.
+     * @param ii the level of the child, from 1 to i - 1.
+     * @param dest receives the node ID of the child.
+     * @return the scheduled node.
+     */
+    template <typename SPEC>
+    static SpecNode* scheduleChild(SPEC&                          spec,
+                                   std::vector<MyList<SpecNode>>& table,
+                                   size_t                         specNodeSize,
+                                   SpecNode*&                     pp,
+                                   size_t                         i,
+                                   size_t                         ii,
+                                   NodeId*                        dest) {
+        SpecNode* p = pp;
+        if (ii + 1 == i) {
+            pp = table[ii].alloc_front(specNodeSize);
+        } else {
+            assert(ii + 1 < i);
+            p = table[ii].alloc_front(specNodeSize);
+            spec.get_copy(state(p), state(pp));
+            spec.destruct(state(pp));
+        }
+        srcPtr(p) = dest;
+        return p;
+    }
 };
 
 /**
@@ -105,6 +242,7 @@ class DdBuilder : BuilderBase {
     Spec                spec;
     size_t const        specNodeSize;
     NodeTableEntity<T>& output;
+    Executor*           executor;
     DdSweeper<T>        sweeper;
 
     std::vector<MyList<SpecNode>> spec_node_table;
@@ -113,20 +251,38 @@ class DdBuilder : BuilderBase {
     void* const               one;
     std::vector<NodeBranchId> oneSrcPtr;
 
+    size_t prefetchedLevel{};
+    size_t prefetchedSize{};
+
     void init(size_t n) {
         spec_node_table.resize(n + 1);
         if (n >= output.numRows()) {
             output.setNumRows(n + 1);
         }
         oneSrcPtr.clear();
+        prefetchedLevel = 0;
     }
 
    public:
-    DdBuilder(Spec const& _spec, TableHandler<T>& _output, size_t n = 0UL)
+    /**
+     * Constructor.
+     * @param _spec DD spec.
+     * @param _output the table receiving the diagram.
+     * @param n the number of levels to prepare, or 0 to wait for initialize.
+     * @param _executor computes the child states of wide levels in parallel
+     * in construct; nullptr builds on the calling thread. The spec must then
+     * allow get_copy, get_child and destruct on distinct states
+     * concurrently.
+     */
+    DdBuilder(Spec const&      _spec,
+              TableHandler<T>& _output,
+              size_t           n = 0UL,
+              Executor*        _executor = nullptr)
         : spec(_spec),
           specNodeSize(getSpecNodeSize(_spec.datasize())),
           output(*_output),
-          sweeper(this->output, oneSrcPtr),
+          executor(_executor),
+          sweeper(this->output, oneSrcPtr, _executor),
           oneStorage(_spec.datasize()),
           one(oneStorage.data()) {
         if (n >= 1) {
@@ -184,77 +340,345 @@ class DdBuilder : BuilderBase {
         return n;
     }
 
+    /**
+     * Initializes the builder for rebuilding the levels at or below @p k of
+     * an existing diagram.
+     * The spec is replayed over the rows above @p k to recover the state of
+     * every kept node, and the edges that leave those rows are scheduled
+     * again. Rows at or below @p k are cleared.
+     * An edge above @p k that leads to the 0-terminal where the spec yields
+     * a node, because the sweeper removed a dead subdiagram or because the
+     * spec admits more than before, is expanded again; its nodes share the
+     * kept nodes of equal state and are appended to the kept rows.
+     * @param root the root of the existing diagram, at a level above @p k.
+     * @param k the highest level to rebuild.
+     * @return the highest level to construct.
+     */
+    size_t initializeBelow(NodeId& root, size_t k) {
+        auto const n = root.row();
+        assert(0UL < k && k < n && n < output.numRows());
+
+        sweeper.setRoot(root);
+        std::vector<SpecNode>              tmp(specNodeSize);
+        SpecNode* const                    tp = tmp.data();
+        std::vector<std::vector<SpecNode>> states(n + 1);
+
+        auto const mismatch = [&]() {
+            return std::runtime_error(
+                "DdBuilder: the spec does not agree with the diagram above "
+                "the rebuilt levels");
+        };
+        auto const release = [&](size_t i) {
+            if (states[i].empty()) {
+                return;
+            }
+            for (auto j = 0UL; j * specNodeSize < states[i].size(); ++j) {
+                SpecNode* p = &states[i][j * specNodeSize];
+                if (code(p) != 0) {
+                    spec.destruct(state(p));
+                }
+            }
+            std::vector<SpecNode>().swap(states[i]);
+        };
+        auto const visit = [&](NodeId f) {
+            auto& row = states[f.row()];
+            if (row.empty()) {
+                row.resize(output[f.row()].size() * specNodeSize);
+            }
+            SpecNode* p = &row[f.col() * specNodeSize];
+            spec.canonicalize_state(state(tp), static_cast<int>(f.row()));
+            if (code(p) == 0) {
+                spec.get_copy(state(p), state(tp));
+                code(p) = 1;
+                return true;
+            }
+            return spec.equal_to(state(p), state(tp),
+                                 static_cast<int>(f.row()));
+        };
+
+        if (spec.get_root(state(tp)) != static_cast<int>(n)) {
+            spec.destruct(state(tp));
+            throw mismatch();
+        }
+        visit(root);
+        spec.destruct(state(tp));
+
+        init(n);
+        for (auto i = 1UL; i <= k; ++i) {
+            output.initRow(i, 0);
+        }
+
+        for (auto i = n; i > k; --i) {
+            auto const                kept = output[i].size();
+            std::pair<size_t, size_t> result{i - 1, 0};
+            if (!spec_node_table[i].empty()) {
+                result = reexpand(i, states[i]);
+            }
+            auto lowestChild = result.first;
+
+            for (auto j = 0UL; j < kept; ++j) {
+                SpecNode* p = states[i].empty()
+                                  ? nullptr
+                                  : &states[i][j * specNodeSize];
+
+                if (p == nullptr || code(p) == 0) {  // unreachable
+                    for (auto b = 0UL; b < AR; ++b) {
+                        NodeId& f = output[i][j][b];
+                        if (f.row() != 0 && f.row() <= k) {
+                            f = 0;
+                        }
+                    }
+                    continue;
+                }
+
+                for (auto b = 0UL; b < AR; ++b) {
+                    NodeId& f = output[i][j][b];
+                    spec.get_copy(state(tp), state(p));
+                    int  ii = spec.get_child(state(tp), static_cast<int>(i), b);
+                    bool ok = true;
+
+                    if (ii > static_cast<int>(k) && f == 0) {
+                        schedule(&f, ii, state(tp));
+                    } else if (ii > static_cast<int>(k)) {
+                        ok = f.row() == static_cast<size_t>(ii) && visit(f);
+                    } else if (f.row() > k) {
+                        ok = false;
+                    } else if (ii <= 0) {
+                        f = (ii == 0) ? NodeId(0) : NodeId(1);
+                    } else {
+                        schedule(&f, ii, state(tp));
+                    }
+                    spec.destruct(state(tp));
+
+                    if (!ok) {
+                        for (auto r = i; r > k; --r) {
+                            release(r);
+                        }
+                        throw mismatch();
+                    }
+                    if (ii > 0 && static_cast<size_t>(ii) < lowestChild) {
+                        lowestChild = static_cast<size_t>(ii);
+                    }
+                }
+            }
+
+            release(i);
+            sweeper.update(i, lowestChild, result.second);
+        }
+
+        return k;
+    }
+
     /**
      * Builds one level.
      * @param i level.
      */
     void construct(size_t i) {
         assert(0UL < i && i < spec_node_table.size());
+        DdProfile::Scope const profile(DdPhase::Construct, i);
+
+        auto m = deduplicate(i);
+        auto result = (executor != nullptr &&
+                       spec_node_table[i].size() >= 2 * parallelGrain)
+                          ? expandParallel(i, m)
+                          : expand(i, m, nullptr);
+        sweeper.update(i, result.first, result.second);
+    }
 
-        auto& spec_nodes = spec_node_table[i];
-        auto  j0 = output[i].size();
-        auto  m = j0;
-        auto  lowestChild = i - 1;
-        auto  deadCount = 0UL;
+    /**
+     * Builds one level while the level below is deduplicated concurrently.
+     * Children scheduled at level i - 1 are streamed to a consumer thread
+     * that assigns their node IDs, so that the next call starts expanding
+     * immediately. Levels must be processed from the top without gaps.
+     * The spec must allow canonicalize_state, hash_code, equal_to and
+     * merge_states on one state while get_copy, get_child and destruct run on
+     * another.
+     * @param i level.
+     */
+    void constructPipelined(size_t i) {
+        assert(0UL < i && i < spec_node_table.size());
+        DdProfile::Scope const profile(DdPhase::Construct, i);
 
-        {
-            Hasher<Spec> hasher(spec, i);
-            UniqTable    uniq(spec_nodes.size() * 2, hasher, hasher);
+        auto m = (prefetchedLevel == i) ? prefetchedSize : deduplicate(i);
+        prefetchedLevel = 0;
 
-            for (auto* p : spec_nodes) {
-                // SpecNode*& p0 = uniq.add(p);
-                auto aux = uniq.insert(p);
+        if (i == 1) {
+            auto result = expand(i, m, nullptr);
+            sweeper.update(i, result.first, result.second);
+            return;
+        }
 
-                if (aux.second) {
-                    nodeId(p) = *srcPtr(p) = NodeId(i, m++);
-                } else {
-                    auto p0 = *(aux.first);
-                    switch (spec.merge_states(state(p0), state(p))) {
-                        case 1:
-                            nodeId(p0) = 0;  // forward to 0-terminal
-                            nodeId(p) = *srcPtr(p) = NodeId(i, m++);
-                            p0 = p;
-                            break;
-                        case 2:
-                            *srcPtr(p) = NodeId(0);
-                            nodeId(p) = 1;  // unused
-                            break;
-                        default:
-                            *srcPtr(p) = nodeId(p0);
-                            nodeId(p) = 1;  // unused
-                            break;
+        std::vector<SpecNode*> pending;
+        pending.reserve(spec_node_table[i - 1].size());
+        for (auto* p : spec_node_table[i - 1]) {
+            pending.push_back(p);
+        }
+
+        SpscQueue<SpecNode*> queue;
+        auto                 mm = output[i - 1].size();
+        std::thread          consumer([&] {
+            Hasher<Spec> hasher(spec, i - 1);
+            UniqTable    uniq(pending.size() * 2 + 1, hasher, hasher);
+            SpecNode*    p = nullptr;
+
+            for (auto* q : pending) {
+                registerNode(uniq, q, i - 1, mm);
+            }
+            while (true) {
+                if (queue.pop(p)) {
+                    registerNode(uniq, p, i - 1, mm);
+                } else if (queue.closed()) {
+                    while (queue.pop(p)) {
+                        registerNode(uniq, p, i - 1, mm);
                     }
+                    break;
+                } else {
+                    std::this_thread::yield();
                 }
             }
-            //#ifdef DEBUG
-            //            MessageHandler mh;
-            //            mh << "table_size[" << i << "] = " << uniq.tableSize()
-            //            << "\n";
-            //#endif
+        });
+
+        std::pair<size_t, size_t> result;
+        try {
+            result = expand(i, m, &queue);
+        } catch (...) {
+            queue.close();
+            consumer.join();
+            throw;
         }
+        queue.close();
+        consumer.join();
+
+        prefetchedLevel = i - 1;
+        prefetchedSize = mm;
+        sweeper.update(i, result.first, result.second);
+    }
+
+   private:
+    /**
+     * Assigns a node ID to a scheduled node, sharing equivalent states.
+     * @param uniq unique table of the level.
+     * @param p the scheduled node.
+     * @param i level.
+     * @param m the number of nodes at the level, updated.
+     */
+    void registerNode(UniqTable& uniq, SpecNode* p, size_t i, size_t& m) {
+        spec.canonicalize_state(state(p), static_cast<int>(i));
+        SpecNode* p0 = p;
+
+        switch (insertState(spec, uniq, p, p0)) {
+            case -1:
+                nodeId(p) = *srcPtr(p) = NodeId(i, m++);
+                break;
+            case 1:
+                nodeId(p0) = 0;  // forward to 0-terminal
+                nodeId(p) = *srcPtr(p) = NodeId(i, m++);
+                break;
+            case 2:
+                *srcPtr(p) = NodeId(0);
+                nodeId(p) = 1;  // unused
+                break;
+            default:
+                *srcPtr(p) = nodeId(p0);
+                nodeId(p) = 1;  // unused
+                break;
+        }
+    }
+
+    /**
+     * Creates the nodes scheduled again at a kept level by initializeBelow.
+     * A scheduled state equal to that of a kept node shares it, unless
+     * merge_states drops the new state; the others are deduplicated and
+     * appended to the row.
+     * @param i level above the rebuilt ones.
+     * @param kept the recovered states of the kept nodes, or empty.
+     * @return the lowest child level and the number of dead nodes.
+     */
+    std::pair<size_t, size_t> reexpand(size_t i, std::vector<SpecNode>& kept) {
+        auto& spec_nodes = spec_node_table[i];
+        auto  m = output[i].size();
+
+        Hasher<Spec> hasher(spec, i);
+        UniqTable    keptNodes(kept.size() / specNodeSize * 2 + 1, hasher,
+                               hasher);
+        UniqTable    uniq(spec_nodes.size() * 2, hasher, hasher);
+
+        for (auto j = 0UL; j * specNodeSize < kept.size(); ++j) {
+            SpecNode* p = &kept[j * specNodeSize];
+            if (code(p) != 0) {
+                nodeId(p) = NodeId(i, j);
+                keptNodes.insert(p);
+            }
+        }
+        for (auto* p : spec_nodes) {
+            spec.canonicalize_state(state(p), static_cast<int>(i));
+            auto const it = keptNodes.find(p);
+            if (it == keptNodes.end()) {
+                registerNode(uniq, p, i, m);
+                continue;
+            }
+            bool const drop = spec.merge_states(state(*it), state(p)) == 2;
+            *srcPtr(p) = drop ? NodeId(0) : nodeId(*it);
+            nodeId(p) = 1;  // unused
+        }
+        return expand(i, m, nullptr);
+    }
+
+    /**
+     * Assigns node IDs to all scheduled nodes of one level.
+     * @param i level.
+     * @return the number of nodes at the level.
+     */
+    size_t deduplicate(size_t i) {
+        auto& spec_nodes = spec_node_table[i];
+        auto  m = output[i].size();
+
+        Hasher<Spec> hasher(spec, i);
+        UniqTable    uniq(spec_nodes.size() * 2, hasher, hasher);
+
+        for (auto* p : spec_nodes) {
+            registerNode(uniq, p, i, m);
+        }
+        return m;
+    }
+
+    /**
+     * Creates the nodes of one level and schedules their children.
+     * Node IDs must have been assigned by deduplicate or registerNode.
+     * @param i level.
+     * @param m the number of nodes at the level.
+     * @param queue receives the children scheduled at level i - 1 if given.
+     * @return the lowest child level and the number of dead nodes.
+     */
+    std::pair<size_t, size_t> expand(size_t                i,
+                                     size_t                m,
+                                     SpscQueue<SpecNode*>* queue) {
+        auto& spec_nodes = spec_node_table[i];
+        auto  lowestChild = i - 1;
+        auto  deadCount = 0UL;
 
         output[i].resize(m);
-        // T* const  output_data = output[i].data();
-        auto  jj = j0;
         auto* pp = spec_node_table[i - 1].alloc_front(specNodeSize);
 
         for (; !spec_nodes.empty(); spec_nodes.pop_front()) {
             SpecNode* p = spec_nodes.front();
-            T&        q = output[i][jj];
 
             if (nodeId(p) == 1) {
                 spec.destruct(state(p));
                 continue;
             }
 
-            bool allZero = true;
+            if (nodeId(p) == 0) {  // its row entry keeps null children
+                spec.destruct(state(p));
+                ++deadCount;
+                continue;
+            }
+
+            auto const jj = nodeId(p).col();
+            T&         q = output[i][jj];
+            bool       allZero = true;
 
             for (auto b = 0UL; b < AR; ++b) {
-                if (nodeId(p) == 0) {
-                    q[b] = 0;
-                    continue;
-                }
-
                 spec.get_copy(state(pp), state(p));
                 size_t ii = spec.get_child(state(pp), static_cast<int>(i), b);
 
@@ -262,55 +686,23 @@ class DdBuilder : BuilderBase {
                     q[b] = 0;
                     spec.destruct(state(pp));
                 } else if (ii + 1 == 0) {
-                    if (oneSrcPtr.empty()) {  // the first 1-terminal candidate
-                        spec.get_copy(one, state(pp));
-                        q[b] = 1;
-                        oneSrcPtr.emplace_back(i, jj, b);
-                    } else {
-                        switch (spec.merge_states(one, state(pp))) {
-                            case 1:
-                                while (!oneSrcPtr.empty()) {
-                                    NodeBranchId const& nbi = oneSrcPtr.back();
-                                    assert(nbi.row >= i);
-                                    output[nbi.row][nbi.col][nbi.val] = 0;
-                                    oneSrcPtr.pop_back();
-                                }
-                                spec.destruct(one);
-                                spec.get_copy(one, state(pp));
-                                q[b] = 1;
-                                oneSrcPtr.emplace_back(i, jj, b);
-                                break;
-                            case 2:
-                                q[b] = 0;
-                                break;
-                            default:
-                                q[b] = 1;
-                                oneSrcPtr.emplace_back(i, jj, b);
-                                break;
-                        }
-                    }
+                    q[b] = mergeIntoOne(spec, one, oneSrcPtr, output,
+                                        state(pp), i, jj, b);
                     spec.destruct(state(pp));
                     allZero = false;
-                } else if (ii + 1 == i) {
-                    srcPtr(pp) = &q[b];
-                    pp = spec_node_table[ii].alloc_front(specNodeSize);
-                    allZero = false;
                 } else {
-                    assert(ii + 1 < i);
-                    SpecNode* ppp =
-                        spec_node_table[ii].alloc_front(specNodeSize);
-                    spec.get_copy(state(ppp), state(pp));
-                    spec.destruct(state(pp));
-                    srcPtr(ppp) = &q[b];
-                    if (ii < lowestChild) {
-                        lowestChild = ii;
+                    SpecNode* c = scheduleChild(spec, spec_node_table,
+                                                specNodeSize, pp, i, ii, &q[b]);
+                    if (ii + 1 < i) {
+                        lowestChild = std::min(lowestChild, ii);
+                    } else if (queue != nullptr) {
+                        queue->push(c);
                     }
                     allZero = false;
                 }
             }
 
             spec.destruct(state(p));
-            ++jj;
             if (allZero) {
                 ++deadCount;
             }
@@ -318,7 +710,96 @@ class DdBuilder : BuilderBase {
 
         spec_node_table[i - 1].pop_front();
         // spec.destructLevel(i);
-        sweeper.update(i, lowestChild, deadCount);
+        return {lowestChild, deadCount};
+    }
+
+    /**
+     * Creates the nodes of one level like expand, computing the child states
+     * on the executor first. The children are then scheduled on the calling
+     * thread in the order of expand, so the diagram is the same.
+     * @param i level.
+     * @param m the number of nodes at the level.
+     * @return the lowest child level and the number of dead nodes.
+     */
+    std::pair<size_t, size_t> expandParallel(size_t i, size_t m) {
+        auto& spec_nodes = spec_node_table[i];
+        auto  lowestChild = i - 1;
+        auto  deadCount = 0UL;
+
+        output[i].resize(m);
+        std::vector<SpecNode*> nodes;
+        nodes.reserve(spec_nodes.size());
+        for (auto* p : spec_nodes) {
+            if (nodeId(p) == 0 || nodeId(p) == 1) {
+                deadCount += (nodeId(p) == 0) ? 1 : 0;
+                spec.destruct(state(p));
+            } else {
+                nodes.push_back(p);
+            }
+        }
+
+        // the child state of branch b of nodes[k] is children[k * AR + b];
+        // its code is the level returned by get_child
+        std::vector<SpecNode> children(nodes.size() * AR * specNodeSize);
+        auto const child = [&](size_t k, size_t b) {
+            return &children[(k * AR + b) * specNodeSize];
+        };
+
+        forChunks(executor, nodes.size(), parallelGrain, maxChunks(executor),
+                  [&](size_t begin, size_t end, size_t) {
+                      for (auto k = begin; k < end; ++k) {
+                          SpecNode* p = nodes[k];
+                          for (auto b = 0UL; b < AR; ++b) {
+                              SpecNode* c = child(k, b);
+                              spec.get_copy(state(c), state(p));
+                              code(c) = spec.get_child(
+                                  state(c), static_cast<int>(i), b);
+                              if (code(c) == 0) {
+                                  spec.destruct(state(c));
+                              }
+                          }
+                          spec.destruct(state(p));
+                      }
+                  });
+
+        for (auto k = 0UL; k < nodes.size(); ++k) {
+            auto const jj = nodeId(nodes[k]).col();
+            T&         q = output[i][jj];
+            bool       allZero = true;
+
+            for (auto b = 0UL; b < AR; ++b) {
+                SpecNode* c = child(k, b);
+                auto const ii = code(c);
+
+                if (ii == 0) {
+                    q[b] = 0;
+                    continue;
+                }
+                if (ii < 0) {
+                    q[b] = mergeIntoOne(spec, one, oneSrcPtr, output,
+                                        state(c), i, jj, b);
+                } else {
+                    assert(static_cast<size_t>(ii) < i);
+                    SpecNode* pp =
+                        spec_node_table[ii].alloc_front(specNodeSize);
+                    spec.get_copy(state(pp), state(c));
+                    srcPtr(pp) = &q[b];
+                    lowestChild =
+                        std::min(lowestChild, static_cast<size_t>(ii));
+                }
+                spec.destruct(state(c));
+                allZero = false;
+            }
+
+            if (allZero) {
+                ++deadCount;
+            }
+        }
+
+        while (!spec_nodes.empty()) {
+            spec_nodes.pop_front();
+        }
+        return {lowestChild, deadCount};
     }
 };
 
@@ -326,6 +807,117 @@ class DdBuilder : BuilderBase {
  * Multi-threaded breadth-first DD builder.
  */
 
+/**
+ * Walks down a ZDD and a ZDD spec together, following the 0-branches of
+ * the one that skips a level of the other, until both reach the same level
+ * or a terminal. Shared by the subset builders.
+ * @tparam Spec the spec.
+ * @tparam Input the input diagram, NodeTableEntity or DdFile.
+ */
+template <typename Spec, typename Input>
+class ZddSubsetWalk {
+    Spec&        spec;
+    Input const& input;
+
+   public:
+    ZddSubsetWalk(Spec& _spec, Input const& _input)
+        : spec(_spec),
+          input(_input) {}
+
+    /**
+     * Finds the root of the subset.
+     * @param s the root state, made by get_root.
+     * @param f the root of the input; receives the input node of the root,
+     * or the terminal if the subset is one.
+     * @return the level of the root, or 0 for a terminal.
+     */
+    int root(void* s, NodeId& f) {
+        int n = spec.get_root(s);
+        int k = (f == 1) ? -1 : static_cast<int>(f.row());
+
+        while (n != 0 && k != 0 && n != k) {
+            if (n < k) {
+                assert(k >= 1);
+                k = downTable(f, 0, n);
+            } else {
+                assert(n >= 1);
+                n = downSpec(s, n, 0, k);
+            }
+        }
+
+        if (n <= 0 || k <= 0) {
+            assert(n == 0 || k == 0 || (n == -1 && k == -1));
+            f = NodeId(0, static_cast<size_t>(n != 0 && k != 0));
+            return 0;
+        }
+        assert(n == k && static_cast<size_t>(n) == f.row());
+        return n;
+    }
+
+    /**
+     * Finds the child of a node of the subset.
+     * @param s receives the child state, destroyed if the child is the
+     * 0-terminal.
+     * @param p the state of the node.
+     * @param i the level of the node.
+     * @param j the input node.
+     * @param b the branch.
+     * @param f receives the input node of the child.
+     * @return the level of the child, 0 or -1 for a terminal.
+     */
+    int child(void* s, void const* p, size_t i, size_t j, int b, NodeId& f) {
+        f = NodeId(i, j);
+        spec.get_copy(s, p);
+        auto kk = downTable(f, b, static_cast<int>(i) - 1);
+        auto ii = downSpec(s, static_cast<int>(i), b, kk);
+
+        while (ii != 0 && kk != 0 && ii != kk) {
+            if (ii < kk) {
+                assert(kk >= 1);
+                kk = downTable(f, 0, ii);
+            } else {
+                assert(ii >= 1);
+                ii = downSpec(s, ii, 0, kk);
+            }
+        }
+
+        if (ii == 0 || kk == 0) {
+            spec.destruct(s);
+            return 0;
+        }
+        if (ii < 0 || kk < 0) {
+            return -1;
+        }
+        assert(ii == kk && static_cast<size_t>(ii) == f.row() &&
+               static_cast<size_t>(ii) < i);
+        return ii;
+    }
+
+   private:
+    int downTable(NodeId& f, int b, int zerosupLevel) const {
+        auto const level = static_cast<size_t>(std::max(zerosupLevel, 0));
+
+        f = input.child(f, b);
+        while (f.row() > level) {
+            f = input.child(f, 0);
+        }
+        return (f == 1) ? -1 : static_cast<int>(f.row());
+    }
+
+    int downSpec(void* p, int level, int b, int zerosupLevel) {
+        if (zerosupLevel < 0) {
+            zerosupLevel = 0;
+        }
+        assert(level > zerosupLevel);
+
+        auto i = spec.get_child(p, level, b);
+        while (i > zerosupLevel) {
+            i = spec.get_child(p, i, 0);
+        }
+        return i;
+    }
+};
+
 /**
  * Breadth-first ZDD subset builder.
  */
@@ -341,6 +933,7 @@ class ZddSubsetter : BuilderBase {
     int const                         specNodeSize;
     NodeTableEntity<T> const&         input;
     NodeTableEntity<T>&               output;
+    Executor*                         executor;
     DataTable<MyListOnPool<SpecNode>> work;
     DdSweeper<T>                      sweeper;
 
@@ -351,15 +944,26 @@ class ZddSubsetter : BuilderBase {
     MemoryPools pools;
 
    public:
+    /**
+     * Constructor.
+     * @param _input the diagram to subset.
+     * @param s ZDD spec.
+     * @param _output the table receiving the result.
+     * @param _executor computes the child states of wide levels in parallel;
+     * nullptr subsets on the calling thread. The spec must then allow
+     * get_copy, get_child and destruct on distinct states concurrently.
+     */
     ZddSubsetter(TableHandler<T> const& _input,
                  Spec const&            s,
-                 TableHandler<T>&       _output)
+                 TableHandler<T>&       _output,
+                 Executor*              _executor = nullptr)
         : spec(s),
           specNodeSize(getSpecNodeSize(spec.datasize())),
           input(*_input),
           output(*_output),
+          executor(_executor),
           work(_input->numRows()),
-          sweeper(this->output, oneSrcPtr),
+          sweeper(this->output, oneSrcPtr, _executor),
           oneStorage(spec.datasize()),
           one(oneStorage.data()) {}
 
@@ -383,28 +987,9 @@ class ZddSubsetter : BuilderBase {
         sweeper.setRoot(root);
         std::vector<char> tmp(spec.datasize());
         void* const       tmpState = tmp.data();
-        int               n = spec.get_root(tmpState);
-
-        int k = (root == 1) ? -1 : static_cast<int>(root.row());
-
-        while (n != 0 && k != 0 && n != k) {
-            if (n < k) {
-                assert(k >= 1);
-                k = downTable(root, 0, n);
-            } else {
-                assert(n >= 1);
-                n = downSpec(tmpState, n, 0, k);
-            }
-        }
-
-        if (n <= 0 || k <= 0) {
-            assert(n == 0 || k == 0 || (n == -1 && k == -1));
-            root = NodeId(0, static_cast<size_t>(n != 0 && k != 0));
-            n = 0;
-        } else {
-            assert(n == k);
-            assert(n == root.row());
+        int const         n = walk().root(tmpState, root);
 
+        if (n > 0) {
             pools.resize(n + 1);
             work[n].resize(input[n].size());
 
@@ -452,28 +1037,25 @@ class ZddSubsetter : BuilderBase {
                 UniqTable uniq(n * 2, hasher, hasher);
 
                 for (auto* p : list) {
-                    auto aux = uniq.insert(p);
-                    // SpecNode*& p0 = uniq.add(p);
+                    spec.canonicalize_state(state(p), static_cast<int>(i));
+                    SpecNode* p0 = p;
 
-                    if (aux.second) {
-                        nodeId(p) = *srcPtr(p) = NodeId(i, mm++);
-                    } else {
-                        auto p0 = *(aux.first);
-                        switch (spec.merge_states(state(p0), state(p))) {
-                            case 1:
-                                nodeId(p0) = 0;  // forward to 0-terminal
-                                nodeId(p) = *srcPtr(p) = NodeId(i, mm++);
-                                p0 = p;
-                                break;
-                            case 2:
-                                *srcPtr(p) = 0;
-                                nodeId(p) = 1;  // unused
-                                break;
-                            default:
-                                *srcPtr(p) = nodeId(p0);
-                                nodeId(p) = 1;  // unused
-                                break;
-                        }
+                    switch (insertState(spec, uniq, p, p0)) {
+                        case -1:
+                            nodeId(p) = *srcPtr(p) = NodeId(i, mm++);
+                            break;
+                        case 1:
+                            nodeId(p0) = 0;  // forward to 0-terminal
+                            nodeId(p) = *srcPtr(p) = NodeId(i, mm++);
+                            break;
+                        case 2:
+                            *srcPtr(p) = 0;
+                            nodeId(p) = 1;  // unused
+                            break;
+                        default:
+                            *srcPtr(p) = nodeId(p0);
+                            nodeId(p) = 1;  // unused
+                            break;
                     }
                 }
             } else if (n == 1) {
@@ -483,6 +1065,13 @@ class ZddSubsetter : BuilderBase {
         }
 
         output.initRow(i, mm);
+        if (executor != nullptr && mm >= 2 * parallelGrain) {
+            auto const result = expandParallel(i, m);
+            work[i].clear();
+            pools[i].clear();
+            sweeper.update(i, result.first, result.second);
+            return;
+        }
         // T* const output_data = output[i].data();
         auto jj = 0UL;
 
@@ -499,65 +1088,24 @@ class ZddSubsetter : BuilderBase {
 
                 auto allZero = true;
 
-                for (auto b = 0; b < AR; ++b) {
+                for (auto b = 0UL; b < AR; ++b) {
                     if (nodeId(p) == 0) {
                         q[b] = 0;
                         continue;
                     }
 
-                    NodeId f(i, j);
-                    spec.get_copy(tmpState, state(p));
-                    auto kk = downTable(f, b, i - 1);
-                    auto ii = downSpec(tmpState, i, b, kk);
-
-                    while (ii != 0 && kk != 0 && ii != kk) {
-                        if (ii < kk) {
-                            assert(kk >= 1);
-                            kk = downTable(f, 0, ii);
-                        } else {
-                            assert(ii >= 1);
-                            ii = downSpec(tmpState, ii, 0, kk);
-                        }
-                    }
+                    NodeId     f;
+                    auto const ii =
+                        walk().child(tmpState, state(p), i, j, b, f);
 
-                    if (ii <= 0 || kk <= 0) {
-                        if (ii == 0 || kk == 0) {
-                            q[b] = 0;
-                        } else {
-                            if (oneSrcPtr.empty()) {  // the first 1-terminal
-                                                      // candidate
-                                spec.get_copy(one, tmpState);
-                                q[b] = 1;
-                                oneSrcPtr.emplace_back(i, jj, b);
-                            } else {
-                                switch (spec.merge_states(one, tmpState)) {
-                                    case 1:
-                                        while (!oneSrcPtr.empty()) {
-                                            NodeBranchId const& nbi =
-                                                oneSrcPtr.back();
-                                            assert(nbi.row >= i);
-                                            output[nbi.row][nbi.col][nbi.val] =
-                                                0;
-                                            oneSrcPtr.pop_back();
-                                        }
-                                        spec.destruct(one);
-                                        spec.get_copy(one, tmpState);
-                                        q[b] = 1;
-                                        oneSrcPtr.emplace_back(i, jj, b);
-                                        break;
-                                    case 2:
-                                        q[b] = 0;
-                                        break;
-                                    default:
-                                        q[b] = 1;
-                                        oneSrcPtr.emplace_back(i, jj, b);
-                                        break;
-                                }
-                            }
-                            allZero = false;
-                        }
+                    if (ii == 0) {
+                        q[b] = 0;
+                        continue;
+                    }
+                    if (ii < 0) {
+                        q[b] = mergeIntoOne(spec, one, oneSrcPtr, output,
+                                            tmpState, i, jj, b);
                     } else {
-                        assert(ii == f.row() && ii == kk && ii < i);
                         if (work[ii].empty()) {
                             work[ii].resize(input[ii].size());
                         }
@@ -565,13 +1113,11 @@ class ZddSubsetter : BuilderBase {
                             pools[ii], specNodeSize);
                         spec.get_copy(state(pp), tmpState);
                         srcPtr(pp) = &q[b];
-                        if (ii < lowestChild) {
-                            lowestChild = ii;
-                        }
-                        allZero = false;
+                        lowestChild =
+                            std::min(lowestChild, static_cast<size_t>(ii));
                     }
-
                     spec.destruct(tmpState);
+                    allZero = false;
                 }
 
                 spec.destruct(state(p));
@@ -589,29 +1135,98 @@ class ZddSubsetter : BuilderBase {
     }
 
    private:
-    int downTable(NodeId& f, int b, int zerosupLevel) const {
-        if (zerosupLevel < 0) {
-            zerosupLevel = 0;
-        }
+    /**
+     * Creates the nodes of one level like subset, finding the child states
+     * on the executor first. The children are then scheduled on the calling
+     * thread in the order of subset, so the diagram is the same.
+     * @param i level.
+     * @param m the number of input nodes at the level.
+     * @return the lowest child level and the number of dead nodes.
+     */
+    std::pair<size_t, size_t> expandParallel(size_t i, size_t m) {
+        auto lowestChild = i - 1;
+        auto deadCount = 0UL;
 
-        f = input.child(f, b);
-        while (f.row() > zerosupLevel) {
-            f = input.child(f, 0);
+        // the k-th kept state is output node k; j is its input node
+        std::vector<std::pair<SpecNode*, size_t>> nodes;
+        for (size_t j = 0; j < m; ++j) {
+            for (auto* p : work[i][j]) {
+                if (nodeId(p) == 1) {
+                    spec.destruct(state(p));
+                } else {
+                    nodes.emplace_back(p, j);
+                }
+            }
         }
-        return (f == 1) ? -1 : static_cast<int>(f.row());
-    }
 
-    int downSpec(void* p, int level, int b, int zerosupLevel) {
-        if (zerosupLevel < 0) {
-            zerosupLevel = 0;
-        }
-        assert(level > zerosupLevel);
+        // the child state of branch b of nodes[k] is children[k * AR + b];
+        // its code is its level, or -1 for the 1-terminal
+        std::vector<SpecNode> children(nodes.size() * AR * specNodeSize);
+        std::vector<NodeId>   targets(nodes.size() * AR);
+        auto const            child = [&](size_t k, size_t b) {
+            return &children[(k * AR + b) * specNodeSize];
+        };
+
+        forChunks(executor, nodes.size(), parallelGrain, maxChunks(executor),
+                  [&](size_t begin, size_t end, size_t) {
+                      for (auto k = begin; k < end; ++k) {
+                          auto [p, j] = nodes[k];
+                          for (auto b = 0UL; b < AR; ++b) {
+                              SpecNode* c = child(k, b);
+                              auto&     f = targets[k * AR + b];
+                              code(c) = (nodeId(p) == 0)
+                                            ? 0
+                                            : walk().child(state(c), state(p),
+                                                           i, j, b, f);
+                          }
+                          spec.destruct(state(p));
+                      }
+                  });
+
+        for (auto k = 0UL; k < nodes.size(); ++k) {
+            auto& q = output[i][k];
+            auto  allZero = true;
 
-        auto i = spec.get_child(p, level, b);
-        while (i > zerosupLevel) {
-            i = spec.get_child(p, i, 0);
+            for (auto b = 0UL; b < AR; ++b) {
+                SpecNode* c = child(k, b);
+                auto const ii = code(c);
+
+                if (ii == 0) {
+                    q[b] = 0;
+                    continue;
+                }
+                if (ii < 0) {
+                    q[b] = mergeIntoOne(spec, one, oneSrcPtr, output,
+                                        state(c), i, k, b);
+                } else {
+                    auto const& f = targets[k * AR + b];
+                    if (work[ii].empty()) {
+                        work[ii].resize(input[ii].size());
+                    }
+                    SpecNode* pp =
+                        work[ii][f.col()].alloc_front(pools[ii], specNodeSize);
+                    spec.get_copy(state(pp), state(c));
+                    srcPtr(pp) = &q[b];
+                    lowestChild =
+                        std::min(lowestChild, static_cast<size_t>(ii));
+                }
+                spec.destruct(state(c));
+                allZero = false;
+            }
+
+            if (allZero) {
+                ++deadCount;
+            }
         }
-        return i;
+
+        return {lowestChild, deadCount};
+    }
+
+    /**
+     * Gets the walk down the input and the spec.
+     */
+    ZddSubsetWalk<Spec, NodeTableEntity<T>> walk() {
+        return {spec, input};
     }
 };
 
@@ -0,0 +1,183 @@
+#ifndef NODE_BDD_BULK_LOADER_HPP
+#define NODE_BDD_BULK_LOADER_HPP
+
+#include <algorithm>             // for is_sorted, reverse, sort, unique, ...
+#include <cstddef>               // for size_t
+#include <functional>            // for greater
+#include <iterator>              // for begin, end, rbegin, rend
+#include <stdexcept>             // for runtime_error
+#include <utility>               // for move
+#include <vector>                // for vector
+#include "NodeBase.hpp"          // for NodeBase
+#include "NodeBddStructure.hpp"  // for DdStructure
+#include "NodeBddTable.hpp"      // for TableHandler
+#include "NodeId.hpp"            // for NodeId, NODE_ROW_MAX
+#include "util/MyHashTable.hpp"  // for MyHashMap
+
+/**
+ * Order in which ZddBulkLoader takes the sets.
+ * Sets are compared as the lists of their items in decreasing order,
+ * lexicographically, which is the order in which DdStructure enumerates a
+ * ZDD: {}, {1}, {2}, {1,2}, {3}, ... Equivalently, a set comes before
+ * another if the largest item in which they differ belongs to the other.
+ * The ranges compared list their items in increasing order, as std::set
+ * does.
+ */
+struct ZddLoadOrder {
+    template <typename R>
+    bool operator()(R const& a, R const& b) const {
+        return std::lexicographical_compare(std::rbegin(a), std::rend(a),
+                                            std::rbegin(b), std::rend(b));
+    }
+};
+
+/**
+ * Builds the reduced ZDD of an explicit family of sets in one pass.
+ * The sets are added in ZddLoadOrder, so that the sets sharing the largest
+ * items are consecutive. The loader keeps the path of the last set; when
+ * the next set leaves it, the subfamilies below the point of departure are
+ * complete and their nodes are made bottom-up through per-level unique
+ * tables. The memory held is that of the result plus one path, whatever
+ * the number of sets.
+ *
+ * The result is the diagram that reduceZdd would make, edge attributes
+ * included. Items are the levels 1..n.
+ * @tparam T the node type.
+ */
+template <typename T>
+class ZddBulkLoader {
+    /// A node on the path of the last set.
+    struct Frame {
+        int    item;  ///< Item taken to reach the frame.
+        NodeId f;     ///< ZDD of the completed part of its subfamily.
+    };
+
+    using UniqTable = MyHashMap<NodeBase, NodeId>;
+
+    size_t const           n;
+    TableHandler<T>        diagram;
+    std::vector<UniqTable> uniq;
+    std::vector<Frame>     path;
+    std::vector<int>       items;
+    size_t                 count_{};
+
+   public:
+    /**
+     * Constructor.
+     * @param _n the number of items.
+     * @exception std::runtime_error the items do not fit in the levels.
+     */
+    explicit ZddBulkLoader(size_t _n) : n(_n) {
+        if (n > NODE_ROW_MAX) {
+            throw std::runtime_error("ZddBulkLoader: too many items");
+        }
+        reset();
+    }
+
+    /**
+     * Adds a set.
+     * A set equal to the last one is ignored.
+     * @param set the items, in any order.
+     * @exception std::runtime_error an item is not in 1..n or the set comes
+     * before the last one in ZddLoadOrder.
+     */
+    template <typename R>
+    void add(R const& set) {
+        items.assign(std::begin(set), std::end(set));
+        if (std::is_sorted(items.begin(), items.end())) {
+            std::reverse(items.begin(), items.end());
+        } else {
+            std::sort(items.begin(), items.end(), std::greater<>());
+        }
+        items.erase(std::unique(items.begin(), items.end()), items.end());
+        if (!items.empty() &&
+            (items.back() < 1 || static_cast<size_t>(items.front()) > n)) {
+            throw std::runtime_error("ZddBulkLoader: item out of range");
+        }
+
+        auto p = 0UL;  // the length of the common prefix
+        while (p + 1 < path.size() && p < items.size() &&
+               path[p + 1].item == items[p]) {
+            ++p;
+        }
+        bool const longer = p < items.size();
+        bool const ended = p + 1 == path.size();
+        if (count_ > 0 && !(longer && (ended || items[p] > path[p + 1].item))) {
+            if (!longer && ended) {
+                return;
+            }
+            throw std::runtime_error("ZddBulkLoader: sets are not sorted");
+        }
+
+        close(p);
+        for (auto k = p; k < items.size(); ++k) {
+            path.push_back({items[k], NodeId(0)});
+        }
+        path.back().f = 1;
+        ++count_;
+    }
+
+    /**
+     * Gets the number of distinct sets added so far.
+     * @return the number of sets.
+     */
+    [[nodiscard]] size_t count() const { return count_; }
+
+    /**
+     * Completes the diagram and starts an empty family.
+     * @return the reduced ZDD of the sets added.
+     */
+    DdStructure<T> finish() {
+        close(0);
+        NodeId const root = path.front().f;
+        DdStructure<T> dd(std::move(diagram), root);
+        reset();
+        return dd;
+    }
+
+   private:
+    /**
+     * Starts an empty family.
+     */
+    void reset() {
+        diagram = TableHandler<T>(n + 1);
+        uniq.assign(n + 1, UniqTable());
+        path.assign(1, {0, NodeId(0)});
+        count_ = 0;
+    }
+
+    /**
+     * Completes the frames below a depth.
+     * The subfamily of a frame holds the sets of the frame above that take
+     * its item; they are all smaller than the sets of the later frames.
+     * @param depth the depth of the deepest frame kept.
+     */
+    void close(size_t depth) {
+        while (path.size() > depth + 1) {
+            Frame const top = path.back();
+            path.pop_back();
+            auto& parent = path.back();
+            parent.f = getNode(static_cast<size_t>(top.item), parent.f, top.f);
+        }
+    }
+
+    /**
+     * Gets the node of a level, creating it if it is new.
+     * @param i the level.
+     * @param f0 the 0-child.
+     * @param f1 the 1-child, not the 0-terminal.
+     * @return the node ID.
+     */
+    NodeId getNode(size_t i, NodeId f0, NodeId f1) {
+        NodeId& f = uniq[i][NodeBase(f0, f1)];
+        if (f == 0) {
+            auto& row = (*diagram)[i];
+            f = NodeId(i, row.size(), f0.hasEmpty());
+            row.emplace_back(f0, f1);
+            row.back().set_node_id_label(f);
+        }
+        return f;
+    }
+};
+
+#endif  // NODE_BDD_BULK_LOADER_HPP
@@ -0,0 +1,298 @@
+#ifndef NODE_BDD_CHAIN_HPP
+#define NODE_BDD_CHAIN_HPP
+
+#include <algorithm>             // for max
+#include <cstddef>               // for size_t
+#include <cstdint>               // for uint64_t
+#include <unordered_map>         // for unordered_map
+#include <utility>               // for pair
+#include <vector>                // for vector
+#include "NodeBase.hpp"          // for NodeBase
+#include "NodeBddStructure.hpp"  // for DdStructure
+#include "NodeId.hpp"            // for NodeId
+#include "util/HashPolicy.hpp"   // for DdHash
+
+/**
+ * Diagram in which every edge states how the levels it skips are read.
+ * An edge without attribute skips don't-care levels, as in a BDD; an edge
+ * with the attribute set skips levels that must be 0, as in a ZDD. Edges
+ * skipping no level and edges to the 0-terminal never carry the attribute.
+ *
+ * A node whose children are equal don't-care edges is removed by the BDD
+ * rule, and a node whose 1-child is the 0-terminal and whose 0-child is a
+ * must-be-0 or short edge by the ZDD rule. The removal is done edge by edge:
+ * an edge to such a node is redirected to the node's 0-child if it skips
+ * levels of the same kind or none, and the node is kept only if another
+ * edge skips levels of the other kind. Every kept node stands for a node of
+ * the BDD and for one of the ZDD of the function, so the diagram is never
+ * larger than either.
+ */
+class ChainDd {
+    std::vector<std::vector<NodeBase>> table;    ///< Nodes by level.
+    NodeId                             root_{};  ///< Edge from the top.
+    size_t                             vars{};
+
+    /**
+     * Code of an edge including its attribute.
+     */
+    static uint64_t raw(NodeId e) {
+        return e.code() | (e.getAttr() ? NODE_ATTR_MASK : 0);
+    }
+
+    static bool same(NodeId a, NodeId b) { return raw(a) == raw(b); }
+
+    /**
+     * Makes an edge from a level, dropping the attribute when it skips
+     * nothing or goes to the 0-terminal.
+     */
+    static NodeId edge(size_t from, NodeId target, bool zero) {
+        bool const skips = from > target.row() + 1;
+        target.setAttr(zero && skips && target != 0);
+        return target;
+    }
+
+    struct Reduced {
+        NodeId redirect{};          ///< Edge replacing the node, if any.
+        bool   canRedirect{false};  ///< The node is removable.
+        bool   isZero{false};       ///< The node is the 0-function.
+        NodeId e0{};                ///< Reduced 0-edge.
+        NodeId e1{};                ///< Reduced 1-edge.
+        NodeId node{};              ///< Kept node, if made.
+        bool   made{false};
+    };
+
+    struct PairHash {
+        size_t operator()(std::pair<uint64_t, uint64_t> const& p) const {
+            if constexpr (DdHash::historical) {
+                return p.first * 314159257 + p.second * 271828171;
+            } else {
+                return DdHash::finish(
+                    DdHash::combine(DdHash::combine(0, p.first), p.second));
+            }
+        }
+    };
+
+    using UniqueTable = std::unordered_map<std::pair<uint64_t, uint64_t>,
+                                           size_t,
+                                           PairHash>;
+
+    /**
+     * Gets the kept node of an input node, making it on first use.
+     */
+    NodeId keep(size_t i, Reduced& r, std::vector<UniqueTable>& uniq) {
+        if (!r.made) {
+            auto const key = std::make_pair(raw(r.e0), raw(r.e1));
+            auto [it, added] = uniq[i].try_emplace(key, table[i].size());
+            if (added) {
+                table[i].emplace_back(r.e0, r.e1);
+            }
+            r.node = NodeId(i, it->second);
+            r.made = true;
+        }
+        return r.node;
+    }
+
+    template <typename F>
+    void enumerateEdge(NodeId e, size_t from, std::vector<int>& items, F& f)
+        const {
+        if (e == 0) {
+            return;
+        }
+        if (!e.getAttr() && from > e.row() + 1) {
+            // branch on the highest don't-care level skipped by e
+            auto const l = from - 1;
+            enumerateEdge(e, l, items, f);
+            items.push_back(static_cast<int>(l));
+            enumerateEdge(e, l, items, f);
+            items.pop_back();
+            return;
+        }
+        if (e.row() == 0) {
+            f(static_cast<std::vector<int> const&>(items));
+            return;
+        }
+        auto const& n = table[e.row()][e.col()];
+        enumerateEdge(n[0], e.row(), items, f);
+        items.push_back(static_cast<int>(e.row()));
+        enumerateEdge(n[1], e.row(), items, f);
+        items.pop_back();
+    }
+
+   public:
+    ChainDd() = default;
+
+    /**
+     * Chain-reduces a diagram.
+     * @param dd the diagram.
+     * @param zdd read the levels skipped by @p dd as must-be-0 (ZDD) rather
+     * than don't-care (BDD).
+     * @param numVars the number of variables; at least the root level.
+     */
+    template <typename T>
+    ChainDd(DdStructure<T> const& dd, bool zdd, size_t numVars = 0)
+        : vars(std::max<size_t>(numVars, dd.root().row())) {
+        auto const& input = *dd.getDiagram();
+        auto const  rows = input.numRows();
+
+        table.resize(vars + 1);
+        std::vector<std::vector<Reduced>> reduced(rows);
+        std::vector<UniqueTable>          uniq(rows);
+
+        auto const edgeTo = [&](size_t from, NodeId c) {
+            if (c.row() == 0) {
+                return edge(from, c, zdd);
+            }
+            auto&      r = reduced[c.row()][c.col()];
+            bool const skips = from > c.row() + 1;
+            if (r.isZero) {
+                return NodeId(0);
+            }
+            if (r.canRedirect && (!skips || r.redirect.getAttr() == zdd)) {
+                return r.redirect;
+            }
+            return edge(from, keep(c.row(), r, uniq), zdd);
+        };
+
+        std::vector<std::vector<char>> reachable(rows);
+        for (auto i = 1UL; i < rows; ++i) {
+            reachable[i].resize(input[i].size());
+        }
+        if (dd.root().row() > 0) {
+            reachable[dd.root().row()][dd.root().col()] = 1;
+        }
+        for (auto i = dd.root().row(); i >= 1; --i) {
+            for (auto j = 0UL; j < input[i].size(); ++j) {
+                for (int b = 0; b < 2 && reachable[i][j]; ++b) {
+                    NodeId const c = input.child(i, j, b);
+                    if (c.row() > 0) {
+                        reachable[c.row()][c.col()] = 1;
+                    }
+                }
+            }
+        }
+
+        for (auto i = 1UL; i < rows; ++i) {
+            reduced[i].resize(input[i].size());
+            for (auto j = 0UL; j < input[i].size(); ++j) {
+                if (!reachable[i][j]) {
+                    continue;
+                }
+                auto& r = reduced[i][j];
+                r.e0 = edgeTo(i, input.child(i, j, 0));
+                r.e1 = edgeTo(i, input.child(i, j, 1));
+                if (r.e0 == 0 && r.e1 == 0) {
+                    r.isZero = true;
+                } else if (same(r.e0, r.e1) && !r.e0.getAttr()) {
+                    r.canRedirect = true;
+                    r.redirect = edge(i + 1, r.e0.withoutAttr(), false);
+                } else if (r.e1 == 0 &&
+                           (r.e0.getAttr() || r.e0.row() + 1 == i)) {
+                    r.canRedirect = true;
+                    r.redirect = edge(i + 1, r.e0.withoutAttr(), true);
+                }
+            }
+        }
+        root_ = edgeTo(vars + 1, dd.root());
+    }
+
+    /**
+     * Gets the edge to the root, seen from above the top level.
+     * @return the root edge.
+     */
+    [[nodiscard]] NodeId root() const { return root_; }
+
+    /**
+     * Gets the number of variables.
+     * @return the number of variables.
+     */
+    [[nodiscard]] size_t numVars() const { return vars; }
+
+    /**
+     * Gets a child edge.
+     * @param f node ID.
+     * @param b child branch.
+     * @return the @p b-edge of @p f.
+     */
+    [[nodiscard]] NodeId child(NodeId f, size_t b) const {
+        return table[f.row()][f.col()][b];
+    }
+
+    /**
+     * Tells whether the levels skipped by an edge must be 0.
+     * @param e the edge.
+     * @return true for a ZDD-style edge, false for a BDD-style one.
+     */
+    static bool zeroSuppressed(NodeId e) { return e.getAttr(); }
+
+    /**
+     * Gets the number of nodes of a level.
+     * @param i the level.
+     * @return the number of nodes.
+     */
+    [[nodiscard]] size_t levelSize(size_t i) const { return table[i].size(); }
+
+    /**
+     * Gets the number of non-terminal nodes.
+     * @return the number of nodes.
+     */
+    [[nodiscard]] size_t size() const {
+        size_t n = 0;
+        for (auto const& row : table) {
+            n += row.size();
+        }
+        return n;
+    }
+
+    /**
+     * Evaluates the diagram bottom-up.
+     * The levels skipped by an edge are evaluated as nodes whose children
+     * are both the lower value (don't-care) or the lower value and the
+     * 0-terminal (must-be-0), so that @p node sees every level once on
+     * every path.
+     * @param terminal function giving the value of terminal @p b.
+     * @param node function giving the value of a node at a level from the
+     * values of its 0- and 1-children.
+     * @return the value of the function.
+     */
+    template <typename R, typename TERMINAL, typename NODE>
+    R evaluate(TERMINAL&& terminal, NODE&& node) const {
+        std::vector<std::vector<R>> value(table.size());
+        R const                     zero = terminal(false);
+        R const                     one = terminal(true);
+
+        auto const along = [&](NodeId e, size_t from) {
+            if (e == 0) {
+                return zero;
+            }
+            R v = (e.row() == 0) ? one : value[e.row()][e.col()];
+            for (auto l = e.row() + 1; l < from; ++l) {
+                v = e.getAttr() ? node(static_cast<int>(l), v, zero)
+                                : node(static_cast<int>(l), v, v);
+            }
+            return v;
+        };
+
+        for (auto i = 1UL; i < table.size(); ++i) {
+            value[i].reserve(table[i].size());
+            for (auto const& n : table[i]) {
+                value[i].push_back(node(static_cast<int>(i), along(n[0], i),
+                                        along(n[1], i)));
+            }
+        }
+        return along(root_, vars + 1);
+    }
+
+    /**
+     * Calls a function on every set of the family, i.e. every assignment
+     * mapped to the 1-terminal, given as the levels of its 1-variables in
+     * decreasing order.
+     * @param f the function, called with a std::vector<int> const&.
+     */
+    template <typename F>
+    void forEachSet(F&& f) const {
+        std::vector<int> items;
+        enumerateEdge(root_, vars + 1, items, f);
+    }
+};
+
+#endif  // NODE_BDD_CHAIN_HPP
@@ -0,0 +1,211 @@
+#ifndef NODE_BDD_DFS_BUILDER_HPP
+#define NODE_BDD_DFS_BUILDER_HPP
+
+#include <array>                 // for array
+#include <cassert>               // for assert
+#include <cstddef>               // for size_t
+#include <unordered_set>         // for unordered_set
+#include <vector>                // for vector
+#include "NodeBase.hpp"          // for NodeBase
+#include "NodeBddBuilder.hpp"    // for BuilderBase
+#include "NodeBddTable.hpp"      // for NodeTableEntity, TableHandler
+#include "NodeId.hpp"            // for NodeId
+#include "util/MemoryPool.hpp"   // for MemoryPool
+#include "util/MyHashTable.hpp"  // for MyHashMap
+
+/**
+ * Depth-first DD builder with memoization.
+ * Every (level, state) pair reached by the search is registered in a
+ * per-level table that maps it to its node ID, and every finished node is
+ * registered in a per-level unique table, so the output is reduced without
+ * a separate DdReducer pass.
+ * The memo keeps every visited state, so the memory is proportional to the
+ * number of distinct (level, state) pairs of the result, as with
+ * DdBuilder; only the explicit stack of the search, at most one frame per
+ * level, comes on top of it.
+ * merge_states(void*, void*) is not supported.
+ * @tparam S the spec.
+ * @tparam T the node type.
+ * @tparam BDD enable BDD node deletion rule.
+ * @tparam ZDD enable ZDD node deletion rule.
+ */
+template <typename S, typename T, bool BDD = false, bool ZDD = true>
+class DdDfsBuilder : BuilderBase {
+    using Spec = S;
+    using MemoTable = std::unordered_set<SpecNode*, Hasher<Spec>, Hasher<Spec>>;
+    static size_t const AR = Spec::ARITY;
+    static_assert(AR == 2, "DdDfsBuilder supports binary specs only");
+
+    struct Frame {
+        SpecNode*              p;
+        int                    level;
+        size_t                 b{};
+        std::array<NodeId, AR> child{};
+
+        Frame(SpecNode* _p, int _level) : p(_p), level(_level) {}
+    };
+
+    Spec                                     spec;
+    size_t const                             specNodeSize;
+    NodeTableEntity<T>&                      output;
+    std::vector<MemoTable>                   memo;
+    std::vector<MyHashMap<NodeBase, size_t>> uniq;
+    MemoryPool                               pool;
+    std::vector<Frame>                       stack;
+    std::vector<SpecNode>                    tmpStorage;
+    SpecNode* const                          tmp;
+
+    void init(size_t n) {
+        output.init(static_cast<int>(n + 1));
+        memo.clear();
+        memo.reserve(n + 1);
+        for (auto i = 0UL; i <= n; ++i) {
+            Hasher<Spec> hasher(spec, i);
+            memo.emplace_back(1, hasher, hasher);
+        }
+        uniq.clear();
+        uniq.resize(n + 1);
+        pool.clear();
+    }
+
+   public:
+    DdDfsBuilder(Spec const& _spec, TableHandler<T>& _output)
+        : spec(_spec),
+          specNodeSize(getSpecNodeSize(_spec.datasize())),
+          output(*_output),
+          tmpStorage(specNodeSize),
+          tmp(tmpStorage.data()) {}
+
+    ~DdDfsBuilder() {
+        for (auto& table : memo) {
+            for (auto* p : table) {
+                spec.destruct(state(p));
+            }
+        }
+    }
+
+    DdDfsBuilder(const DdDfsBuilder<S, T, BDD, ZDD>&) = delete;
+    DdDfsBuilder<S, T, BDD, ZDD>& operator=(
+        const DdDfsBuilder<S, T, BDD, ZDD>&) = delete;
+    DdDfsBuilder(DdDfsBuilder<S, T, BDD, ZDD>&&) = delete;
+    DdDfsBuilder<S, T, BDD, ZDD>& operator=(DdDfsBuilder<S, T, BDD, ZDD>&&) =
+        delete;
+
+    /**
+     * Builds the whole diagram.
+     * @param root result storage.
+     * @return the level of the root state.
+     */
+    int build(NodeId& root) {
+        int n = spec.get_root(state(tmp));
+
+        if (n <= 0) {
+            spec.destruct(state(tmp));
+            output.init(1);
+            root = n ? NodeId(1) : NodeId(0);
+            return 0;
+        }
+
+        init(static_cast<size_t>(n));
+        if (!enter(n, root)) {
+            return n;
+        }
+
+        while (true) {
+            auto& fr = stack.back();
+
+            if (fr.b < AR) {
+                auto const b = fr.b++;
+                spec.get_copy(state(tmp), state(fr.p));
+                int ii = spec.get_child(state(tmp), fr.level, b);
+
+                if (ii <= 0) {
+                    spec.destruct(state(tmp));
+                    fr.child[b] = ii ? NodeId(1) : NodeId(0);
+                } else {
+                    NodeId f;
+                    if (!enter(ii, f)) {
+                        stack.back().child[b] = f;
+                    }
+                }
+                continue;
+            }
+
+            NodeId f = makeNode(fr);
+            nodeId(fr.p) = f;
+            stack.pop_back();
+
+            if (stack.empty()) {
+                root = f;
+                break;
+            }
+            auto& parent = stack.back();
+            parent.child[parent.b - 1] = f;
+        }
+
+        return n;
+    }
+
+   private:
+    /**
+     * Looks up the state in tmp at the given level.
+     * A new search frame is pushed if the state has not been seen yet.
+     * @param level level of the state.
+     * @param f result storage for a memoized state.
+     * @return true if a new frame was pushed.
+     */
+    bool enter(int level, NodeId& f) {
+        auto& table = memo[level];
+        spec.canonicalize_state(state(tmp), level);
+        auto it = table.find(tmp);
+
+        if (it != table.end()) {
+            spec.destruct(state(tmp));
+            f = nodeId(*it);
+            return false;
+        }
+
+        auto* p = pool.template allocate<SpecNode>(specNodeSize);
+        spec.get_copy(state(p), state(tmp));
+        spec.destruct(state(tmp));
+        table.insert(p);
+        stack.emplace_back(p, level);
+        return true;
+    }
+
+    /**
+     * Applies the node deletion rules and the node sharing rule.
+     * @param fr finished search frame.
+     * @return the node ID of the frame.
+     */
+    NodeId makeNode(Frame const& fr) {
+        auto const& c = fr.child;
+
+        if (c[0] == 0 && c[1] == 0) {
+            return 0;
+        }
+        if (ZDD && c[1] == 0) {
+            return c[0];
+        }
+        if (BDD && c[0] == c[1]) {
+            return c[0];
+        }
+
+        auto const i = static_cast<size_t>(fr.level);
+        NodeBase   key(c[0], c[1]);
+        auto*      col = uniq[i].getValue(key);
+
+        if (col != nullptr) {
+            return NodeId(i, *col, c[0].hasEmpty());
+        }
+
+        auto const j = output.addColumn(i);
+        for (auto b = 0UL; b < AR; ++b) {
+            output[i][j][b] = c[b];
+        }
+        uniq[i][key] = j;
+        return NodeId(i, j, c[0].hasEmpty());
+    }
+};
+
+#endif  // NODE_BDD_DFS_BUILDER_HPP
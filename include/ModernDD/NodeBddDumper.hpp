@@ -224,6 +224,7 @@ class DdDumper {
                         spec_nodes_table[ii].alloc_front(specNodeSize);
                     size_t jj = spec_nodes_table[ii].size() - 1;
                     spec.get_copy(state(pp), tmpState);
+                    spec.canonicalize_state(state(pp), ii);
 
                     // SpecNode*& pp0 = uniqTable[ii].add(pp);
                     auto aux = uniqTable[ii].insert(pp);
@@ -0,0 +1,479 @@
+#ifndef NODE_BDD_EDGE_VALUED_HPP
+#define NODE_BDD_EDGE_VALUED_HPP
+
+#include <algorithm>            // for min
+#include <array>                // for array
+#include <cstddef>              // for size_t
+#include <cstdint>              // for int64_t
+#include <functional>           // for hash
+#include <stdexcept>            // for runtime_error
+#include <type_traits>          // for is_standard_layout_v
+#include <unordered_map>        // for unordered_map
+#include <unordered_set>        // for unordered_set
+#include <utility>              // for move
+#include <vector>               // for vector
+#include "NodeBddBuilder.hpp"   // for BuilderBase
+#include "NodeId.hpp"           // for NodeId
+#include "util/HashPolicy.hpp"  // for DdHash
+#include "util/MyList.hpp"      // for MyList
+
+/**
+ * Arc of an edge-valued diagram: a target node and an additive weight.
+ * Arcs to the 0-terminal have weight 0.
+ * @tparam W the weight type.
+ */
+template <typename W>
+struct WeightedEdge {
+    NodeId node{};
+    W      weight{};
+
+    bool operator==(WeightedEdge const& o) const {
+        return node == o.node && weight == o.weight;
+    }
+};
+
+/**
+ * Breadth-first builder of edge-valued diagrams.
+ * It runs the level loop of DdBuilder, sharing its state insertion and
+ * child scheduling, with one change: after canonicalize_state(void*, int),
+ * the spec's factor_offset(void*, int) removes an additive cost from every
+ * state and the cost is stored on the arc entering the node. States equal
+ * up to their offset are thus merged. The node ID of a scheduled state goes
+ * to the node of its arc, next to the weight slot. The state of a
+ * 1-terminal is factored at level 0 and merge_states(void*, void*) is
+ * applied to non-terminal states only.
+ * @tparam S the spec type.
+ * @tparam W the weight type.
+ */
+template <typename S, typename W>
+class EdgeValuedBuilder : BuilderBase {
+    using Edge = WeightedEdge<W>;
+    using Row = std::vector<std::array<Edge, 2>>;
+    using UniqTable = std::unordered_set<SpecNode*, Hasher<S>, Hasher<S>>;
+    static_assert(S::ARITY == 2, "EdgeValuedBuilder: binary specs only");
+    static_assert(std::is_standard_layout_v<Edge>,
+                  "EdgeValuedBuilder: the node must lead its arc");
+
+    S                             spec;
+    size_t const                  specNodeSize;
+    std::vector<MyList<SpecNode>> spec_node_table;
+
+    /**
+     * Gets the arc entering a scheduled node, whose node srcPtr points to.
+     * @param p the scheduled node.
+     * @return the arc.
+     */
+    static Edge& arc(SpecNode* p) {
+        return *reinterpret_cast<Edge*>(srcPtr(p));
+    }
+
+    W factor(void* p, size_t level) {
+        return static_cast<W>(spec.factor_offset(p, static_cast<int>(level)));
+    }
+
+    /**
+     * Assigns node IDs to the scheduled states of one level.
+     * @param i level.
+     * @return the number of nodes at the level.
+     */
+    size_t deduplicate(size_t i) {
+        auto&     spec_nodes = spec_node_table[i];
+        Hasher<S> hasher(spec, i);
+        UniqTable uniq(spec_nodes.size() * 2, hasher, hasher);
+        size_t    m = 0;
+
+        for (auto* p : spec_nodes) {
+            spec.canonicalize_state(state(p), static_cast<int>(i));
+            W const   w = factor(state(p), i);
+            Edge&     e = arc(p);
+            SpecNode* p0 = p;
+
+            switch (insertState(spec, uniq, p, p0)) {
+                case -1:
+                    e = {NodeId(i, m++), w};
+                    nodeId(p) = e.node;
+                    break;
+                case 1:
+                    nodeId(p0) = 0;  // forward to 0-terminal
+                    e = {NodeId(i, m++), w};
+                    nodeId(p) = e.node;
+                    break;
+                case 2:
+                    e = {NodeId(0), W{}};
+                    nodeId(p) = 1;  // unused
+                    break;
+                default:
+                    e = {nodeId(p0), w};
+                    nodeId(p) = 1;  // unused
+                    break;
+            }
+        }
+        return m;
+    }
+
+    /**
+     * Creates the nodes of one level and schedules their children.
+     * @param i level.
+     * @param row the row of the level, holding its nodes.
+     */
+    void expand(size_t i, Row& row) {
+        auto& spec_nodes = spec_node_table[i];
+        auto* pp = spec_node_table[i - 1].alloc_front(specNodeSize);
+
+        for (; !spec_nodes.empty(); spec_nodes.pop_front()) {
+            SpecNode* p = spec_nodes.front();
+            if (nodeId(p) == 0 || nodeId(p) == 1) {
+                spec.destruct(state(p));
+                continue;
+            }
+
+            auto& q = row[nodeId(p).col()];
+            for (size_t b = 0; b < 2; ++b) {
+                spec.get_copy(state(pp), state(p));
+                int const ii =
+                    spec.get_child(state(pp), static_cast<int>(i), b);
+
+                if (ii == 0) {
+                    q[b] = {NodeId(0), W{}};
+                    spec.destruct(state(pp));
+                } else if (ii < 0) {
+                    q[b] = {NodeId(1), factor(state(pp), 0)};
+                    spec.destruct(state(pp));
+                } else {
+                    scheduleChild(spec, spec_node_table, specNodeSize, pp, i,
+                                  static_cast<size_t>(ii), &q[b].node);
+                }
+            }
+            spec.destruct(state(p));
+        }
+        spec_node_table[i - 1].pop_front();
+    }
+
+   public:
+    explicit EdgeValuedBuilder(S const& _spec)
+        : spec(_spec),
+          specNodeSize(getSpecNodeSize(_spec.datasize())) {}
+
+    /**
+     * Builds the diagram.
+     * @param table the rows of the diagram, replaced.
+     * @param root the arc to the root, replaced.
+     */
+    void build(std::vector<Row>& table, Edge& root) {
+        std::vector<char> tmp(spec.datasize());
+        void* const       tmpState = tmp.data();
+        int const         n = spec.get_root(tmpState);
+
+        table.assign(std::max(n, 0) + 1, Row());
+        if (n <= 0) {
+            root = {NodeId(0), W{}};
+            if (n < 0) {
+                root = {NodeId(1), factor(tmpState, 0)};
+            }
+            spec.destruct(tmpState);
+            return;
+        }
+
+        spec_node_table.assign(n + 1, MyList<SpecNode>());
+        SpecNode* p = spec_node_table[n].alloc_front(specNodeSize);
+        spec.get_copy(state(p), tmpState);
+        spec.destruct(tmpState);
+        srcPtr(p) = &root.node;
+
+        for (auto i = static_cast<size_t>(n); i >= 1; --i) {
+            table[i].resize(deduplicate(i));
+            expand(i, table[i]);
+        }
+    }
+};
+
+/**
+ * Diagram whose arcs carry additive weights (EVBDD/EVZDD).
+ * The cost of a path is the sum of the weights of its arcs, including the
+ * arc to the root. Specs define the cost through
+ * DdSpecBase::factor_offset(void*, int): a state keeps the cost added since
+ * the parent node, which the builder moves onto the arc, so that nodes
+ * differing only by an additive constant are shared instead of being
+ * distinguished by their cost.
+ *
+ * The reduction normalises every node so that the least weight of its arcs
+ * to live nodes is 0, the removed part being added to the incoming arcs.
+ * The reduced diagram is canonical, and the weight of the root arc is then
+ * the least cost of a path to the 1-terminal.
+ * @tparam W the weight type.
+ */
+template <typename W = int64_t>
+class EdgeValuedDd {
+   public:
+    using Edge = WeightedEdge<W>;
+
+   private:
+    using Row = std::vector<std::array<Edge, 2>>;
+
+    std::vector<Row> table = std::vector<Row>(1);
+    Edge             root_{};
+    bool             zdd{true};
+
+    struct NodeKey {
+        Edge e0;
+        Edge e1;
+
+        bool operator==(NodeKey const& o) const {
+            return e0 == o.e0 && e1 == o.e1;
+        }
+    };
+
+    struct NodeKeyHash {
+        size_t operator()(NodeKey const& k) const {
+            std::hash<W> h;
+            if constexpr (DdHash::historical) {
+                return (k.e0.node.hash() + h(k.e0.weight)) * 314159257 +
+                       (k.e1.node.hash() + h(k.e1.weight)) * 271828171;
+            } else {
+                size_t x = 0;
+                for (auto const& e : {k.e0, k.e1}) {
+                    x = DdHash::combine(x, e.node.code());
+                    x = DdHash::combine(x, h(e.weight));
+                }
+                return DdHash::finish(x);
+            }
+        }
+    };
+
+    [[nodiscard]] Edge const& arc(NodeId f, size_t b) const {
+        return table[f.row()][f.col()][b];
+    }
+
+    void reduce(bool asZdd) {
+        std::vector<Row>               output(table.size());
+        std::vector<std::vector<Edge>> newEdge(table.size());
+
+        auto const follow = [&](Edge e) {
+            if (e.node.row() == 0) {
+                return (e.node == 0) ? Edge{} : e;
+            }
+            Edge const r = newEdge[e.node.row()][e.node.col()];
+            return (r.node == 0) ? Edge{} : Edge{r.node, r.weight + e.weight};
+        };
+
+        for (auto i = 1UL; i < table.size(); ++i) {
+            std::unordered_map<NodeKey, size_t, NodeKeyHash> uniq;
+            newEdge[i].resize(table[i].size());
+            for (auto j = 0UL; j < table[i].size(); ++j) {
+                Edge e0 = follow(table[i][j][0]);
+                Edge e1 = follow(table[i][j][1]);
+                auto& r = newEdge[i][j];
+
+                if (e0.node == 0 && e1.node == 0) {
+                    r = Edge{};
+                } else if (asZdd ? e1.node == 0 : e0 == e1) {
+                    r = e0;
+                } else {
+                    W const m = (e0.node == 0)   ? e1.weight
+                                : (e1.node == 0) ? e0.weight
+                                                 : std::min(e0.weight,
+                                                            e1.weight);
+                    if (e0.node != 0) {
+                        e0.weight -= m;
+                    }
+                    if (e1.node != 0) {
+                        e1.weight -= m;
+                    }
+                    auto [it, added] =
+                        uniq.try_emplace(NodeKey{e0, e1}, output[i].size());
+                    if (added) {
+                        output[i].push_back({e0, e1});
+                    }
+                    r = Edge{NodeId(i, it->second), m};
+                }
+            }
+        }
+
+        root_ = follow(root_);
+        table = std::move(output);
+        table.resize(std::max<size_t>(table.size(), 1));
+        zdd = asZdd;
+    }
+
+    template <typename F>
+    void enumerate(Edge e,
+                   size_t            from,
+                   W                 cost,
+                   std::vector<int>& items,
+                   F&                f) const {
+        if (e.node == 0) {
+            return;
+        }
+        if (!zdd && from > e.node.row() + 1) {
+            // branch on the highest don't-care level skipped by e
+            auto const l = from - 1;
+            enumerate(e, l, cost, items, f);
+            items.push_back(static_cast<int>(l));
+            enumerate(e, l, cost, items, f);
+            items.pop_back();
+            return;
+        }
+        cost += e.weight;
+        if (e.node.row() == 0) {
+            f(static_cast<std::vector<int> const&>(items), cost);
+            return;
+        }
+        auto const i = e.node.row();
+        enumerate(arc(e.node, 0), i, cost, items, f);
+        items.push_back(static_cast<int>(i));
+        enumerate(arc(e.node, 1), i, cost, items, f);
+        items.pop_back();
+    }
+
+   public:
+    EdgeValuedDd() = default;
+
+    /**
+     * Builds a diagram from a spec.
+     * The levels skipped by arcs are read as must-be-0, as in a ZDD.
+     * @param spec the spec; its factor_offset(void*, int) gives the weights.
+     */
+    template <typename S>
+    explicit EdgeValuedDd(S const& spec) {
+        EdgeValuedBuilder<S, W>(spec).build(table, root_);
+    }
+
+    /**
+     * Gets the arc to the root.
+     * @return the root arc.
+     */
+    [[nodiscard]] Edge root() const { return root_; }
+
+    /**
+     * Gets a child arc.
+     * @param f node ID.
+     * @param b child branch.
+     * @return the @p b-arc of @p f.
+     */
+    [[nodiscard]] Edge child(NodeId f, size_t b) const { return arc(f, b); }
+
+    /**
+     * Gets the number of levels, including the terminal level 0.
+     * @return the number of levels.
+     */
+    [[nodiscard]] size_t numRows() const { return table.size(); }
+
+    /**
+     * Gets the number of nodes of a level.
+     * @param i the level.
+     * @return the number of nodes.
+     */
+    [[nodiscard]] size_t levelSize(size_t i) const { return table[i].size(); }
+
+    /**
+     * Gets the number of non-terminal nodes.
+     * @return the number of nodes.
+     */
+    [[nodiscard]] size_t size() const {
+        size_t n = 0;
+        for (auto const& row : table) {
+            n += row.size();
+        }
+        return n;
+    }
+
+    /**
+     * Applies the normalising ZDD reduction rules.
+     */
+    void reduceZdd() { reduce(true); }
+
+    /**
+     * Applies the normalising BDD reduction rules; skipped levels are read
+     * as don't-care afterwards.
+     */
+    void bddReduce() { reduce(false); }
+
+    /**
+     * Evaluates the diagram bottom-up.
+     * The weight of an arc to a live node is added to the value of the
+     * node before it is passed to @p node; arcs to the 0-terminal pass
+     * terminal(false) unchanged.
+     * @param terminal function giving the value of terminal @p b.
+     * @param node function giving the value of a node at a level from the
+     * values of its 0- and 1-arcs.
+     * @return the value of the root arc.
+     */
+    template <typename R, typename TERMINAL, typename NODE>
+    R evaluate(TERMINAL&& terminal, NODE&& node) const {
+        std::vector<std::vector<R>> value(table.size());
+        R const                     zero = terminal(false);
+        R const                     one = terminal(true);
+
+        auto const along = [&](Edge const& e) {
+            if (e.node == 0) {
+                return zero;
+            }
+            R const& v =
+                (e.node.row() == 0) ? one : value[e.node.row()][e.node.col()];
+            return v + e.weight;
+        };
+
+        for (auto i = 1UL; i < table.size(); ++i) {
+            value[i].reserve(table[i].size());
+            for (auto const& n : table[i]) {
+                value[i].push_back(
+                    node(static_cast<int>(i), along(n[0]), along(n[1])));
+            }
+        }
+        return along(root_);
+    }
+
+    /**
+     * Gets the least cost of a path to the 1-terminal.
+     * @return the least cost.
+     * @exception std::runtime_error the diagram has no such path.
+     */
+    [[nodiscard]] W minimum() const {
+        std::vector<std::vector<W>>    best(table.size());
+        std::vector<std::vector<char>> live(table.size());
+
+        auto const along = [&](Edge const& e, W& v) {
+            if (e.node == 0) {
+                return false;
+            }
+            if (e.node.row() == 0) {
+                v = e.weight;
+                return true;
+            }
+            v = best[e.node.row()][e.node.col()] + e.weight;
+            return live[e.node.row()][e.node.col()] != 0;
+        };
+
+        for (auto i = 1UL; i < table.size(); ++i) {
+            best[i].resize(table[i].size());
+            live[i].resize(table[i].size());
+            for (auto j = 0UL; j < table[i].size(); ++j) {
+                W          v0{};
+                W          v1{};
+                bool const l0 = along(table[i][j][0], v0);
+                bool const l1 = along(table[i][j][1], v1);
+                live[i][j] = l0 || l1;
+                best[i][j] = (l0 && l1) ? std::min(v0, v1) : (l0 ? v0 : v1);
+            }
+        }
+
+        W v{};
+        if (!along(root_, v)) {
+            throw std::runtime_error("EdgeValuedDd: no path to 1-terminal");
+        }
+        return v;
+    }
+
+    /**
+     * Calls a function on every set of the family with its cost.
+     * @param f the function, called with the levels of the 1-variables in
+     * decreasing order as a std::vector<int> const& and the cost as a W.
+     */
+    template <typename F>
+    void forEachSet(F&& f) const {
+        std::vector<int> items;
+        enumerate(root_, table.size(), W{}, items, f);
+    }
+};
+
+#endif  // NODE_BDD_EDGE_VALUED_HPP
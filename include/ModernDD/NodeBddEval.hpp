@@ -84,4 +84,39 @@ class Eval {
     Eval<T, R>& operator=(Eval<T, R>&&) noexcept = default;
     virtual ~Eval() = default;
 };
+
+/**
+ * @brief Base class of the evaluators of a path cost that support
+ * DdStructure::evaluate_forward_bounded
+ * In addition to the functions of Eval, where evalNode propagates the
+ * label of a node to its children, every derived class needs:
+ * - double cost(T const&): the cost of the best path from the root to the
+ * node found so far, +infinity for a node that no path reached
+ * - double completion_bound(T const&): a lower bound on the cost of any
+ * path from the node to the 1-terminal, e.g. from the previous pricing
+ * iteration or a cheap relaxation
+ *
+ * @tparam T: type of the Node
+ * @tparam R: type of the Solution
+ */
+template <typename T, typename R = T>
+class BoundedEval : public Eval<T, R> {
+   public:
+    /**
+     * @brief Cost of the best path from the root to the node found so far
+     *
+     * @param n Node
+     * @return double +infinity if the node has not been reached
+     */
+    virtual double cost(T const& n) const = 0;
+
+    /**
+     * @brief Lower bound on the cost of completing a path from the node to
+     * the 1-terminal
+     *
+     * @param n Node
+     * @return double the bound
+     */
+    virtual double completion_bound(T const& n) const = 0;
+};
 #endif  // __NODEBDDEVAL_H__
\ No newline at end of file
@@ -0,0 +1,324 @@
+#ifndef NODE_BDD_FILE_HPP
+#define NODE_BDD_FILE_HPP
+
+#include <fcntl.h>               // for open, O_RDONLY
+#include <sys/mman.h>            // for mmap, munmap, madvise, MADV_DONTNEED
+#include <sys/stat.h>            // for fstat, stat
+#include <unistd.h>              // for close, sysconf, _SC_PAGESIZE
+#include <algorithm>             // for max
+#include <cerrno>                // for errno
+#include <cstddef>               // for size_t
+#include <cstdint>               // for uint64_t, uintptr_t
+#include <cstring>               // for strerror
+#include <fstream>               // for ofstream
+#include <stdexcept>             // for runtime_error
+#include <string>                // for string, to_string
+#include <utility>               // for exchange, move
+#include <vector>                // for vector
+#include "NodeBddStructure.hpp"  // for DdStructure
+#include "NodeBddTable.hpp"      // for TableHandler
+#include "NodeId.hpp"            // for NodeId
+
+/* Diagram file
+ * ┌────────┬─────────┬──────┬───────────┬──────────┬─────┬───────────────┐
+ * │ magic  │ numRows │ root │ directory │ level    │ ... │ directory:    │
+ * │        │         │ code │ offset    │ words    │     │ offset, words │
+ * │        │         │      │           │          │     │ per level     │
+ * └────────┴─────────┴──────┴───────────┴──────────┴─────┴───────────────┘
+ * All fields are 64-bit words in host byte order. The words of a level are
+ * the child codes of its nodes, two per node, with their attribute bits;
+ * level 0 has none. The root code keeps its attribute bit too. Levels may
+ * be written in any order, since the directory at the end locates them.
+ */
+inline constexpr uint64_t DD_FILE_MAGIC = 0x31454c4946444d4dULL;  // MMDFILE1
+inline constexpr size_t   DD_FILE_HEADER_WORDS = 4;
+
+/**
+ * Streaming writer of a diagram file.
+ * Only the word being buffered is held in memory, so that diagrams larger
+ * than the memory can be written level by level.
+ */
+class DdFileWriter {
+    std::ofstream         os;
+    std::string           path;
+    std::vector<uint64_t> directory;
+    size_t                current{};
+    uint64_t              position = DD_FILE_HEADER_WORDS;
+
+    void check() {
+        if (!os) {
+            throw std::runtime_error("DdFileWriter: cannot write " + path);
+        }
+    }
+
+   public:
+    /**
+     * Constructor.
+     * @param _path the file to create.
+     * @param numRows the number of levels including level 0.
+     * @exception std::runtime_error the file cannot be created.
+     */
+    DdFileWriter(std::string _path, size_t numRows)
+        : os(_path, std::ios::binary | std::ios::trunc),
+          path(std::move(_path)),
+          directory(2 * numRows) {
+        check();
+        uint64_t const header[DD_FILE_HEADER_WORDS] = {};
+        os.write(reinterpret_cast<char const*>(header), sizeof(header));
+        check();
+    }
+
+    /**
+     * Starts the words of a level; each level is written at most once.
+     * @param i the level.
+     */
+    void level(size_t i) {
+        if (2 * i >= directory.size()) {
+            throw std::runtime_error("DdFileWriter: level out of range");
+        }
+        current = i;
+        directory[2 * i] = position;
+        directory[2 * i + 1] = 0;
+    }
+
+    /**
+     * Appends a word to the current level.
+     * @param w the word.
+     */
+    void put(uint64_t w) {
+        os.write(reinterpret_cast<char const*>(&w), sizeof(w));
+        ++directory[2 * current + 1];
+        ++position;
+    }
+
+    /**
+     * Appends a node to the current level.
+     * @param f0 the 0-child.
+     * @param f1 the 1-child.
+     */
+    void put(NodeId f0, NodeId f1) {
+        put(word(f0));
+        put(word(f1));
+    }
+
+    /**
+     * Writes the directory and the header and closes the file.
+     * @param root the root node.
+     * @exception std::runtime_error the file cannot be written.
+     */
+    void close(NodeId root) {
+        os.write(reinterpret_cast<char const*>(directory.data()),
+                 static_cast<std::streamsize>(directory.size() *
+                                              sizeof(uint64_t)));
+        uint64_t const header[DD_FILE_HEADER_WORDS] = {
+            DD_FILE_MAGIC, directory.size() / 2, word(root), position};
+        os.seekp(0);
+        os.write(reinterpret_cast<char const*>(header), sizeof(header));
+        os.close();
+        check();
+    }
+
+   private:
+    /**
+     * Gets the code of a node with its attribute bit.
+     */
+    static uint64_t word(NodeId f) {
+        return f.code() | (f.getAttr() ? NODE_ATTR_MASK : 0);
+    }
+};
+
+/**
+ * Read-only diagram file mapped into memory.
+ * Nodes are read directly from the mapping, so that only the pages
+ * touched are resident and the kernel may drop them again under memory
+ * pressure; release() tells it that a level is no longer needed.
+ */
+class DdFile {
+    uint64_t const* words{};
+    size_t          length{};
+    uint64_t const* directory{};
+    size_t          rows{};
+    NodeId          root_{};
+
+    [[noreturn]] static void fail(std::string const& what) {
+        throw std::runtime_error("DdFile: " + what);
+    }
+
+   public:
+    /**
+     * Maps a file.
+     * @param path the file.
+     * @exception std::runtime_error the file cannot be read or is not a
+     * diagram file.
+     */
+    explicit DdFile(std::string const& path) {
+        int const fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            fail(path + ": " + std::strerror(errno));
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            fail(path + ": " + std::strerror(errno));
+        }
+        length = static_cast<size_t>(st.st_size);
+        if (length < DD_FILE_HEADER_WORDS * sizeof(uint64_t)) {
+            ::close(fd);
+            fail(path + ": not a diagram file");
+        }
+        void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            fail(path + ": " + std::strerror(errno));
+        }
+        words = static_cast<uint64_t const*>(p);
+
+        auto const n = length / sizeof(uint64_t);
+        rows = words[1];
+        if (words[0] != DD_FILE_MAGIC || words[3] > n ||
+            (n - words[3]) / 2 < rows) {
+            unmap();
+            fail(path + ": not a diagram file");
+        }
+        root_ = NodeId(words[2]);
+        directory = words + words[3];
+        for (auto i = 0UL; i < rows; ++i) {
+            auto const offset = directory[2 * i];
+            if (offset > n || n - offset < directory[2 * i + 1]) {
+                unmap();
+                fail(path + ": truncated level " + std::to_string(i));
+            }
+        }
+    }
+
+    DdFile(DdFile const&) = delete;
+    DdFile& operator=(DdFile const&) = delete;
+
+    ~DdFile() { unmap(); }
+
+    /**
+     * Gets the root node.
+     * @return the root node ID.
+     */
+    [[nodiscard]] NodeId root() const { return root_; }
+
+    /**
+     * Gets the number of levels including level 0.
+     * @return the number of levels.
+     */
+    [[nodiscard]] size_t numRows() const { return rows; }
+
+    /**
+     * Gets the words of a level.
+     * @param i the level.
+     * @return the first word.
+     */
+    [[nodiscard]] uint64_t const* level(size_t i) const {
+        return words + directory[2 * i];
+    }
+
+    /**
+     * Gets the number of words of a level.
+     * @param i the level.
+     * @return the number of words.
+     */
+    [[nodiscard]] size_t numWords(size_t i) const {
+        return directory[2 * i + 1];
+    }
+
+    /**
+     * Gets the number of nodes at a level.
+     * @param i the level.
+     * @return the number of nodes.
+     */
+    [[nodiscard]] size_t size(size_t i) const { return numWords(i) / 2; }
+
+    /**
+     * Gets a child of a node.
+     * @param i the level of the node.
+     * @param j the column of the node.
+     * @param b the branch.
+     * @return the child node ID, with its attribute.
+     */
+    [[nodiscard]] NodeId child(size_t i, size_t j, int b) const {
+        return level(i)[2 * j + b];
+    }
+
+    /**
+     * Gets a child of a node.
+     * @param f the node.
+     * @param b the branch.
+     * @return the child node ID.
+     */
+    [[nodiscard]] NodeId child(NodeId f, int b) const {
+        return child(f.row(), f.col(), b);
+    }
+
+    /**
+     * Tells the kernel that the pages of a level will not be read soon.
+     * The mapping stays valid; the pages are read back from the file if
+     * they are needed again.
+     * @param i the level.
+     */
+    void release(size_t i) const {
+        static auto const page =
+            static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+        auto const begin = reinterpret_cast<uintptr_t>(level(i));
+        auto const end = begin + numWords(i) * sizeof(uint64_t);
+        auto const first = (begin + page - 1) & ~(page - 1);
+        auto const last = end & ~(page - 1);
+        if (first < last) {
+            ::madvise(reinterpret_cast<void*>(first), last - first,
+                      MADV_DONTNEED);
+        }
+    }
+
+    /**
+     * Loads the whole diagram into memory.
+     * @return the diagram.
+     */
+    template <typename T>
+    [[nodiscard]] DdStructure<T> load() const {
+        TableHandler<T> table(rows);
+        auto&           entity = *table;
+        for (auto i = 1UL; i < rows; ++i) {
+            entity.initRow(i, size(i));
+            for (auto j = 0UL; j < size(i); ++j) {
+                for (int b = 0; b < 2; ++b) {
+                    entity[i][j][b] = child(i, j, b);
+                }
+            }
+        }
+        return DdStructure<T>(std::move(table), root_);
+    }
+
+   private:
+    void unmap() {
+        if (words != nullptr) {
+            ::munmap(const_cast<uint64_t*>(std::exchange(words, nullptr)),
+                     length);
+        }
+    }
+};
+
+/**
+ * Writes a diagram to a file.
+ * @param dd the diagram.
+ * @param path the file to create.
+ * @exception std::runtime_error the file cannot be written.
+ */
+template <typename T>
+void saveDd(DdStructure<T> const& dd, std::string const& path) {
+    auto const&  table = *dd.getDiagram();
+    auto const   rows = std::max<size_t>(table.numRows(), 1);
+    DdFileWriter writer(path, rows);
+    for (auto i = 1UL; i < rows; ++i) {
+        writer.level(i);
+        for (auto j = 0UL; j < table[i].size(); ++j) {
+            writer.put(table.child(i, j, 0), table.child(i, j, 1));
+        }
+    }
+    writer.close(dd.root());
+}
+
+#endif  // NODE_BDD_FILE_HPP
@@ -0,0 +1,263 @@
+#ifndef NODE_BDD_FINGERPRINT_BUILDER_HPP
+#define NODE_BDD_FINGERPRINT_BUILDER_HPP
+
+#include <cassert>               // for assert
+#include <cstddef>               // for size_t
+#include <stdexcept>             // for runtime_error
+#include <string>                // for to_string
+#include <vector>                // for vector
+#include "NodeBddBuilder.hpp"    // for BuilderBase
+#include "NodeBddProfile.hpp"    // for DdProfile, DdPhase
+#include "NodeBddSweeper.hpp"    // for DdSweeper
+#include "NodeBddTable.hpp"      // for NodeTableEntity, TableHandler
+#include "NodeBranchId.hpp"      // for NodeBranchId
+#include "NodeId.hpp"            // for NodeId
+#include "util/Fingerprint.hpp"  // for Fingerprint
+#include "util/MyHashTable.hpp"  // for MyHashMap
+#include "util/MyList.hpp"       // for MyList
+
+/**
+ * Statistics of a fingerprint-deduplicated build.
+ */
+struct FingerprintReport {
+    size_t lookups{};   ///< States looked up in the fingerprint tables.
+    size_t entries{};   ///< Distinct fingerprints, i.e. nodes created.
+    size_t verified{};  ///< Matches confirmed with equal_to.
+    /// Upper bound on the probability that two distinct states were merged:
+    /// the sum over the levels of lookups * entries / 2^128.
+    double collisionBound{};
+};
+
+/**
+ * Breadth-first DD builder that deduplicates states by 128-bit
+ * fingerprints.
+ * A child state is canonicalized, fingerprinted and looked up as soon as
+ * it is computed. Only the first state of every fingerprint is kept, as
+ * the representative to be expanded; the others are merged into it with
+ * merge_states and destroyed at once. The table of a level holds
+ * fingerprints, not states, and is released when the level is expanded.
+ * DdBuilder instead keeps every scheduled state, duplicates included,
+ * until its level is deduplicated.
+ *
+ * The fingerprint is taken over the datasize() bytes of the canonicalized
+ * state, so states that equal_to considers equal must have equal bytes;
+ * otherwise they become distinct nodes, which is correct but larger. Two
+ * distinct states merge only if their fingerprints collide, which
+ * FingerprintReport bounds. With verification, every match is checked
+ * with equal_to and a collision throws std::runtime_error.
+ */
+template <typename S, typename T>
+class DdFingerprintBuilder : BuilderBase {
+    using Spec = S;
+    using FingerprintTable = MyHashMap<Fingerprint, SpecNode*>;
+    static size_t const AR = Spec::ARITY;
+
+    Spec                spec;
+    size_t const        specNodeSize;
+    NodeTableEntity<T>& output;
+    DdSweeper<T>        sweeper;
+    bool const          verify;
+
+    std::vector<MyList<SpecNode>> spec_node_table;
+    std::vector<FingerprintTable> tables;
+    std::vector<size_t>           lookups;
+    std::vector<size_t>           rowSize;
+    FingerprintReport             report_;
+
+    std::vector<char>         oneStorage;
+    void* const               one;
+    std::vector<NodeBranchId> oneSrcPtr;
+
+   public:
+    /**
+     * Constructor.
+     * @param _spec DD spec.
+     * @param _output the table receiving the diagram.
+     * @param _verify confirm every fingerprint match with equal_to.
+     */
+    DdFingerprintBuilder(Spec const&      _spec,
+                         TableHandler<T>& _output,
+                         bool             _verify = false)
+        : spec(_spec),
+          specNodeSize(getSpecNodeSize(_spec.datasize())),
+          output(*_output),
+          sweeper(this->output, oneSrcPtr),
+          verify(_verify),
+          oneStorage(_spec.datasize()),
+          one(oneStorage.data()) {}
+
+    ~DdFingerprintBuilder() {
+        if (!oneSrcPtr.empty()) {
+            spec.destruct(one);
+            oneSrcPtr.clear();
+        }
+    }
+
+    DdFingerprintBuilder(DdFingerprintBuilder const&) = delete;
+    DdFingerprintBuilder& operator=(DdFingerprintBuilder const&) = delete;
+
+    /**
+     * Initializes the builder.
+     * @param root result storage.
+     * @return the level of the root, or 0 if it is a terminal.
+     */
+    int initialize(NodeId& root) {
+        sweeper.setRoot(root);
+        std::vector<char> tmp(spec.datasize());
+        void* const       tmpState = tmp.data();
+        auto              n = spec.get_root(tmpState);
+
+        if (n <= 0) {
+            root = n ? NodeId(1) : NodeId(0);
+            spec.destruct(tmpState);
+            return 0;
+        }
+
+        auto const rows = static_cast<size_t>(n) + 1;
+        spec_node_table.resize(rows);
+        tables.resize(rows);
+        lookups.assign(rows, 0);
+        rowSize.assign(rows, 0);
+        if (rows > output.numRows()) {
+            output.setNumRows(rows);
+        }
+        root = lookup(static_cast<size_t>(n), tmpState);
+        return n;
+    }
+
+    /**
+     * Builds one level.
+     * @param i level.
+     */
+    void construct(size_t i) {
+        assert(0UL < i && i < spec_node_table.size());
+        DdProfile::Scope const profile(DdPhase::Construct, i);
+
+        auto const entries = tables[i].size();
+        report_.lookups += lookups[i];
+        report_.entries += entries;
+        report_.collisionBound += static_cast<double>(lookups[i]) *
+                                  static_cast<double>(entries) * 0x1p-128;
+        tables[i].clear();
+
+        auto& spec_nodes = spec_node_table[i];
+        auto  lowestChild = i - 1;
+        auto  deadCount = 0UL;
+
+        output[i].resize(rowSize[i]);
+        std::vector<SpecNode> tmp(specNodeSize);
+        void* const           tmpState = state(tmp.data());
+
+        for (; !spec_nodes.empty(); spec_nodes.pop_front()) {
+            SpecNode* p = spec_nodes.front();
+
+            if (nodeId(p) == 0) {  // its row entry keeps null children
+                spec.destruct(state(p));
+                ++deadCount;
+                continue;
+            }
+
+            auto const jj = nodeId(p).col();
+            T&         q = output[i][jj];
+            bool       allZero = true;
+
+            for (auto b = 0UL; b < AR; ++b) {
+                spec.get_copy(tmpState, state(p));
+                auto const ii =
+                    spec.get_child(tmpState, static_cast<int>(i), b);
+
+                if (ii == 0) {
+                    q[b] = 0;
+                    spec.destruct(tmpState);
+                } else if (ii < 0) {
+                    q[b] = mergeIntoOne(spec, one, oneSrcPtr, output,
+                                        tmpState, i, jj, b);
+                    spec.destruct(tmpState);
+                } else {
+                    assert(static_cast<size_t>(ii) < i);
+                    q[b] = lookup(static_cast<size_t>(ii), tmpState);
+                    if (static_cast<size_t>(ii) < lowestChild) {
+                        lowestChild = static_cast<size_t>(ii);
+                    }
+                }
+                if (q[b] != 0) {
+                    allZero = false;
+                }
+            }
+
+            spec.destruct(state(p));
+            if (allZero) {
+                ++deadCount;
+            }
+        }
+
+        sweeper.update(i, lowestChild, deadCount);
+    }
+
+    /**
+     * Gets the statistics of the levels built so far.
+     * @return the report.
+     */
+    [[nodiscard]] FingerprintReport const& report() const { return report_; }
+
+   private:
+    /**
+     * Gets the node of a state, creating it if its fingerprint is new.
+     * @param i the level of the state.
+     * @param s the state, destroyed.
+     * @return the node ID, or the 0-terminal if merge_states drops it.
+     */
+    NodeId lookup(size_t i, void* s) {
+        spec.canonicalize_state(s, static_cast<int>(i));
+        auto const fp = Fingerprint::of(s, spec.datasize(), i);
+        ++lookups[i];
+
+        SpecNode*& p0 = tables[i][fp];
+        if (p0 == nullptr) {
+            p0 = create(i, s);
+            return nodeId(p0);
+        }
+
+        if (verify) {
+            ++report_.verified;
+            if (!spec.equal_to(state(p0), s, static_cast<int>(i))) {
+                spec.destruct(s);
+                throw std::runtime_error(
+                    "DdFingerprintBuilder: fingerprint collision at level " +
+                    std::to_string(i));
+            }
+        }
+
+        NodeId f;
+        switch (spec.merge_states(state(p0), s)) {
+            case 1:
+                nodeId(p0) = 0;  // forward to 0-terminal
+                p0 = create(i, s);
+                return nodeId(p0);
+            case 2:
+                f = 0;
+                break;
+            default:
+                f = nodeId(p0);
+                break;
+        }
+        spec.destruct(s);
+        return f;
+    }
+
+    /**
+     * Makes a state the representative of a new node.
+     * @param i the level of the state.
+     * @param s the state, destroyed.
+     * @return the representative.
+     */
+    SpecNode* create(size_t i, void* s) {
+        SpecNode* p = spec_node_table[i].alloc_front(specNodeSize);
+        spec.get_copy(state(p), s);
+        spec.destruct(s);
+        nodeId(p) = NodeId(i, rowSize[i]++);
+        return p;
+    }
+};
+
+#endif  // NODE_BDD_FINGERPRINT_BUILDER_HPP
@@ -0,0 +1,167 @@
+#ifndef NODE_BDD_FIXER_HPP
+#define NODE_BDD_FIXER_HPP
+
+#include <cassert>               // for assert
+#include <cstddef>               // for size_t
+#include <vector>                // for vector
+#include "NodeBase.hpp"          // for NodeBase
+#include "NodeBddTable.hpp"      // for NodeTableEntity, TableHandler
+#include "NodeId.hpp"            // for NodeId
+#include "util/MyHashTable.hpp"  // for MyHashMap
+
+/**
+ * In-place variable fixing on a ZDD.
+ * The forbidden branch at the fixed level is redirected to the 0-terminal and
+ * only the rows above it whose nodes change are re-reduced, bottom-up, so the
+ * work is proportional to the part of the diagram above the fixed level.
+ * When fixing to 0 on a table that already has its level index, the rows
+ * whose lowest referenced level (taken from higherLevels) lies above every
+ * modified row are not even scanned. The index is not built for that, since
+ * building it is a pass over the whole table.
+ * Nodes that become unreachable are not removed; the next reduction does.
+ * All modifications go through the journaled mutators of NodeTableEntity, so
+ * they can be undone by a rollback.
+ * @tparam T the node type.
+ */
+template <typename T>
+class DdFixer {
+    NodeTableEntity<T>& diagram;
+    NodeId&             root;
+
+    std::vector<std::vector<NodeId>> newId;  ///< Remapping of modified rows.
+
+    NodeId remap(NodeId f) const {
+        auto const& row = newId[f.row()];
+        return row.empty() ? f : row[f.col()];
+    }
+
+    void clearRows() {
+        for (auto i = 1UL; i < diagram.numRows(); ++i) {
+            diagram.resizeRow(i, 0);
+        }
+    }
+
+    /**
+     * Applies the ZDD node deletion rule and the node sharing rule to a row
+     * whose nodes have been modified, and compacts it.
+     * @param i the row.
+     */
+    void reduceRow(size_t i) {
+        auto&                       row = diagram[i];
+        auto const                  m = row.size();
+        auto&                       ids = newId[i];
+        MyHashMap<NodeBase, size_t> uniq(m * 2);
+        size_t                      mm = 0;
+
+        ids.resize(m);
+        for (auto j = 0UL; j < m; ++j) {
+            NodeId const f0 = row[j][0];
+            NodeId const f1 = row[j][1];
+
+            if (f1 == 0) {
+                ids[j] = f0;
+                continue;
+            }
+
+            NodeBase key(f0, f1);
+            auto*    col = uniq.getValue(key);
+            if (col != nullptr) {
+                ids[j] = NodeId(i, *col, f0.hasEmpty());
+                continue;
+            }
+
+            uniq[key] = mm;
+            ids[j] = NodeId(i, mm, f0.hasEmpty());
+            T node = row[j];
+            node.set_node_id_label(ids[j]);
+            diagram.setNode(i, mm, node);
+            ++mm;
+        }
+        diagram.resizeRow(i, mm);
+    }
+
+   public:
+    /**
+     * Constructor.
+     * @param _diagram the ZDD.
+     * @param _root reference to the root.
+     */
+    DdFixer(TableHandler<T>& _diagram, NodeId& _root)
+        : diagram(*_diagram),
+          root(_root) {}
+
+    /**
+     * Fixes the variable at a level.
+     * @param level the level of the variable.
+     * @param value the value of the variable.
+     */
+    void fix(size_t level, bool value) {
+        assert(level >= 1);
+        auto const n = root.row();
+
+        if (n < level) {
+            if (value) {  // every set in the family excludes the variable
+                root = 0;
+                clearRows();
+            }
+            return;
+        }
+
+        std::vector<size_t> lowest(n + 1, 0);
+        if (!value && diagram.hasIndex()) {
+            for (auto t = 1UL; t <= n; ++t) {
+                for (auto r : diagram.higherLevels(static_cast<int>(t))) {
+                    if (r <= n) {
+                        lowest[r] = t;
+                    }
+                }
+            }
+        }
+
+        newId.assign(n + 1, {});
+
+        for (auto j = 0UL; j < diagram[level].size(); ++j) {
+            diagram.setChild(level, j, value ? 0 : 1, 0);
+        }
+        reduceRow(level);
+
+        auto highestModified = level;
+        for (auto i = level + 1; i <= n; ++i) {
+            if (lowest[i] > highestModified) {
+                continue;
+            }
+
+            bool modified = false;
+            for (auto j = 0UL; j < diagram[i].size(); ++j) {
+                for (auto b = 0UL; b < 2; ++b) {
+                    NodeId const old = diagram.child(i, j, b);
+                    NodeId       f = old;
+                    if (value && f.row() < level && f != 0) {
+                        f = 0;  // skips the level, so the variable is 0
+                    } else {
+                        f = remap(f);
+                    }
+                    if (f != old || f.getAttr() != old.getAttr()) {
+                        diagram.setChild(i, j, b, f);
+                        modified = true;
+                    }
+                }
+            }
+
+            if (modified) {
+                reduceRow(i);
+                highestModified = i;
+            }
+        }
+
+        root = remap(root);
+        newId.clear();
+        diagram.deleteIndex();
+
+        if (root == 0) {
+            clearRows();
+        }
+    }
+};
+
+#endif  // NODE_BDD_FIXER_HPP
@@ -0,0 +1,235 @@
+#ifndef NODE_BDD_FROZEN_HPP
+#define NODE_BDD_FROZEN_HPP
+
+#include <algorithm>             // for max
+#include <bit>                   // for bit_width
+#include <cstddef>               // for size_t
+#include <cstdint>               // for uint64_t, uint32_t, uint8_t
+#include <stdexcept>             // for runtime_error
+#include <vector>                // for vector
+#include "NodeBddStructure.hpp"  // for DdStructure
+#include "NodeId.hpp"            // for NodeId
+
+/**
+ * Read-only succinct copy of the structure of a diagram.
+ * The children of level i are stored as bit fields of a width chosen for
+ * that level: the high bits hold the level distance to the child and the
+ * low bits its column. A distance equal to i denotes a terminal, whose
+ * column is 0 or 1. Fields of consecutive nodes are packed without padding,
+ * so that child() costs one or two word reads. Node payloads are not kept;
+ * evaluate() computes values bottom-up into a flat array instead.
+ * Edge attributes, such as those of reduceZdd, are kept as one bit per
+ * node, so all the edges to a node must agree on its attribute.
+ */
+class FrozenDd {
+    struct Level {
+        uint64_t base{};     ///< Bit offset of the first field.
+        uint64_t first{};    ///< Index of the first node; 0 for level 0.
+        uint32_t size{};     ///< Number of nodes.
+        uint8_t  colBits{};  ///< Bits of the column part of a field.
+        uint8_t  width{};    ///< Bits of a field.
+    };
+
+    std::vector<uint64_t> bits;
+    std::vector<uint64_t> attrs;  ///< Attribute bits by index; empty if none.
+    std::vector<Level>    levels = std::vector<Level>(1);
+    NodeId                root_{};
+    size_t                nodes{};
+
+    [[nodiscard]] uint64_t field(Level const& l, size_t k) const {
+        return read(l.base + k * l.width) & mask(l.width);
+    }
+
+    /**
+     * Reads the 64 bits starting at a bit position without branching on
+     * whether they straddle two words.
+     */
+    [[nodiscard]] uint64_t read(uint64_t p) const {
+        auto const word = p >> 6U;
+        auto const shift = p & 63U;
+        return (bits[word] >> shift) | ((bits[word + 1] << 1U) << (63 - shift));
+    }
+
+    static uint64_t mask(unsigned width) {
+        return (width >= 64) ? ~uint64_t{0} : (uint64_t{1} << width) - 1;
+    }
+
+    [[nodiscard]] bool attr(size_t k) const {
+        return !attrs.empty() && ((attrs[k >> 6U] >> (k & 63U)) & 1U) != 0;
+    }
+
+    void setField(Level const& l, size_t k, uint64_t v) {
+        auto const p = l.base + k * l.width;
+        auto const word = p >> 6U;
+        auto const shift = p & 63U;
+        bits[word] |= v << shift;
+        if (shift + l.width > 64) {
+            bits[word + 1] |= v >> (64 - shift);
+        }
+    }
+
+   public:
+    FrozenDd() = default;
+
+    /**
+     * Freezes a diagram.
+     * @param dd the diagram.
+     * @exception std::runtime_error edges to a node disagree on its
+     * attribute.
+     */
+    template <typename T>
+    explicit FrozenDd(DdStructure<T> const& dd) : root_(dd.root()) {
+        auto const& table = *dd.getDiagram();
+        auto const  rows = table.numRows();
+
+        levels.resize(std::max<size_t>(rows, 1));
+        uint64_t totalBits = 0;
+        uint64_t first = 2;
+        for (auto i = 1UL; i < rows; ++i) {
+            auto&    l = levels[i];
+            uint64_t maxCol = 0;
+            for (auto j = 0UL; j < table[i].size(); ++j) {
+                for (int b = 0; b < 2; ++b) {
+                    maxCol = std::max<uint64_t>(maxCol,
+                                                table.child(i, j, b).col());
+                }
+            }
+            l.base = totalBits;
+            l.first = first;
+            l.size = static_cast<uint32_t>(table[i].size());
+            l.colBits = static_cast<uint8_t>(std::bit_width(maxCol));
+            l.width = static_cast<uint8_t>(l.colBits + std::bit_width(i));
+            totalBits += 2 * l.size * uint64_t{l.width};
+            first += l.size;
+        }
+        nodes = first - 2;
+
+        bits.assign((totalBits >> 6U) + 2, 0);
+        auto const mark = [&](NodeId f) {
+            if (f.getAttr()) {
+                if (attrs.empty()) {
+                    attrs.assign((nodes + 2 + 63) >> 6U, 0);
+                }
+                attrs[index(f) >> 6U] |= uint64_t{1} << (index(f) & 63U);
+            }
+        };
+        mark(root_);
+        for (auto i = 1UL; i < rows; ++i) {
+            auto const& l = levels[i];
+            for (auto j = 0UL; j < l.size; ++j) {
+                for (size_t b = 0; b < 2; ++b) {
+                    NodeId const f = table.child(i, j, b);
+                    setField(l, 2 * j + b,
+                             ((i - f.row()) << l.colBits) | f.col());
+                    mark(f);
+                }
+            }
+        }
+        for (auto i = 1UL; i < rows; ++i) {  // the unmarked edges must agree
+            for (auto j = 0UL; j < levels[i].size; ++j) {
+                for (size_t b = 0; b < 2; ++b) {
+                    NodeId const f = table.child(i, j, b);
+                    if (f.getAttr() != attr(index(f))) {
+                        throw std::runtime_error(
+                            "FrozenDd: edges to a node disagree on its "
+                            "attribute");
+                    }
+                }
+            }
+        }
+        bits.shrink_to_fit();
+    }
+
+    /**
+     * Gets the root node.
+     * @return the root node ID.
+     */
+    [[nodiscard]] NodeId root() const { return root_; }
+
+    /**
+     * Gets the number of levels, including the terminal level 0.
+     * @return the number of levels.
+     */
+    [[nodiscard]] size_t numRows() const { return levels.size(); }
+
+    /**
+     * Gets the number of nodes of a level.
+     * @param i the level.
+     * @return the number of nodes.
+     */
+    [[nodiscard]] size_t levelSize(size_t i) const { return levels[i].size; }
+
+    /**
+     * Gets the number of non-terminal nodes.
+     * @return the number of nodes.
+     */
+    [[nodiscard]] size_t size() const { return nodes; }
+
+    /**
+     * Gets the memory used by the representation.
+     * @return the number of bytes.
+     */
+    [[nodiscard]] size_t bytes() const {
+        return sizeof(*this) +
+               (bits.capacity() + attrs.capacity()) * sizeof(uint64_t) +
+               levels.capacity() * sizeof(Level);
+    }
+
+    /**
+     * Gets a child node ID.
+     * @param f parent node ID.
+     * @param b child branch.
+     * @return the @p b-child of @p f, with its attribute.
+     */
+    [[nodiscard]] NodeId child(NodeId f, size_t b) const {
+        auto const& l = levels[f.row()];
+        auto const  v = field(l, 2 * f.col() + b);
+        auto const  row = f.row() - (v >> l.colBits);
+        auto const  col = v & mask(l.colBits);
+        return {row, col, attr(levels[row].first + col)};
+    }
+
+    /**
+     * Gets the dense index of a node: 0 and 1 for the terminals, then the
+     * nodes level by level from the bottom.
+     * @param f node ID.
+     * @return the index.
+     */
+    [[nodiscard]] size_t index(NodeId f) const {
+        return levels[f.row()].first + f.col();
+    }
+
+    /**
+     * Evaluates the diagram bottom-up, ignoring edge attributes.
+     * @param terminal function giving the value of terminal @p b.
+     * @param node function giving the value of a node at a level from the
+     * values of its 0- and 1-children.
+     * @return the value of the root.
+     */
+    template <typename R, typename TERMINAL, typename NODE>
+    R evaluate(TERMINAL&& terminal, NODE&& node) const {
+        std::vector<R> value{terminal(false), terminal(true)};
+        value.resize(size() + 2);
+        for (auto i = 1UL; i < levels.size(); ++i) {
+            auto const& l = levels[i];
+            auto const  colMask = mask(l.colBits);
+            auto const  fieldMask = mask(l.width);
+            auto        p = l.base;
+            auto const  target = [&] {
+                auto const v = read(p) & fieldMask;
+                auto const d = v >> l.colBits;
+                p += l.width;
+                return levels[i - d].first + (v & colMask);
+            };
+            for (auto j = 0UL; j < l.size; ++j) {
+                auto const f0 = target();
+                auto const f1 = target();
+                value[l.first + j] =
+                    node(static_cast<int>(i), value[f0], value[f1]);
+            }
+        }
+        return value[index(root_)];
+    }
+};
+
+#endif  // NODE_BDD_FROZEN_HPP
@@ -0,0 +1,175 @@
+#ifndef NODE_BDD_GENERATING_FUNCTION_HPP
+#define NODE_BDD_GENERATING_FUNCTION_HPP
+
+#include <algorithm>             // for max, min
+#include <cstddef>               // for size_t
+#include <cstdint>               // for uint64_t
+#include <stdexcept>             // for runtime_error
+#include <utility>               // for move
+#include <vector>                // for vector
+#include "NodeBddProfile.hpp"    // for DdProfile, DdPhase
+#include "NodeBddStructure.hpp"  // for DdStructure
+#include "NodeId.hpp"            // for NodeId
+#include "util/Executor.hpp"     // for Executor, forChunks, maxChunks
+
+/**
+ * Coefficient counting modulo a prime, for counts beyond the widest
+ * integer type.
+ * @tparam P the modulus, below 2^63 so that a sum of two residues fits.
+ */
+template <uint64_t P>
+struct ModularCount {
+    static_assert(0 < P && P < (uint64_t(1) << 63U), "modulus too large");
+
+    uint64_t value{};
+
+    ModularCount() = default;
+    ModularCount(uint64_t v) : value(v % P) {}
+
+    friend ModularCount operator+(ModularCount a, ModularCount b) {
+        ModularCount c;
+        c.value = a.value + b.value;
+        c.value -= (c.value >= P) ? P : 0;
+        return c;
+    }
+
+    bool operator==(ModularCount const&) const = default;
+};
+
+/**
+ * Computes the generating function of a ZDD: the number of its sets of
+ * every total weight, where item i weighs weight[i], 1 by default so that
+ * the weight of a set is its size.
+ * Every node gets a polynomial truncated after degree cap, whose last
+ * coefficient collects the sets of weight cap or more, so that the
+ * coefficients always add up to the number of sets. The polynomials of a
+ * level are stored densely, cap + 1 coefficients per node, and a node is
+ * the sum of its 0-child and its 1-child shifted by the weight of its
+ * item, which are loops over contiguous arrays that compilers vectorize.
+ * The levels are evaluated bottom-up in one pass, and the polynomials of a
+ * level are released as soon as no level above refers to it.
+ *
+ * The coefficient type C needs a + operator, value-initialization to 0
+ * and a constructor from 1. uint64_t is exact up to 2^64 sets; use
+ * unsigned __int128, ModularCount or double for larger families.
+ * @tparam T the node type.
+ * @tparam C the coefficient type.
+ */
+template <typename T, typename C = uint64_t>
+class DdGeneratingFunction {
+    size_t const        cap;
+    std::vector<size_t> weight;
+    Executor*           executor;
+    size_t              grain;  ///< Least number of nodes per chunk.
+
+   public:
+    /**
+     * Constructor counting the sets by size.
+     * @param _cap the last bucket, collecting sizes _cap and above.
+     * @param _executor the executor, or nullptr to run on the calling
+     * thread.
+     * @param _grain the least number of nodes of a level per chunk.
+     */
+    explicit DdGeneratingFunction(size_t    _cap,
+                                  Executor* _executor = nullptr,
+                                  size_t    _grain = 1024)
+        : DdGeneratingFunction(_cap, {}, _executor, _grain) {}
+
+    /**
+     * Constructor counting the sets by weight.
+     * @param _cap the last bucket, collecting weights _cap and above.
+     * @param _weight the weight of every item, indexed by level; empty for
+     * weights of 1.
+     * @param _executor the executor, or nullptr to run on the calling
+     * thread.
+     * @param _grain the least number of nodes of a level per chunk.
+     */
+    DdGeneratingFunction(size_t              _cap,
+                         std::vector<size_t> _weight,
+                         Executor*           _executor = nullptr,
+                         size_t              _grain = 1024)
+        : cap(_cap),
+          weight(std::move(_weight)),
+          executor(_executor),
+          grain(std::max<size_t>(_grain, 1)) {}
+
+    /**
+     * Computes the generating function of a diagram.
+     * @param dd the diagram.
+     * @return cap + 1 coefficients; coefficient k counts the sets of weight
+     * k, and coefficient cap those of weight cap or more.
+     * @exception std::runtime_error the weights miss a level of the diagram.
+     */
+    std::vector<C> evaluate(DdStructure<T> const& dd) const {
+        auto const& table = *dd.getDiagram();
+        auto const  root = dd.root();
+        auto const  n = root.row();
+        auto const  width = cap + 1;
+
+        std::vector<C> zero(width);
+        std::vector<C> one{C(1)};
+        one.resize(width);
+        if (n == 0) {
+            return (root == 1) ? one : zero;
+        }
+        if (!weight.empty() && weight.size() <= n) {
+            throw std::runtime_error(
+                "DdGeneratingFunction: no weight for some levels");
+        }
+
+        std::vector<std::vector<C>> poly(n + 1);
+        auto const coefficients = [&](NodeId f) -> C const* {
+            if (f.row() == 0) {
+                return (f == 1) ? one.data() : zero.data();
+            }
+            return poly[f.row()].data() + f.col() * width;
+        };
+
+        DdProfile::Scope const profile(DdPhase::Evaluate, n);
+        for (auto i = 1UL; i <= n; ++i) {
+            auto const m = table[i].size();
+            auto const w = weight.empty() ? 1UL : weight[i];
+            poly[i].assign(m * width, C());
+            forChunks(executor, m, grain, maxChunks(executor),
+                      [&](size_t begin, size_t end, size_t) {
+                          for (auto j = begin; j < end; ++j) {
+                              combine(poly[i].data() + j * width,
+                                      coefficients(table.child(i, j, 0)),
+                                      coefficients(table.child(i, j, 1)), w);
+                          }
+                      });
+            for (auto t : table.lowerLevels(i)) {
+                std::vector<C>().swap(poly[t]);
+            }
+        }
+
+        auto const* p = coefficients(root);
+        return std::vector<C>(p, p + width);
+    }
+
+   private:
+    /**
+     * Sets out = lo + x^w hi, truncated after degree cap, where the
+     * coefficients of degree cap and above are added up in out[cap].
+     * @param out the polynomial of the node.
+     * @param lo the polynomial of the 0-child.
+     * @param hi the polynomial of the 1-child.
+     * @param w the weight of the item.
+     */
+    void combine(C* out, C const* lo, C const* hi, size_t w) const {
+        auto const s = std::min(w, cap);
+        for (auto k = 0UL; k < s; ++k) {
+            out[k] = lo[k];
+        }
+        for (auto k = s; k < cap; ++k) {
+            out[k] = lo[k] + hi[k - s];
+        }
+        C tail = lo[cap];
+        for (auto k = cap - s; k <= cap; ++k) {
+            tail = tail + hi[k];
+        }
+        out[cap] = tail;
+    }
+};
+
+#endif  // NODE_BDD_GENERATING_FUNCTION_HPP
@@ -0,0 +1,480 @@
+#ifndef NODE_BDD_PARTITIONED_BUILDER_HPP
+#define NODE_BDD_PARTITIONED_BUILDER_HPP
+
+#include <sys/wait.h>              // for waitpid, WIFEXITED, WEXITSTATUS
+#include <unistd.h>                // for fork, _exit
+#include <cstddef>                 // for size_t
+#include <cstdint>                 // for uint64_t
+#include <cstdio>                  // for fflush
+#include <cstring>                 // for memcpy
+#include <stdexcept>               // for runtime_error
+#include <string>                  // for to_string
+#include <unordered_map>           // for unordered_map
+#include <utility>                 // for move
+#include <vector>                  // for vector
+#include "NodeBddSpec.hpp"         // for DdSpecBase
+#include "NodeBddStructure.hpp"    // for DdStructure
+#include "NodeBddTable.hpp"        // for TableHandler
+#include "NodeId.hpp"              // for NodeId
+#include "util/HashPolicy.hpp"     // for Mix64Hash
+#include "util/Transport.hpp"      // for Transport, UnixSocketMesh
+
+/**
+ * One rank's part of a diagram built by DdPartitionedBuilder.
+ * The nodes of every row are numbered globally in rank order: a rank owns
+ * the columns [first[i], first[i] + size(i)) of row i, so that a node ID
+ * means the same node in every shard and the shards can be kept apart or
+ * assembled into one diagram.
+ */
+struct DdShard {
+    NodeId              root{};    ///< Root of the whole diagram.
+    size_t              arity{2};  ///< Children per node.
+    std::vector<size_t> rowSize;   ///< Nodes of every row in all shards.
+    std::vector<size_t> first;     ///< Global column of the first own node.
+    std::vector<std::vector<NodeId>> children;  ///< Own nodes' children.
+
+    [[nodiscard]] size_t numRows() const { return rowSize.size(); }
+
+    /**
+     * Gets the number of nodes of a row in this shard.
+     * @param i the row.
+     * @return the number of nodes.
+     */
+    [[nodiscard]] size_t size(size_t i) const {
+        return children[i].size() / arity;
+    }
+
+    /**
+     * Gets a child of a node of this shard.
+     * @param f the node, with a column owned by this shard.
+     * @param b the branch.
+     * @return the child.
+     */
+    [[nodiscard]] NodeId child(NodeId f, size_t b) const {
+        return children[f.row()][(f.col() - first[f.row()]) * arity + b];
+    }
+
+    /**
+     * Encodes the shard as a message.
+     * @return the message.
+     */
+    [[nodiscard]] Transport::Message serialize() const {
+        std::vector<uint64_t> w{root.code(), arity, numRows()};
+        for (auto i = 0UL; i < numRows(); ++i) {
+            w.push_back(rowSize[i]);
+            w.push_back(first[i]);
+            w.push_back(children[i].size());
+            for (auto const& f : children[i]) {
+                w.push_back(f.code());
+            }
+        }
+        Transport::Message m(w.size() * sizeof(uint64_t));
+        std::memcpy(m.data(), w.data(), m.size());
+        return m;
+    }
+
+    /**
+     * Decodes a shard.
+     * @param m a message made by serialize().
+     * @return the shard.
+     */
+    static DdShard deserialize(Transport::Message const& m) {
+        std::vector<uint64_t> w(m.size() / sizeof(uint64_t));
+        std::memcpy(w.data(), m.data(), w.size() * sizeof(uint64_t));
+        DdShard s;
+        size_t  k = 0;
+        s.root = NodeId(w[k++]);
+        s.arity = w[k++];
+        auto const rows = w[k++];
+        s.rowSize.resize(rows);
+        s.first.resize(rows);
+        s.children.resize(rows);
+        for (auto i = 0UL; i < rows; ++i) {
+            s.rowSize[i] = w[k++];
+            s.first[i] = w[k++];
+            s.children[i].resize(w[k++]);
+            for (auto& f : s.children[i]) {
+                f = NodeId(w[k++]);
+            }
+        }
+        return s;
+    }
+};
+
+/**
+ * Breadth-first DD builder partitioned across the ranks of a Transport.
+ * The states scheduled at every level are assigned to ranks by a hash of
+ * their canonical form, so that equivalent states meet on one rank, which
+ * owns their unique table and their output rows. Every rank calls build()
+ * and the ranks proceed level by level; at each level they exchange the
+ * number of their new nodes, to number them globally, the node IDs
+ * of the edges scheduled by other ranks, and the child states of their
+ * nodes. No rank holds more than its share of states and nodes.
+ *
+ * The result has the structure of a DdBuilder result without sweeping:
+ * it is not reduced. merge_states applies between states of one level as
+ * usual but not to 1-terminal candidates. The states travel as raw bytes,
+ * so the spec states must be trivially copyable, and hash_code must agree
+ * across processes, which holds for processes forked from one program.
+ * @tparam S the spec type.
+ */
+template <typename S>
+class DdPartitionedBuilder {
+    using Spec = S;
+    static size_t const AR = Spec::ARITY;
+
+    /* Record of a scheduled state
+     * ┌─────────┬─────────┬──────────────┬──────────┬─────
+     * │ parent  │ parent  │ parent rank  │ state[0] │ ...
+     * │   row   │   col   │  << 32 | b   │          │
+     * └─────────┴─────────┴──────────────┴──────────┴─────
+     * The root has parent rank ROOT. In transit a record is preceded by
+     * its level.
+     */
+    static size_t const   HEADER_WORDS = 3;
+    static uint64_t const ROOT = 0xffffffffULL;
+
+    struct StateHash {
+        Spec const& spec;
+        int         level;
+
+        size_t operator()(uint64_t const* p) const {
+            return spec.hash_code(p, level);
+        }
+
+        bool operator()(uint64_t const* p, uint64_t const* q) const {
+            return spec.equal_to(p, q, level);
+        }
+    };
+
+    Spec         spec;
+    Transport&   transport;
+    size_t const stateWords;
+    size_t const recordWords;
+    uint64_t     ranks;
+    uint64_t     rank;
+
+    std::vector<std::vector<uint64_t>> pending;
+
+    void receiveStates(std::vector<Transport::Message> const& in) {
+        std::vector<uint64_t> w;
+        for (auto const& m : in) {
+            if (m.empty()) {
+                continue;
+            }
+            w.resize(m.size() / sizeof(uint64_t));
+            std::memcpy(w.data(), m.data(), m.size());
+            for (auto k = 0UL; k < w.size(); k += recordWords + 1) {
+                auto& p = pending[w[k]];
+                p.insert(p.end(), w.begin() + static_cast<long>(k) + 1,
+                         w.begin() + static_cast<long>(k + 1 + recordWords));
+            }
+        }
+    }
+
+    static std::vector<Transport::Message> toMessages(
+        std::vector<std::vector<uint64_t>> const& words) {
+        std::vector<Transport::Message> out(words.size());
+        for (auto r = 0UL; r < words.size(); ++r) {
+            out[r].resize(words[r].size() * sizeof(uint64_t));
+            if (!out[r].empty()) {
+                std::memcpy(out[r].data(), words[r].data(), out[r].size());
+            }
+        }
+        return out;
+    }
+
+   public:
+    /**
+     * Constructor.
+     * @param _spec DD spec.
+     * @param _transport the transport of this rank.
+     */
+    DdPartitionedBuilder(Spec const& _spec, Transport& _transport)
+        : spec(_spec),
+          transport(_transport),
+          stateWords((_spec.datasize() + sizeof(uint64_t) - 1) /
+                     sizeof(uint64_t)),
+          recordWords(HEADER_WORDS + stateWords),
+          ranks(static_cast<uint64_t>(_transport.size())),
+          rank(static_cast<uint64_t>(_transport.rank())) {}
+
+    /**
+     * Builds this rank's shard; a collective call of all the ranks.
+     * @return the shard.
+     * @exception std::runtime_error the transport failed.
+     */
+    DdShard build() {
+        DdShard shard;
+        shard.arity = AR;
+
+        std::vector<uint64_t> tmp(stateWords + 1);
+        void* const           s = tmp.data();
+        int const             n = spec.get_root(s);
+        if (n <= 0) {
+            spec.destruct(s);
+            shard.root = n ? NodeId(1) : NodeId(0);
+            shard.rowSize.assign(1, 2);
+            shard.first.assign(1, 0);
+            shard.children.resize(1);
+            return shard;
+        }
+
+        auto const rows = static_cast<size_t>(n) + 1;
+        shard.root = NodeId(static_cast<uint64_t>(n), 0);
+        shard.rowSize.assign(rows, 0);
+        shard.first.assign(rows, 0);
+        shard.children.resize(rows);
+        shard.rowSize[0] = 2;
+        pending.assign(rows, {});
+        if (rank == 0) {
+            spec.canonicalize_state(s, n);
+            auto& p = pending[rows - 1];
+            p.insert(p.end(), {0, 0, ROOT << 32U});
+            p.insert(p.end(), tmp.begin(), tmp.begin() + stateWords);
+        }
+        spec.destruct(s);
+
+        for (auto i = rows - 1; i >= 1; --i) {
+            auto&      records = pending[i];
+            auto const count = records.size() / recordWords;
+            auto const state = [&](size_t k) {
+                return records.data() + k * recordWords + HEADER_WORDS;
+            };
+
+            /* deduplication */
+            StateHash const hasher{spec, static_cast<int>(i)};
+            std::unordered_map<uint64_t const*, size_t, StateHash, StateHash>
+                                   uniq(count * 2 + 1, hasher, hasher);
+            std::vector<size_t>    column(count);
+            std::vector<uint64_t*> nodes;
+            std::vector<char>      alive;
+            for (auto k = 0UL; k < count; ++k) {
+                auto* p = state(k);
+                auto  aux = uniq.emplace(p, nodes.size());
+                if (aux.second) {
+                    column[k] = nodes.size();
+                    nodes.push_back(p);
+                    alive.push_back(1);
+                    continue;
+                }
+                auto& e = aux.first->second;
+                switch (spec.merge_states(nodes[e], p)) {
+                    case 1:
+                        alive[e] = 0;  // forward to 0-terminal
+                        e = column[k] = nodes.size();
+                        nodes.push_back(p);
+                        alive.push_back(1);
+                        break;
+                    case 2:
+                        column[k] = SIZE_MAX;
+                        break;
+                    default:
+                        column[k] = e;
+                        break;
+                }
+            }
+            auto const m = nodes.size();
+
+            /* global numbering */
+            Transport::Message mine(sizeof(uint64_t));
+            std::memcpy(mine.data(), &m, sizeof(uint64_t));
+            auto const counts = transport.exchange(
+                std::vector<Transport::Message>(ranks, mine));
+            for (auto r = 0UL; r < ranks; ++r) {
+                uint64_t c = 0;
+                std::memcpy(&c, counts[r].data(), sizeof(c));
+                shard.first[i] += (r < rank) ? c : 0;
+                shard.rowSize[i] += c;
+            }
+
+            /* node IDs of the edges to this level */
+            std::vector<std::vector<uint64_t>> replies(ranks);
+            for (auto k = 0UL; k < count; ++k) {
+                auto const* h = records.data() + k * recordWords;
+                if ((h[2] >> 32U) == ROOT) {
+                    continue;
+                }
+                NodeId const f = (column[k] == SIZE_MAX)
+                                     ? NodeId(0)
+                                     : NodeId(i, shard.first[i] + column[k]);
+                replies[h[2] >> 32U].insert(replies[h[2] >> 32U].end(),
+                                            {h[0], h[1], h[2], f.code()});
+            }
+            for (auto const& msg : transport.exchange(toMessages(replies))) {
+                if (msg.empty()) {
+                    continue;
+                }
+                std::vector<uint64_t> w(msg.size() / sizeof(uint64_t));
+                std::memcpy(w.data(), msg.data(), msg.size());
+                for (auto k = 0UL; k < w.size(); k += 4) {
+                    auto const b = w[k + 2] & 0xffffffffULL;
+                    shard.children[w[k]]
+                                  [(w[k + 1] - shard.first[w[k]]) * AR + b] =
+                        NodeId(w[k + 3]);
+                }
+            }
+
+            /* expansion */
+            auto& row = shard.children[i];
+            row.assign(m * AR, NodeId(0));
+            std::vector<std::vector<uint64_t>> states(ranks);
+            for (auto j = 0UL; j < m; ++j) {
+                if (alive[j] == 0) {  // its row entry keeps null children
+                    continue;
+                }
+                for (auto b = 0UL; b < AR; ++b) {
+                    spec.get_copy(s, nodes[j]);
+                    int const ii = spec.get_child(s, static_cast<int>(i),
+                                                  static_cast<int>(b));
+                    if (ii < 0) {
+                        row[j * AR + b] = NodeId(1);
+                    } else if (ii > 0) {
+                        spec.canonicalize_state(s, ii);
+                        auto const r =
+                            Mix64Hash::mix(spec.hash_code(s, ii)) % ranks;
+                        states[r].insert(states[r].end(),
+                                         {static_cast<uint64_t>(ii), i,
+                                          shard.first[i] + j,
+                                          (rank << 32U) | b});
+                        states[r].insert(states[r].end(), tmp.begin(),
+                                         tmp.begin() + stateWords);
+                    }
+                    spec.destruct(s);
+                }
+            }
+            for (auto k = 0UL; k < count; ++k) {
+                spec.destruct(state(k));
+            }
+            std::vector<uint64_t>().swap(records);
+            receiveStates(transport.exchange(toMessages(states)));
+        }
+        return shard;
+    }
+};
+
+/**
+ * Assembles shards into one diagram.
+ * @tparam T the node type.
+ * @param shards the shards of all the ranks.
+ * @return the diagram.
+ */
+template <typename T>
+DdStructure<T> assembleShards(std::vector<DdShard> const& shards) {
+    auto const&     any = shards.front();
+    TableHandler<T> table(any.numRows());
+    for (auto i = 1UL; i < any.numRows(); ++i) {
+        (*table).initRow(i, any.rowSize[i]);
+        for (auto const& s : shards) {
+            for (auto j = 0UL; j < s.size(i); ++j) {
+                for (auto b = 0UL; b < s.arity; ++b) {
+                    (*table)[i][s.first[i] + j][b] =
+                        s.children[i][j * s.arity + b];
+                }
+            }
+        }
+    }
+    return DdStructure<T>(std::move(table), any.root);
+}
+
+/**
+ * Collects the shards of all the ranks on rank 0 and assembles them there;
+ * a collective call of all the ranks.
+ * @tparam T the node type.
+ * @param shard the shard of this rank.
+ * @param transport the transport of this rank.
+ * @return the diagram on rank 0, an empty diagram on the other ranks.
+ */
+template <typename T>
+DdStructure<T> gatherShards(DdShard const& shard, Transport& transport) {
+    std::vector<Transport::Message> out(transport.size());
+    out[0] = shard.serialize();
+    auto const in = transport.exchange(std::move(out));
+    if (transport.rank() != 0) {
+        return DdStructure<T>();
+    }
+    std::vector<DdShard> shards;
+    for (auto const& m : in) {
+        shards.push_back(DdShard::deserialize(m));
+    }
+    return assembleShards<T>(shards);
+}
+
+/**
+ * Builds a diagram with worker processes on this machine.
+ * The calling process forks @p processes - 1 workers connected by a
+ * UnixSocketMesh, builds as rank 0 and assembles the diagram; the workers
+ * exit when they have sent their shards. Fork while no other thread is
+ * running.
+ * @tparam T the node type.
+ * @param spec DD spec.
+ * @param processes the number of ranks, including the calling process.
+ * @return the diagram, not reduced.
+ * @exception std::runtime_error a worker cannot be started or fails.
+ */
+template <typename T, typename SPEC>
+DdStructure<T> buildPartitioned(DdSpecBase<SPEC> const& spec, int processes) {
+    if (processes <= 1) {
+        LoopbackTransport loopback;
+        return gatherShards<T>(
+            DdPartitionedBuilder<SPEC>(spec.entity(), loopback).build(),
+            loopback);
+    }
+
+    UnixSocketMesh     mesh(processes);
+    std::vector<pid_t> workers;
+    std::fflush(nullptr);
+    for (int r = 1; r < processes; ++r) {
+        auto const pid = ::fork();
+        if (pid == 0) {
+            int status = 0;
+            try {
+                auto transport = mesh.connect(r);
+                mesh.close();
+                gatherShards<T>(
+                    DdPartitionedBuilder<SPEC>(spec.entity(), transport)
+                        .build(),
+                    transport);
+            } catch (...) {
+                status = 1;
+            }
+            ::_exit(status);
+        }
+        if (pid < 0) {
+            mesh.close();
+            for (auto w : workers) {
+                ::waitpid(w, nullptr, 0);
+            }
+            throw std::runtime_error("buildPartitioned: fork failed");
+        }
+        workers.push_back(pid);
+    }
+
+    auto const wait = [&]() {
+        bool ok = true;
+        for (auto w : workers) {
+            int status = 0;
+            ok = ::waitpid(w, &status, 0) == w && WIFEXITED(status) &&
+                 WEXITSTATUS(status) == 0 && ok;
+        }
+        return ok;
+    };
+
+    DdStructure<T> dd;
+    try {
+        auto transport = mesh.connect(0);
+        mesh.close();
+        dd = gatherShards<T>(
+            DdPartitionedBuilder<SPEC>(spec.entity(), transport).build(),
+            transport);
+    } catch (...) {
+        wait();  // the workers fail once the sockets are closed
+        throw;
+    }
+    if (!wait()) {
+        throw std::runtime_error("buildPartitioned: a worker failed");
+    }
+    return dd;
+}
+
+#endif  // NODE_BDD_PARTITIONED_BUILDER_HPP
@@ -0,0 +1,238 @@
+#ifndef NODE_BDD_PROFILE_HPP
+#define NODE_BDD_PROFILE_HPP
+
+#include <array>                  // for array
+#include <cstddef>                // for size_t
+#include <cstdint>                // for uint64_t
+#include <iomanip>                // for setw
+#include <ostream>                // for ostream
+#include <stdexcept>              // for runtime_error
+#include <string>                 // for to_string
+#include <thread>                 // for thread::id, this_thread::get_id
+#include <vector>                 // for vector
+#include "util/PerfCounters.hpp"  // for PerfCounters, PerfSample, PerfEvent
+
+/**
+ * Phases of the pipeline recorded by DdProfile.
+ * Construct is DdBuilder::construct and constructPipelined per level,
+ * Reduce is DdReducer::reduce per level, Sweep is DdSweeper::update per
+ * level and Evaluate is one evaluation sweep of DdStructure, recorded at
+ * the level of the root.
+ */
+enum class DdPhase : size_t { Construct, Reduce, Sweep, Evaluate };
+
+inline constexpr size_t DD_PHASE_COUNT = 4;
+
+inline constexpr std::array<char const*, DD_PHASE_COUNT> DD_PHASE_NAMES{
+    "construct", "reduce", "sweep", "evaluate"};
+
+/**
+ * Performance counters per phase and level of the diagram operations run
+ * on one thread.
+ * The counters are opened for the thread that creates the profile, which
+ * is the only thread it can be activated on; a profile records only while
+ * it is active, and elsewhere the instrumented phases cost a thread-local
+ * load. Phases
+ * nest: the sweeps run at the end of a level are also counted in the
+ * construction of that level. Work done on other threads, such as the
+ * deduplication thread of constructPipelined, is not counted. Events the
+ * system does not provide read as 0 and are reported as unavailable.
+ *
+ * @code
+ * DdProfile profile;
+ * {
+ *     DdProfile::Activation on(profile);
+ *     DdStructure<Node> dd(spec);
+ *     dd.reduceZdd();
+ * }
+ * profile.print(std::cout);
+ * @endcode
+ */
+class DdProfile {
+    PerfCounters                                        counters;
+    std::thread::id const                               owner;
+    std::array<std::vector<PerfSample>, DD_PHASE_COUNT> samples;
+
+    static DdProfile*& current() {
+        thread_local DdProfile* profile = nullptr;
+        return profile;
+    }
+
+    void record(DdPhase                                       phase,
+                size_t                                        level,
+                std::array<uint64_t, PERF_EVENT_COUNT> const& start) {
+        auto const end = counters.read();
+        auto&      levels = samples[static_cast<size_t>(phase)];
+        if (levels.size() <= level) {
+            levels.resize(level + 1);
+        }
+        auto& s = levels[level];
+        for (auto k = 0UL; k < PERF_EVENT_COUNT; ++k) {
+            // scaled counts of multiplexed events may go backwards
+            s.value[k] += (end[k] > start[k]) ? end[k] - start[k] : 0;
+        }
+        ++s.calls;
+    }
+
+   public:
+    /**
+     * Constructor opening the counters for the current thread.
+     */
+    DdProfile() : owner(std::this_thread::get_id()) {}
+
+    /**
+     * Makes a profile record the phases run on the current thread while in
+     * scope, restoring the previously active profile afterwards.
+     */
+    class Activation {
+        DdProfile* previous;
+
+       public:
+        /**
+         * Constructor.
+         * @param profile the profile.
+         * @exception std::runtime_error the profile was created on another
+         * thread.
+         */
+        explicit Activation(DdProfile& profile) : previous(current()) {
+            if (profile.owner != std::this_thread::get_id()) {
+                throw std::runtime_error(
+                    "DdProfile: activated on another thread");
+            }
+            current() = &profile;
+        }
+
+        Activation(Activation const&) = delete;
+        Activation& operator=(Activation const&) = delete;
+
+        ~Activation() { current() = previous; }
+    };
+
+    /**
+     * Records a phase at a level into the active profile, if any.
+     */
+    class Scope {
+        DdProfile*                             profile;
+        DdPhase                                phase;
+        size_t                                 level;
+        std::array<uint64_t, PERF_EVENT_COUNT> start{};
+
+       public:
+        Scope(DdPhase _phase, size_t _level)
+            : profile(current()),
+              phase(_phase),
+              level(_level) {
+            if (profile != nullptr) {
+                start = profile->counters.read();
+            }
+        }
+
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+        ~Scope() {
+            if (profile != nullptr) {
+                profile->record(phase, level, start);
+            }
+        }
+    };
+
+    /**
+     * Gets the profile active on the current thread.
+     * @return the profile, or nullptr.
+     */
+    static DdProfile* active() { return current(); }
+
+    /**
+     * Checks whether an event is counted.
+     * @param e the event.
+     * @return true if the system provides the event.
+     */
+    [[nodiscard]] bool available(PerfEvent e) const {
+        return counters.available(e);
+    }
+
+    /**
+     * Gets the number of levels recorded for a phase.
+     * @param phase the phase.
+     * @return one more than the highest level recorded.
+     */
+    [[nodiscard]] size_t numLevels(DdPhase phase) const {
+        return samples[static_cast<size_t>(phase)].size();
+    }
+
+    /**
+     * Gets the counts of a phase at a level.
+     * @param phase the phase.
+     * @param level the level.
+     * @return the counts, empty if the level was not recorded.
+     */
+    [[nodiscard]] PerfSample at(DdPhase phase, size_t level) const {
+        auto const& levels = samples[static_cast<size_t>(phase)];
+        return (level < levels.size()) ? levels[level] : PerfSample{};
+    }
+
+    /**
+     * Gets the counts of a phase summed over the levels.
+     * @param phase the phase.
+     * @return the counts.
+     */
+    [[nodiscard]] PerfSample total(DdPhase phase) const {
+        PerfSample sum;
+        for (auto const& s : samples[static_cast<size_t>(phase)]) {
+            sum += s;
+        }
+        return sum;
+    }
+
+    /**
+     * Discards the recorded counts.
+     */
+    void clear() {
+        for (auto& levels : samples) {
+            levels.clear();
+        }
+    }
+
+    /**
+     * Prints the totals of every phase, one row per phase; unavailable
+     * events are printed as "n/a".
+     * @param os the output stream.
+     * @param perLevel also print a row for every recorded level.
+     */
+    void print(std::ostream& os, bool perLevel = false) const {
+        auto const row = [&](char const* name, PerfSample const& s) {
+            os << std::setw(12) << name << std::setw(8) << s.calls;
+            for (auto k = 0UL; k < PERF_EVENT_COUNT; ++k) {
+                os << std::setw(15);
+                if (available(static_cast<PerfEvent>(k))) {
+                    os << s.value[k];
+                } else {
+                    os << "n/a";
+                }
+            }
+            os << "\n";
+        };
+
+        os << std::setw(12) << "phase" << std::setw(8) << "calls";
+        for (auto const* name : PERF_EVENT_NAMES) {
+            os << std::setw(15) << name;
+        }
+        os << "\n";
+        for (auto p = 0UL; p < DD_PHASE_COUNT; ++p) {
+            auto const phase = static_cast<DdPhase>(p);
+            row(DD_PHASE_NAMES[p], total(phase));
+            if (!perLevel) {
+                continue;
+            }
+            for (auto i = numLevels(phase); i-- > 0;) {
+                if (samples[p][i].calls > 0) {
+                    auto const label = "  " + std::to_string(i);
+                    row(label.c_str(), samples[p][i]);
+                }
+            }
+        }
+    }
+};
+
+#endif  // NODE_BDD_PROFILE_HPP
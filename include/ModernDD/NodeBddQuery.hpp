@@ -0,0 +1,234 @@
+#ifndef NODE_BDD_QUERY_HPP
+#define NODE_BDD_QUERY_HPP
+
+#include <algorithm>             // for max
+#include <cstddef>               // for size_t
+#include <cstdint>               // for uint64_t
+#include <stdexcept>             // for runtime_error
+#include <vector>                // for vector
+#include "NodeBddStructure.hpp"  // for DdStructure
+#include "NodeId.hpp"            // for NodeId
+
+/**
+ * Boolean inputs of a batch of queries stored level by level.
+ * Bit q of word(level, block) is the value of the variable at that level
+ * in query 64 * block + q.
+ */
+class DdBitSlices {
+    size_t                numLevels;
+    size_t                numQueries;
+    size_t                numBlocks;
+    std::vector<uint64_t> words;
+
+   public:
+    /**
+     * Constructor; every value is 0.
+     * @param topLevel the highest level with a variable.
+     * @param queries the number of queries.
+     */
+    DdBitSlices(size_t topLevel, size_t queries)
+        : numLevels(topLevel + 1),
+          numQueries(queries),
+          numBlocks((queries + 63) / 64),
+          words(numLevels * numBlocks) {}
+
+    /**
+     * Slices a batch of item sets; item i is the variable at level i.
+     * @param sets the item sets.
+     * @param topLevel the highest level with a variable.
+     * @return the slices.
+     */
+    static DdBitSlices fromSets(std::vector<std::vector<int>> const& sets,
+                                size_t                               topLevel) {
+        DdBitSlices x(topLevel, sets.size());
+        for (auto q = 0UL; q < sets.size(); ++q) {
+            for (int i : sets[q]) {
+                if (i < 1 || static_cast<size_t>(i) > topLevel) {
+                    throw std::runtime_error(
+                        "DdBitSlices: item out of range");
+                }
+                x.set(q, i);
+            }
+        }
+        return x;
+    }
+
+    [[nodiscard]] size_t topLevel() const { return numLevels - 1; }
+
+    [[nodiscard]] size_t size() const { return numQueries; }
+
+    [[nodiscard]] size_t blocks() const { return numBlocks; }
+
+    /**
+     * Sets a value.
+     * @param query the query.
+     * @param level the level of the variable.
+     * @param value the value.
+     */
+    void set(size_t query, size_t level, bool value = true) {
+        auto&      w = words[level * numBlocks + query / 64];
+        auto const bit = uint64_t{1} << (query % 64);
+        w = value ? (w | bit) : (w & ~bit);
+    }
+
+    [[nodiscard]] bool get(size_t query, size_t level) const {
+        return ((word(level, query / 64) >> (query % 64)) & 1U) != 0;
+    }
+
+    /**
+     * Gets the values of a variable in 64 queries.
+     * @param level the level of the variable; levels above topLevel() are 0.
+     * @param block the block of queries.
+     * @return the values.
+     */
+    [[nodiscard]] uint64_t word(size_t level, size_t block) const {
+        return (level < numLevels) ? words[level * numBlocks + block] : 0;
+    }
+
+    /**
+     * Gets the queries of a block.
+     * @param block the block of queries.
+     * @return the mask of the queries present in the block.
+     */
+    [[nodiscard]] uint64_t valid(size_t block) const {
+        auto const n = numQueries - 64 * block;
+        return (n >= 64) ? ~uint64_t{0} : (uint64_t{1} << n) - 1;
+    }
+};
+
+/**
+ * Answers batches of queries on a diagram level by level.
+ * Queries are processed in blocks of 64. Every node reached by a block
+ * carries the mask of the queries currently at that node, so that a node is
+ * read once per block however many queries pass through it, and a level is
+ * split between the 0- and 1-children with two word operations per node.
+ * Only the nodes reached by the block are visited.
+ * @tparam T the node type.
+ */
+template <typename T>
+class DdBatchQuery {
+    DdStructure<T> const&            dd;
+    std::vector<size_t>              offset;  ///< First index of each row.
+    std::vector<uint64_t>            mask;    ///< Queries at each node.
+    std::vector<std::vector<size_t>> active;  ///< Columns reached per row.
+    uint64_t                         terminal[2]{};
+    size_t                           pending{};  ///< Nodes reached.
+
+    void put(NodeId f, uint64_t m) {
+        if (m == 0) {
+            return;
+        }
+        if (f.row() == 0) {
+            terminal[f.col()] |= m;
+            return;
+        }
+        auto& w = mask[offset[f.row()] + f.col()];
+        if (w == 0) {
+            active[f.row()].push_back(f.col());
+            ++pending;
+        }
+        w |= m;
+    }
+
+    /**
+     * Runs one block.
+     * @param x the inputs.
+     * @param block the block of queries.
+     * @param zdd reject queries with a variable set at a skipped level.
+     * @return the mask of the queries reaching the 1-terminal.
+     */
+    uint64_t run(DdBitSlices const& x, size_t block, bool zdd) {
+        auto const& table = *dd.getDiagram();
+        auto const  root = dd.root();
+        auto        alive = x.valid(block);
+
+        terminal[0] = terminal[1] = 0;
+        pending = 0;
+        put(root, alive);
+
+        for (auto i = std::max(root.row(), x.topLevel()); i >= 1; --i) {
+            auto const xi = x.word(i, block);
+            uint64_t   here = 0;
+            if (i < table.numRows()) {
+                for (auto j : active[i]) {
+                    auto& w = mask[offset[i] + j];
+                    auto  m = w & alive;
+                    w = 0;
+                    here |= m;
+                    put(table.child(i, j, 0), m & ~xi);
+                    put(table.child(i, j, 1), m & xi);
+                }
+                pending -= active[i].size();
+                active[i].clear();
+            }
+            if (zdd) {
+                alive &= ~(xi & ~here);
+            }
+            if (pending == 0 && (terminal[1] & alive) == 0) {
+                break;
+            }
+        }
+        return terminal[1] & alive;
+    }
+
+    std::vector<bool> runAll(DdBitSlices const& x, bool zdd) {
+        std::vector<bool> result(x.size());
+        for (auto b = 0UL; b < x.blocks(); ++b) {
+            auto const m = run(x, b, zdd);
+            for (auto q = 0UL; q < 64 && 64 * b + q < x.size(); ++q) {
+                result[64 * b + q] = ((m >> q) & 1U) != 0;
+            }
+        }
+        return result;
+    }
+
+   public:
+    /**
+     * Constructor.
+     * The diagram must not change while the object is in use.
+     * @param _dd the diagram.
+     */
+    explicit DdBatchQuery(DdStructure<T> const& _dd) : dd(_dd) {
+        auto const& table = *dd.getDiagram();
+        offset.assign(table.numRows() + 1, 0);
+        for (auto i = 1UL; i < table.numRows(); ++i) {
+            offset[i + 1] = offset[i] + table[i].size();
+        }
+        mask.assign(offset.back(), 0);
+        active.resize(table.numRows());
+    }
+
+    /**
+     * Tests the membership of item sets in a ZDD.
+     * @param x the item sets.
+     * @return whether each set belongs to the family.
+     */
+    std::vector<bool> contains(DdBitSlices const& x) { return runAll(x, true); }
+
+    /**
+     * Tests the membership of item sets in a ZDD.
+     * @param sets the item sets; item i is the variable at level i.
+     * @return whether each set belongs to the family.
+     */
+    std::vector<bool> contains(std::vector<std::vector<int>> const& sets) {
+        auto const top = std::max<size_t>(dd.root().row(), 1);
+        size_t     maxItem = top;
+        for (auto const& s : sets) {
+            for (int i : s) {
+                maxItem = std::max<size_t>(maxItem, std::max(i, 0));
+            }
+        }
+        return contains(DdBitSlices::fromSets(sets, maxItem));
+    }
+
+    /**
+     * Evaluates a BDD on input vectors.
+     * @param x the inputs.
+     * @return the value of the function on each input.
+     */
+    std::vector<bool> evaluate(DdBitSlices const& x) {
+        return runAll(x, false);
+    }
+};
+
+#endif  // NODE_BDD_QUERY_HPP
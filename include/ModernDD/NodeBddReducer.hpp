@@ -5,17 +5,20 @@
 #include <cstddef>             // for size_t
 #include <ext/alloc_traits.h>  // for __alloc_traits<>::value_type
 #include <memory>              // for allocator_traits<>::value_type
-#include <range/v3/view/enumerate.hpp>
-#include <range/v3/view/reverse.hpp>
 #include <span>                  // for span
 #include <unordered_set>         // for unordered_set
 #include <vector>                // for vector
+#include "NodeBddProfile.hpp"    // for DdProfile, DdPhase
 #include "NodeBddTable.hpp"      // for TableHandler, NodeTableEntity
 #include "NodeId.hpp"            // for NodeId
+#include "util/Executor.hpp"     // for Executor, forChunks, maxChunks
 #include "util/MyHashTable.hpp"  // for MyHashDefault
 
 template <typename T, bool BDD, bool ZDD>
 class DdReducer {
+    static size_t const GRAIN = 4096;  ///< Least nodes per parallel chunk.
+
+    Executor*                         executor;
     TableHandler<T>                   oldDiagram;
     NodeTableEntity<T>&               input;
     TableHandler<T>                   newDiagram;
@@ -27,8 +30,15 @@ class DdReducer {
     bool readyForSequentialReduction;
 
    public:
-    explicit DdReducer(TableHandler<T>& diagram, bool useMP = false)
-        : oldDiagram(std::move(diagram)),
+    /**
+     * Constructor.
+     * @param diagram the diagram to reduce, replaced by the output table.
+     * @param _executor runs the node-wise passes over wide levels; nullptr
+     * runs them on the calling thread.
+     */
+    explicit DdReducer(TableHandler<T>& diagram, Executor* _executor = nullptr)
+        : executor(_executor),
+          oldDiagram(std::move(diagram)),
           input(*oldDiagram),
           newDiagram(input.numRows()),
           output(*newDiagram),
@@ -38,7 +48,7 @@ class DdReducer {
         diagram = std::move(newDiagram);
 
         input.initTerminals();
-        input.makeIndex(useMP);
+        input.makeIndex(executor);
 
         newIdTable[0].resize(2);
         newIdTable[0][0] = 0;
@@ -46,6 +56,21 @@ class DdReducer {
     }
 
    private:
+    /**
+     * Runs f(j) for every node j of a level, in parallel over wide levels.
+     * @param m the number of nodes.
+     * @param f the function, which must only write to node j.
+     */
+    template <typename F>
+    void forNodes(size_t m, F&& f) const {
+        forChunks(executor, m, GRAIN, maxChunks(executor),
+                  [&](size_t begin, size_t end, size_t) {
+                      for (auto j = begin; j < end; ++j) {
+                          f(j);
+                      }
+                  });
+    }
+
     /**
      * Applies the node deletion rules.
      * It is required before serial reduction (Algorithm-R)
@@ -57,13 +82,10 @@ class DdReducer {
         }
 
         for (auto i = 2UL; i < input.numRows(); ++i) {
-            // size_t const    m = input[i].size();
-            // std::span const tt{input[i].data(), input[i].size()};
-            // T* const     tt = input[i].data();
+            std::span<T> const tt{input[i].data(), input[i].size()};
 
-            for (auto& it : input[i]) {
-                for (auto& f : it) {
-                    // NodeId& f = it[b];
+            forNodes(tt.size(), [&](size_t j) {
+                for (auto& f : tt[j]) {
                     if (f.row() == 0) {
                         continue;
                     }
@@ -82,10 +104,10 @@ class DdReducer {
                         f = f0;
                     }
                 }
-            }
+            });
         }
 
-        input.makeIndex();
+        input.makeIndex(executor);
         readyForSequentialReduction = true;
     }
 
@@ -99,9 +121,9 @@ class DdReducer {
     /**
      * Reduces one level.
      * @param i level.
-     * @param useMP use an algorithm for multiple processors.
      */
     void reduce(size_t i) {
+        DdProfile::Scope const profile(DdPhase::Reduce, i);
         if (BDD) {
             algorithmZdd(i);
         } else if (ZDD) {
@@ -121,12 +143,11 @@ class DdReducer {
 
         std::vector<NodeId>& newId = newIdTable[i];
         newId.resize(m);
+        std::span<T> const tt{input[i].data(), input[i].size()};
 
-        // for (size_t j = m - 1; j + 1 > 0; --j) {
-        for (auto&& [j, f] :
-             input[i] | ranges::views::enumerate | ranges::views::reverse) {
-            auto& f0 = f[0];
-            auto& f1 = f[1];
+        forNodes(m, [&](size_t j) {
+            auto& f0 = tt[j][0];
+            auto& f1 = tt[j][1];
 
             if (f0.row() != 0) {
                 f0 = newIdTable[f0.row()][f0.col()];
@@ -141,7 +162,7 @@ class DdReducer {
                 newId[j] =
                     NodeId(counter + 1, m);  // tail of f0-equivalent list
             }
-        }
+        });
 
         {
             auto const& levels = input.lowerLevels(counter);
@@ -171,22 +192,21 @@ class DdReducer {
             output.initRow(counter, mm);
             std::span<T> nt{output[counter].data(), output[counter].size()};
 
-            for (size_t j = 0; j < m; ++j) {
-                // NodeId const& f0 = tt[j].branch[0];
-                auto const& f1 = input[i][j][1];
+            forNodes(m, [&](size_t j) {
+                auto const& f1 = tt[j][1];
 
                 if (ZDD && f1 == 0) {  // forwarded
                     assert(newId[j].row() < counter);
                 } else {
                     assert(newId[j].row() == counter);
                     auto k = newId[j].col();
-                    nt[k] = input[i][j];
+                    nt[k] = tt[j];
                     nt[k].set_node_id_label(newId[j]);
                     if (nt[k].get_ptr_node_id() != 0) {
                         nt[k].set_ptr_node_id(newId[j]);
                     }
                 }
-            }
+            });
 
             counter++;
         }
@@ -210,17 +230,18 @@ class DdReducer {
         auto& newId = newIdTable[i];
         newId.resize(m);
 
+        forNodes(m, [&](size_t j) {
+            for (auto& f : tt[j]) {
+                if (f.row() != 0) {
+                    f = newIdTable[f.row()][f.col()];
+                }
+            }
+        });
+
         for (size_t j = m - 1; j + 1 > 0; --j) {
             auto& f0 = tt[j][0];
             auto& f1 = tt[j][1];
 
-            if (f0.row() != 0) {
-                f0 = newIdTable[f0.row()][f0.col()];
-            }
-            if (f1.row() != 0) {
-                f1 = newIdTable[f1.row()][f1.col()];
-            }
-
             if (ZDD && f1 == 0) {
                 newId[j] = f0;
             } else {
@@ -286,7 +307,9 @@ class DdReducer {
             output.initRow(i, mm);
             std::span<T> nt{output[i].data(), output[i].size()};
 
-            for (size_t j = 0; j < m; ++j) {
+            // a forwarded node reads the ID of its canonical node, which is
+            // never forwarded itself
+            forNodes(m, [&](size_t j) {
                 auto const& f0 = tt[j][0];
                 auto const& f1 = tt[j][1];
 
@@ -302,7 +325,7 @@ class DdReducer {
                     nt[k] = tt[j];
                     nt[k].set_node_id_label(newId[j]);
                 }
-            }
+            });
 
             counter++;
         }
@@ -43,7 +43,8 @@
 #include <stdexcept>  // for runtime_error
 #include <string>     // for allocator, string
 
-#include "NodeBddDumper.hpp"  // for DdDumper
+#include "NodeBddDumper.hpp"    // for DdDumper
+#include "util/HashPolicy.hpp"  // for DdHash
 
 /**
  * Base class of DD specs.
@@ -62,6 +63,20 @@
  *
  * Optionally, the following functions can be overloaded:
  * - void printLevel(std::ostream& os, int level) const
+ * - void canonicalize_state(void* p, int level)
+ * - W factor_offset(void* p, int level)
+ *
+ * canonicalize_state(void*, int) rewrites a state into the representative of
+ * its equivalence class under a symmetry of the spec; it is called before
+ * a state is hashed, so that symmetric states are merged into one node.
+ * The children of a canonicalized state must be equivalent to those of the
+ * original one.
+ *
+ * factor_offset(void*, int) is used by edge-valued builders only. It removes
+ * an additive cost from a state, e.g. the cost accumulated since the parent
+ * node, and returns it; it is called after canonicalize_state(void*, int)
+ * and before hashing and merging, so that states equal up to a cost offset
+ * are merged into one node and the offset is put on the incoming arc.
  *
  * A return code of get_root(void*) or get_child(void*, int, bool) is:
  * 0 when the node is the 0-terminal, -1 when it is the 1-terminal, or
@@ -85,6 +100,13 @@ class DdSpecBase {
 
     void printLevel(std::ostream& os, int level) const { os << level; }
 
+    void canonicalize_state([[maybe_unused]] void* p,
+                            [[maybe_unused]] int   level) {}
+
+    int factor_offset([[maybe_unused]] void* p, [[maybe_unused]] int level) {
+        return 0;
+    }
+
     /**
      * Returns a random instance using simple depth-first search
      * without caching.
@@ -120,17 +142,15 @@ class DdSpecBase {
     }
 
    private:
-    static constexpr int HASH_CONST_BASE = 314159257;
     template <typename T, typename I>
     static size_t rawHashCode_(void const* p) {
         size_t h = 0;
         // auto*     a = static_cast<I const*>(p);
         std::span aux{static_cast<I const*>(p), sizeof(T) / sizeof(I)};
         for (auto const& it : aux) {
-            h += it;
-            h *= HASH_CONST_BASE;
+            h = DdHash::combine(h, it);
         }
-        return h;
+        return DdHash::finish(h);
     }
 
     template <typename T, typename I>
@@ -243,6 +263,8 @@ class StatelessDdSpec : public DdSpecBase<S, AR> {
  * - void construct(void* p)
  * - void getCopy(void* p, T const& state)
  * - void mergeStates(T& state1, T& state2)
+ * - void canonicalize(T& state, int level)
+ * - W factorOffset(T& state, int level)
  * - size_t hashCode(T const& state) const
  * - bool equalTo(T const& state1, T const& state2) const
  * - void printLevel(std::ostream& os, int level) const
@@ -293,6 +315,20 @@ class DdSpec : public DdSpecBase<S, AR> {
         return this->entity().mergeStates(state(p1), state(p2));
     }
 
+    void canonicalize([[maybe_unused]] State& s, [[maybe_unused]] int level) {}
+
+    void canonicalize_state(void* p, int level) {
+        this->entity().canonicalize(state(p), level);
+    }
+
+    int factorOffset([[maybe_unused]] State& s, [[maybe_unused]] int level) {
+        return 0;
+    }
+
+    auto factor_offset(void* p, int level) {
+        return this->entity().factorOffset(state(p), level);
+    }
+
     void destruct(void* p) { state(p).~State(); }
 
     // void destructLevel(int level) {}
@@ -347,6 +383,8 @@ class DdSpec : public DdSpecBase<S, AR> {
  *
  * Optionally, the following functions can be overloaded:
  * - void mergeStates(T* array1, T* array2)
+ * - void canonicalize(T* array, int level)
+ * - W factorOffset(T* array, int level)
  * - void printLevel(std::ostream& os, int level) const
  * - void printState(std::ostream& os, State const* array) const
  *
@@ -370,7 +408,6 @@ class PodArrayDdSpec : public DdSpecBase<S, AR> {
     static State const* state(void const* p) {
         return static_cast<State const*>(p);
     }
-    static constexpr size_t HASH_CONST_POD_ARRAY = 314159257;
 
    protected:
     void setArraySize(int n) {
@@ -426,6 +463,20 @@ class PodArrayDdSpec : public DdSpecBase<S, AR> {
         return this->entity().mergeStates(state(p1), state(p2));
     }
 
+    void canonicalize([[maybe_unused]] T* a, [[maybe_unused]] int level) {}
+
+    void canonicalize_state(void* p, int level) {
+        this->entity().canonicalize(state(p), level);
+    }
+
+    int factorOffset([[maybe_unused]] T* a, [[maybe_unused]] int level) {
+        return 0;
+    }
+
+    auto factor_offset(void* p, int level) {
+        return this->entity().factorOffset(state(p), level);
+    }
+
     void destruct([[maybe_unused]] void* p) {}
 
     // void destructLevel(int level) {}
@@ -435,16 +486,8 @@ class PodArrayDdSpec : public DdSpecBase<S, AR> {
         // Word const* pz = pa + dataWords;
         std::span<Word const> aux{pa, size_t(dataWords)};
         // size_t h = 0;
-        return ranges::accumulate(aux, 0UL, [](auto a, auto b) {
-            auto tmp{a + b};
-            tmp *= HASH_CONST_POD_ARRAY;
-            return tmp;
-        });
-        // while (pa != pz) {
-        //     h += *pa++;
-        //     h *= HASH_CONST_POD_ARRAY;
-        // }
-        // return h;
+        return DdHash::finish(ranges::accumulate(
+            aux, 0UL, [](auto a, auto b) { return DdHash::combine(a, b); }));
     }
 
     bool equal_to(void const*          p,
@@ -496,6 +539,8 @@ class PodArrayDdSpec : public DdSpecBase<S, AR> {
  * - void construct(void* p)
  * - void getCopy(void* p, TS const& state)
  * - void mergeStates(TS& s1, TA* a1, TS& s2, TA* a2)
+ * - void canonicalize(TS& scalar, TA* array, int level)
+ * - W factorOffset(TS& scalar, TA* array, int level)
  * - size_t hashCode(TS const& state) const
  * - bool equalTo(TS const& state1, TS const& state2) const
  * - void printLevel(std::ostream& os, int level) const
@@ -517,7 +562,6 @@ class HybridDdSpec : public DdSpecBase<S, AR> {
     static int const S_WORDS =
         (sizeof(S_State) + sizeof(Word) - 1) / sizeof(Word);
     static constexpr size_t HASH_HYBRID_SPEC1 = 271828171;
-    static constexpr size_t HASH_HYBRID_SPEC2 = 314159257;
 
     int arraySize{};
     int dataWords{};
@@ -599,6 +643,24 @@ class HybridDdSpec : public DdSpecBase<S, AR> {
                                           a_state(p2));
     }
 
+    void canonicalize([[maybe_unused]] S_State& s,
+                      [[maybe_unused]] A_State* a,
+                      [[maybe_unused]] int      level) {}
+
+    void canonicalize_state(void* p, int level) {
+        this->entity().canonicalize(s_state(p), a_state(p), level);
+    }
+
+    int factorOffset([[maybe_unused]] S_State& s,
+                     [[maybe_unused]] A_State* a,
+                     [[maybe_unused]] int      level) {
+        return 0;
+    }
+
+    auto factor_offset(void* p, int level) {
+        return this->entity().factorOffset(s_state(p), a_state(p), level);
+    }
+
     void destruct([[maybe_unused]] void* p) {}
 
     // void destructLevel(int level) {}
@@ -611,23 +673,15 @@ class HybridDdSpec : public DdSpecBase<S, AR> {
 
     size_t hash_code(void const* p, int level) const {
         size_t h = this->entity().hashCodeAtLevel(s_state(p), level);
-        h *= HASH_HYBRID_SPEC1;
+        if constexpr (DdHash::historical) {
+            h *= HASH_HYBRID_SPEC1;
+        }
         Word const* pa = static_cast<Word const*>(p);
-        // Word const* pz = pa + dataWords;
-        // pa += S_WORDS;
-        // while (pa != pz)
-        // {
-        //   h += *pa++;
-        //   h *= HASH_HYBRID_SPEC2;
-        // }
 
         std::span<Word const> aux{pa, dataWords};
-        return ranges::accumulate(aux | ranges::views::drop(size_t(S_WORDS)), h,
-                                  [](auto a, auto b) {
-                                      auto tmp{a + b};
-                                      tmp *= HASH_HYBRID_SPEC2;
-                                      return tmp;
-                                  });
+        return DdHash::finish(ranges::accumulate(
+            aux | ranges::views::drop(size_t(S_WORDS)), h,
+            [](auto a, auto b) { return DdHash::combine(a, b); }));
     }
 
     bool equalTo(S_State const& s1, S_State const& s2) const {
@@ -0,0 +1,428 @@
+#ifndef NODE_BDD_STATISTICS_HPP
+#define NODE_BDD_STATISTICS_HPP
+
+#include <algorithm>             // for min, max
+#include <atomic>                // for atomic, memory_order_relaxed
+#include <charconv>              // for to_chars
+#include <cstddef>               // for size_t
+#include <cstdint>               // for uint32_t
+#include <limits>                // for numeric_limits
+#include <ostream>               // for ostream
+#include <string>                // for string
+#include <string_view>           // for string_view
+#include <utility>               // for forward
+#include <vector>                // for vector
+#include "NodeBddStructure.hpp"  // for DdStructure
+#include "NodeBddTable.hpp"      // for NodeTableEntity
+#include "NodeId.hpp"            // for NodeId
+#include "util/Executor.hpp"     // for Executor, forChunks, maxChunks
+
+/**
+ * Shape of a diagram.
+ * Edges to the 0-terminal are counted in zeroEdges only; every other edge
+ * appears in the degree and length histograms.
+ */
+struct DdStatistics {
+    std::vector<size_t> width;       ///< Number of nodes at every level.
+    std::vector<size_t> inDegree;    ///< Nodes by number of parents.
+    std::vector<size_t> outDegree;   ///< Nodes by number of non-0 children.
+    std::vector<size_t> edgeLength;  ///< Edges by number of levels spanned.
+    size_t              nodes{};     ///< Number of non-terminal nodes.
+    size_t              edges{};     ///< Edges not to the 0-terminal.
+    size_t              zeroEdges{};  ///< Edges to the 0-terminal.
+    size_t              oneEdges{};   ///< Edges to the 1-terminal.
+    size_t              reachable{};  ///< Nodes reachable from the root.
+    size_t              live{};  ///< Nodes with a path to the 1-terminal.
+    size_t              useful{};  ///< Nodes both reachable and live.
+
+    /**
+     * Gets the width of the widest level.
+     * @return the maximum width.
+     */
+    [[nodiscard]] size_t maxWidth() const {
+        size_t w = 0;
+        for (auto x : width) {
+            w = std::max(w, x);
+        }
+        return w;
+    }
+
+    /**
+     * Gets the number of edges skipping at least one level.
+     * @return the number of long edges.
+     */
+    [[nodiscard]] size_t longEdges() const {
+        size_t n = 0;
+        for (auto l = 2UL; l < edgeLength.size(); ++l) {
+            n += edgeLength[l];
+        }
+        return n;
+    }
+};
+
+/**
+ * Computes the statistics of a diagram.
+ * The nodes are visited once, level by level from the bottom, computing
+ * the histograms, the parent counts and the live flags; a second sweep from
+ * the top propagates reachability flags. The nodes of every level are split
+ * into chunks run on an executor; each chunk owns its histograms, which
+ * are merged at the end, and parent counts are relaxed atomic increments.
+ * @tparam T the node type.
+ */
+template <typename T>
+class DdStatisticsCollector {
+    struct Partial {
+        std::vector<size_t> inDegree;
+        std::vector<size_t> edgeLength;
+        size_t              outDegree[3]{};
+        size_t              zeroEdges{};
+        size_t              oneEdges{};
+        size_t              reachable{};
+        size_t              live{};
+        size_t              useful{};
+    };
+
+    Executor* executor;
+    size_t    grain;  ///< Least number of nodes per chunk.
+
+    /**
+     * Runs f(begin, end, k) over chunks of [0, n).
+     * Chunk k is owned by the k-th accumulator.
+     */
+    template <typename F>
+    void forChunks(size_t n, size_t chunks, F&& f) const {
+        ::forChunks(executor, n, grain, chunks, std::forward<F>(f));
+    }
+
+   public:
+    /**
+     * Constructor.
+     * @param _executor the executor, or nullptr to run on the calling
+     * thread.
+     * @param _grain the least number of nodes of a level per chunk.
+     */
+    explicit DdStatisticsCollector(Executor* _executor = nullptr,
+                                   size_t    _grain = 4096)
+        : executor(_executor),
+          grain(std::max<size_t>(_grain, 1)) {}
+
+    /**
+     * Computes the statistics of a diagram.
+     * @param dd the diagram.
+     * @return the statistics.
+     */
+    DdStatistics collect(DdStructure<T> const& dd) const {
+        auto const& table = *dd.getDiagram();
+        auto const  rows = table.numRows();
+        auto const  chunks = maxChunks(executor);
+
+        DdStatistics result;
+        result.width.assign(rows, 0);
+        std::vector<size_t> offset(rows + 1);
+        for (auto i = 1UL; i < rows; ++i) {
+            result.width[i] = table[i].size();
+            offset[i + 1] = offset[i] + table[i].size();
+        }
+        result.nodes = offset[rows];
+
+        std::vector<Partial> partial(chunks);
+        for (auto& p : partial) {
+            p.edgeLength.assign(rows, 0);
+        }
+        std::vector<std::atomic<std::uint32_t>> parents(result.nodes);
+        std::vector<char>                       live(result.nodes);
+        std::vector<std::atomic<char>>          reached(result.nodes);
+
+        auto const index = [&](NodeId f) { return offset[f.row()] + f.col(); };
+
+        for (auto i = 1UL; i < rows; ++i) {
+            forChunks(table[i].size(), chunks, [&](size_t begin, size_t end,
+                                                      size_t k) {
+                auto& p = partial[k];
+                for (auto j = begin; j < end; ++j) {
+                    int  degree = 0;
+                    bool isLive = false;
+                    for (int b = 0; b < 2; ++b) {
+                        NodeId const f = table.child(i, j, b);
+                        if (f.row() == 0 && f.col() == 0) {
+                            ++p.zeroEdges;
+                            continue;
+                        }
+                        ++degree;
+                        ++p.edgeLength[i - f.row()];
+                        if (f.row() == 0) {
+                            ++p.oneEdges;
+                            isLive = true;
+                        } else {
+                            parents[index(f)].fetch_add(
+                                1, std::memory_order_relaxed);
+                            isLive = isLive || live[index(f)];
+                        }
+                    }
+                    ++p.outDegree[degree];
+                    live[offset[i] + j] = isLive;
+                    p.live += isLive ? 1 : 0;
+                }
+            });
+        }
+
+        auto const root = dd.root();
+        if (root.row() > 0) {
+            reached[index(root)].store(1, std::memory_order_relaxed);
+        }
+        for (auto i = root.row(); i >= 1; --i) {
+            forChunks(table[i].size(), chunks, [&](size_t begin, size_t end,
+                                                      size_t k) {
+                auto& p = partial[k];
+                for (auto j = begin; j < end; ++j) {
+                    auto const d = parents[offset[i] + j].load(
+                        std::memory_order_relaxed);
+                    if (p.inDegree.size() <= d) {
+                        p.inDegree.resize(d + 1);
+                    }
+                    ++p.inDegree[d];
+                    if (!reached[offset[i] + j].load(
+                            std::memory_order_relaxed)) {
+                        continue;
+                    }
+                    ++p.reachable;
+                    p.useful += live[offset[i] + j] ? 1 : 0;
+                    for (int b = 0; b < 2; ++b) {
+                        NodeId const f = table.child(i, j, b);
+                        if (f.row() > 0) {
+                            reached[index(f)].store(1,
+                                                    std::memory_order_relaxed);
+                        }
+                    }
+                }
+            });
+        }
+        for (auto i = std::max<size_t>(root.row() + 1, 1); i < rows; ++i) {
+            auto& p = partial[0];
+            for (auto j = 0UL; j < table[i].size(); ++j) {
+                auto const d = parents[offset[i] + j].load();
+                if (p.inDegree.size() <= d) {
+                    p.inDegree.resize(d + 1);
+                }
+                ++p.inDegree[d];
+            }
+        }
+
+        result.outDegree.assign(3, 0);
+        result.edgeLength.assign(rows, 0);
+        for (auto const& p : partial) {
+            if (result.inDegree.size() < p.inDegree.size()) {
+                result.inDegree.resize(p.inDegree.size());
+            }
+            for (auto d = 0UL; d < p.inDegree.size(); ++d) {
+                result.inDegree[d] += p.inDegree[d];
+            }
+            for (auto l = 0UL; l < rows; ++l) {
+                result.edgeLength[l] += p.edgeLength[l];
+            }
+            for (auto d = 0UL; d < 3; ++d) {
+                result.outDegree[d] += p.outDegree[d];
+            }
+            result.zeroEdges += p.zeroEdges;
+            result.oneEdges += p.oneEdges;
+            result.reachable += p.reachable;
+            result.live += p.live;
+            result.useful += p.useful;
+        }
+        result.edges = 2 * result.nodes - result.zeroEdges;
+        return result;
+    }
+};
+
+/**
+ * Output formats of DdGraphWriter.
+ */
+enum class DdGraphFormat { Dot, GraphML };
+
+/**
+ * Levels and nodes exported by DdGraphWriter.
+ * Levels wider than maxNodesPerLevel are sampled with a fixed stride.
+ */
+struct DdGraphWindow {
+    size_t top{std::numeric_limits<size_t>::max()};  ///< Highest level.
+    size_t bottom{1};                                ///< Lowest level.
+    size_t maxNodesPerLevel{std::numeric_limits<size_t>::max()};
+
+    /**
+     * Makes a window around a level.
+     * @param level the central level.
+     * @param radius the number of levels above and below.
+     * @param maxNodes the maximum number of nodes per level.
+     * @return the window.
+     */
+    static DdGraphWindow around(
+        size_t level,
+        size_t radius,
+        size_t maxNodes = std::numeric_limits<size_t>::max()) {
+        return {level + radius, (level > radius) ? level - radius : 1,
+                maxNodes};
+    }
+};
+
+/**
+ * Writes a diagram or a sampled part of it as Graphviz dot or GraphML.
+ * The text is formatted into a buffer which is written to the stream in
+ * large blocks. Node IDs are "n<level>_<col>", the 1-terminal is "t1" and
+ * edges to the 0-terminal are omitted. Edges to nodes outside the window or
+ * left out by sampling go to a summary node "L<level>" of the target
+ * level.
+ */
+class DdGraphWriter {
+    std::ostream& os;
+    std::string   buffer;
+    size_t        capacity;
+
+    DdGraphWriter& put(std::string_view s) {
+        buffer.append(s);
+        if (buffer.size() >= capacity) {
+            flush();
+        }
+        return *this;
+    }
+
+    DdGraphWriter& put(size_t n) {
+        char       tmp[24];
+        auto const r = std::to_chars(tmp, tmp + sizeof(tmp), n);
+        return put(std::string_view(tmp, r.ptr - tmp));
+    }
+
+    DdGraphWriter& putNode(size_t row, size_t col) {
+        return put("n").put(row).put("_").put(col);
+    }
+
+    DdGraphWriter& putSummary(size_t row) { return put("L").put(row); }
+
+   public:
+    /**
+     * Constructor.
+     * @param _os the output stream.
+     * @param bufferSize the number of bytes buffered between writes.
+     */
+    explicit DdGraphWriter(std::ostream& _os, size_t bufferSize = 1UL << 16)
+        : os(_os),
+          capacity(std::max<size_t>(bufferSize, 64)) {
+        buffer.reserve(capacity + 64);
+    }
+
+    ~DdGraphWriter() { flush(); }
+
+    DdGraphWriter(DdGraphWriter const&) = delete;
+    DdGraphWriter& operator=(DdGraphWriter const&) = delete;
+    DdGraphWriter(DdGraphWriter&&) = delete;
+    DdGraphWriter& operator=(DdGraphWriter&&) = delete;
+
+    /**
+     * Writes the buffered text to the stream.
+     */
+    void flush() {
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+
+    /**
+     * Writes a diagram.
+     * @param dd the diagram.
+     * @param format the output format.
+     * @param window the exported levels and the sampling limit.
+     */
+    template <typename T>
+    void write(DdStructure<T> const& dd,
+               DdGraphFormat         format,
+               DdGraphWindow const&  window = {}) {
+        auto const& table = *dd.getDiagram();
+        auto const  rows = table.numRows();
+        bool const  dot = (format == DdGraphFormat::Dot);
+        auto const  top = std::min(window.top, rows - 1);
+        auto const  bottom = std::max<size_t>(window.bottom, 1);
+        auto const  perLevel = std::max<size_t>(window.maxNodesPerLevel, 1);
+
+        std::vector<size_t> stride(rows, 0);  // 0 outside the window
+        for (auto i = bottom; i <= top && i < rows; ++i) {
+            stride[i] = (table[i].size() + perLevel - 1) / perLevel;
+            stride[i] = std::max<size_t>(stride[i], 1);
+        }
+        std::vector<char> summary(rows);
+        bool              terminal = false;
+
+        if (dot) {
+            put("digraph DD {\n");
+        } else {
+            put("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n"
+                "<key id=\"level\" for=\"node\" attr.name=\"level\" "
+                "attr.type=\"int\"/>\n"
+                "<key id=\"branch\" for=\"edge\" attr.name=\"branch\" "
+                "attr.type=\"int\"/>\n"
+                "<graph id=\"DD\" edgedefault=\"directed\">\n");
+        }
+
+        for (auto i = top; i >= bottom; --i) {
+            for (auto j = 0UL; j < table[i].size(); j += stride[i]) {
+                if (dot) {
+                    putNode(i, j).put(";\n");
+                } else {
+                    put("<node id=\"").putNode(i, j);
+                    put("\"><data key=\"level\">").put(i);
+                    put("</data></node>\n");
+                }
+
+                for (size_t b = 0; b < 2; ++b) {
+                    NodeId const f = table.child(i, j, b);
+                    if (f.row() == 0 && f.col() == 0) {
+                        continue;
+                    }
+                    put(dot ? "" : "<edge source=\"").putNode(i, j);
+                    put(dot ? " -> " : "\" target=\"");
+                    if (f.row() == 0) {
+                        terminal = true;
+                        put("t1");
+                    } else if (stride[f.row()] != 0 &&
+                               f.col() % stride[f.row()] == 0) {
+                        putNode(f.row(), f.col());
+                    } else {
+                        summary[f.row()] = 1;
+                        putSummary(f.row());
+                    }
+                    if (dot) {
+                        put(b == 0 ? " [style=dashed];\n" : ";\n");
+                    } else {
+                        put("\"><data key=\"branch\">").put(b);
+                        put("</data></edge>\n");
+                    }
+                }
+            }
+            if (i == bottom) {
+                break;
+            }
+        }
+
+        for (auto i = 1UL; i < rows; ++i) {
+            if (!summary[i]) {
+                continue;
+            }
+            if (dot) {
+                putSummary(i).put(" [shape=box,style=dotted,label=\"level ");
+                put(i).put("\"];\n");
+            } else {
+                put("<node id=\"").putSummary(i);
+                put("\"><data key=\"level\">").put(i).put("</data></node>\n");
+            }
+        }
+        if (terminal) {
+            if (dot) {
+                put("t1 [shape=square,label=\"1\"];\n");
+            } else {
+                put("<node id=\"t1\"><data key=\"level\">0</data></node>\n");
+            }
+        }
+        put(dot ? "}\n" : "</graph>\n</graphml>\n");
+        flush();
+    }
+};
+
+#endif  // NODE_BDD_STATISTICS_HPP
@@ -0,0 +1,313 @@
+#ifndef NODE_BDD_STREAM_SUBSETTER_HPP
+#define NODE_BDD_STREAM_SUBSETTER_HPP
+
+#include <cassert>              // for assert
+#include <cstddef>              // for size_t
+#include <cstdint>              // for uint64_t
+#include <cstdio>               // for remove
+#include <map>                  // for map
+#include <optional>             // for optional
+#include <string>               // for string
+#include <unordered_set>        // for unordered_set
+#include <utility>              // for move
+#include <vector>               // for vector
+#include "NodeBddBuilder.hpp"   // for BuilderBase, ZddSubsetWalk
+#include "NodeBddFile.hpp"      // for DdFile, DdFileWriter
+#include "NodeBddProfile.hpp"   // for DdProfile, DdPhase
+#include "NodeId.hpp"           // for NodeId
+#include "util/MemoryPool.hpp"  // for MemoryPools
+#include "util/MyList.hpp"      // for MyListOnPool
+
+/**
+ * Breadth-first ZDD subset builder from a diagram file to a diagram file.
+ * The input is read from its mapping and each level is released once it
+ * has been processed. Work lists are kept only for the input nodes that
+ * are reached, and only until their level is done, so that the memory
+ * held is the spec states of the active levels.
+ *
+ * A node is written when its level is processed, before its children are
+ * numbered. Its child edges are therefore written as slots: NodeId(ii, k)
+ * is the k-th state scheduled at level ii, and the slot table of level ii,
+ * written when that level is processed, maps the slot to the child's node
+ * ID. Edges to the 1-terminal carry the generation of the 1-terminal state
+ * they were merged into, since a later merge may forward all earlier ones
+ * to the 0-terminal. finish() replaces the slots by the node IDs. Both
+ * scratch files are written next to the output. The output is not swept.
+ */
+template <typename S>
+class ZddStreamSubsetter : BuilderBase {
+    using Spec = S;
+    using UniqTable = std::unordered_set<SpecNode*, Hasher<Spec>, Hasher<Spec>>;
+    using WorkLists = std::map<size_t, MyListOnPool<SpecNode>>;
+    static_assert(Spec::ARITY == 2, "ZDD subsetting needs a binary spec");
+
+    Spec                        spec;
+    int const                   specNodeSize;
+    DdFile const&               input;
+    std::string const           path;
+    std::string const           rowsPath;
+    std::string const           slotsPath;
+    std::optional<DdFileWriter> rows;
+    std::optional<DdFileWriter> slots;
+    std::vector<WorkLists>      work;
+    std::vector<uint64_t>       numSlots;
+    NodeId                      root_;
+
+    std::vector<char> oneStorage;
+    void* const       one;
+    bool              hasOne{};
+    uint64_t          generation{};
+
+    MemoryPools pools;
+
+   public:
+    /**
+     * Constructor.
+     * @param _input the input diagram.
+     * @param s the spec.
+     * @param _path the output file.
+     */
+    ZddStreamSubsetter(DdFile const& _input, Spec const& s, std::string _path)
+        : spec(s),
+          specNodeSize(getSpecNodeSize(spec.datasize())),
+          input(_input),
+          path(std::move(_path)),
+          rowsPath(path + ".rows.tmp"),
+          slotsPath(path + ".slots.tmp"),
+          oneStorage(spec.datasize()),
+          one(oneStorage.data()) {}
+
+    ~ZddStreamSubsetter() {
+        if (hasOne) {
+            spec.destruct(one);
+        }
+        rows.reset();
+        slots.reset();
+        std::remove(rowsPath.c_str());
+        std::remove(slotsPath.c_str());
+    }
+
+    ZddStreamSubsetter(ZddStreamSubsetter const&) = delete;
+    ZddStreamSubsetter& operator=(ZddStreamSubsetter const&) = delete;
+
+    /**
+     * Initializes the builder.
+     * @return the level of the root, or 0 if the result is a terminal.
+     */
+    int initialize() {
+        root_ = input.root();
+        std::vector<char> tmp(spec.datasize());
+        void* const       tmpState = tmp.data();
+        int const         n = walk().root(tmpState, root_);
+
+        if (n > 0) {
+            pools.resize(n + 1);
+            work.resize(n + 1);
+            numSlots.assign(n + 1, 0);
+
+            SpecNode* p0 =
+                work[n][root_.col()].alloc_front(pools[n], specNodeSize);
+            spec.get_copy(state(p0), tmpState);
+            code(p0) = static_cast<int64_t>(numSlots[n]++);
+            root_ = NodeId(n, 0);
+            rows.emplace(rowsPath, n + 1);
+            slots.emplace(slotsPath, n + 1);
+        }
+
+        spec.destruct(tmpState);
+        return n;
+    }
+
+    /**
+     * Builds one level.
+     * @param i level.
+     */
+    void subset(size_t i) {
+        assert(0 < i && i < work.size());
+        DdProfile::Scope const profile(DdPhase::Construct, i);
+
+        Hasher<Spec> const    hasher(spec, i);
+        std::vector<char>     tmp(spec.datasize());
+        void* const           tmpState = tmp.data();
+        std::vector<uint64_t> table(numSlots[i]);
+        size_t                mm = 0;
+
+        for (auto& [j, list] : work[i]) {
+            auto n = list.size();
+
+            if (n >= 2) {
+                UniqTable uniq(n * 2, hasher, hasher);
+
+                for (auto* p : list) {
+                    auto const k = static_cast<size_t>(code(p));
+                    spec.canonicalize_state(state(p), static_cast<int>(i));
+                    SpecNode* p0 = p;
+
+                    switch (insertState(spec, uniq, p, p0)) {
+                        case -1:
+                            nodeId(p) = NodeId(i, mm++);
+                            table[k] = nodeId(p).code();
+                            break;
+                        case 1:
+                            nodeId(p0) = 0;  // forward to 0-terminal
+                            nodeId(p) = NodeId(i, mm++);
+                            table[k] = nodeId(p).code();
+                            break;
+                        case 2:
+                            table[k] = 0;
+                            nodeId(p) = 1;  // unused
+                            break;
+                        default:
+                            table[k] = nodeId(p0).code();
+                            nodeId(p) = 1;  // unused
+                            break;
+                    }
+                }
+            } else if (n == 1) {
+                SpecNode* p = list.front();
+                auto const k = static_cast<size_t>(code(p));
+                nodeId(p) = NodeId(i, mm++);
+                table[k] = nodeId(p).code();
+            }
+        }
+
+        slots->level(i);
+        for (auto w : table) {
+            slots->put(w);
+        }
+        std::vector<uint64_t>().swap(table);
+
+        rows->level(i);
+        for (auto& [j, list] : work[i]) {
+            for (auto* p : list) {
+                if (nodeId(p) == 1) {
+                    spec.destruct(state(p));
+                    continue;
+                }
+
+                NodeId q[2];
+                for (int b = 0; b < 2; ++b) {
+                    if (nodeId(p) == 0) {
+                        q[b] = 0;
+                        continue;
+                    }
+
+                    NodeId     f;
+                    auto const ii =
+                        walk().child(tmpState, state(p), i, j, b, f);
+
+                    if (ii == 0) {
+                        q[b] = 0;
+                        continue;
+                    }
+                    if (ii < 0) {
+                        q[b] = oneSlot(tmpState);
+                    } else {
+                        SpecNode* pp = work[ii][f.col()].alloc_front(
+                            pools[ii], specNodeSize);
+                        spec.get_copy(state(pp), tmpState);
+                        code(pp) = static_cast<int64_t>(numSlots[ii]);
+                        q[b] = NodeId(ii, numSlots[ii]++);
+                    }
+
+                    spec.destruct(tmpState);
+                }
+
+                spec.destruct(state(p));
+                rows->put(q[0], q[1]);
+            }
+        }
+
+        work[i].clear();
+        pools[i].clear();
+        input.release(i);
+    }
+
+    /**
+     * Writes the output file, replacing the slots by node IDs.
+     * @exception std::runtime_error a file cannot be read or written.
+     */
+    void finish() {
+        if (!rows) {
+            DdFileWriter(path, 1).close(root_);
+            return;
+        }
+
+        auto const numRows = work.size();
+        rows->close(root_);
+        slots->close(NodeId(0));
+        rows.reset();
+        slots.reset();
+        DdFile const pending(rowsPath);
+        DdFile const table(slotsPath);
+        std::remove(rowsPath.c_str());
+        std::remove(slotsPath.c_str());
+
+        auto const resolve = [&](NodeId f) {
+            if (f.row() == 0) {
+                return NodeId(0, f.col() != 0 && f.col() - 1 == generation);
+            }
+            return NodeId(table.level(f.row())[f.col()]);
+        };
+
+        DdFileWriter out(path, numRows);
+        for (auto i = numRows - 1; i > 0; --i) {
+            out.level(i);
+            auto const* w = pending.level(i);
+            for (auto k = 0UL; k < pending.numWords(i); ++k) {
+                out.put(resolve(w[k]).code());
+            }
+            pending.release(i);
+        }
+        out.close(resolve(root_));
+    }
+
+   private:
+    /**
+     * Gets the walk down the input and the spec.
+     */
+    ZddSubsetWalk<Spec, DdFile> walk() { return {spec, input}; }
+
+    /**
+     * Gets the edge to the 1-terminal of a state reaching it, merging the
+     * state into the 1-terminal state.
+     */
+    NodeId oneSlot(void* s) {
+        bool const first = !hasOne;
+        hasOne = true;
+        switch (mergeOneState(spec, one, first, s)) {
+            case 0:
+                return 0;
+            case 2:
+                if (!first) {
+                    ++generation;  // the earlier edges go to 0-terminal
+                }
+                break;
+            default:
+                break;
+        }
+        return {0, generation + 1};
+    }
+};
+
+/**
+ * ZDD subsetting of a diagram file into another diagram file, holding
+ * neither diagram in memory.
+ * @param input the input diagram.
+ * @param spec ZDD spec.
+ * @param output the output file.
+ * @exception std::runtime_error a file cannot be read or written.
+ */
+template <typename SPEC>
+void zddSubsetFile(DdFile const& input,
+                   SPEC const&   spec,
+                   std::string   output) {
+    ZddStreamSubsetter<SPEC> zs(input, spec.entity(), std::move(output));
+    int const                n = zs.initialize();
+    for (int i = n; i > 0; --i) {
+        zs.subset(i);
+    }
+    zs.finish();
+}
+
+#endif  // NODE_BDD_STREAM_SUBSETTER_HPP
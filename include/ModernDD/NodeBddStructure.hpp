@@ -38,26 +38,57 @@
 #include <range/v3/view/reverse.hpp>             // for reverse
 #include <range/v3/view/take.hpp>                // for take, take_fn
 #include <set>                                   // for set
+#include <stdexcept>                             // for runtime_error
 #include <utility>                               // for move, pair
 #include <vector>                                // for vector
 #include "NodeBase.hpp"                          // for InitializedNode
 #include "NodeBddBuilder.hpp"                    // for DdBuilder, ZddSubsetter
-#include "NodeBddEval.hpp"                       // for Eval
+#include "NodeBddDfsBuilder.hpp"                 // for DdDfsBuilder
+#include "NodeBddEval.hpp"                       // for BoundedEval, Eval
+#include "NodeBddFingerprintBuilder.hpp"         // for DdFingerprintBuilder
+#include "NodeBddFixer.hpp"                      // for DdFixer
+#include "NodeBddProfile.hpp"                    // for DdProfile, DdPhase
 #include "NodeBddReducer.hpp"                    // for DdReducer
 #include "NodeBddSpec.hpp"                       // for DdSpec, DdSpecBase
 #include "NodeBddTable.hpp"                      // for TableHandler
 #include "NodeId.hpp"                            // for NodeId
 #include "util/DataTable.hpp"                    // for DataTable
+#include "util/Executor.hpp"                     // for Executor, forChunks, ...
 #include "util/MyHashTable.hpp"                  // for MyHashMap
 
+/**
+ * Construction engines of DdStructure.
+ */
+enum class DdBuildMethod {
+    BreadthFirst,   ///< DdBuilder; the result is not reduced.
+    DepthFirstBdd,  ///< DdDfsBuilder with the BDD node deletion rule.
+    DepthFirstZdd,  ///< DdDfsBuilder with the ZDD node deletion rule.
+    Pipelined,      ///< DdBuilder overlapping expansion and deduplication.
+    /**
+     * DdFingerprintBuilder; the result is not reduced.
+     * States are fingerprinted over their datasize() bytes, not with
+     * hash_code and equal_to. States that equal_to considers equal but that
+     * differ in ignored fields or in pointers are therefore not shared, so
+     * such specs get no deduplication from this method.
+     */
+    Fingerprinted,
+};
+
 /**
  * Ordered n-ary decision diagram structure.
  * @tparam ARITY arity of the nodes.
  */
 template <typename T>
 class DdStructure : public DdSpec<DdStructure<T>, NodeId> {
-    TableHandler<T> diagram;  ///< The diagram structure.
-    NodeId          root_{};  ///< Root node ID.
+    static size_t const EVAL_GRAIN = 1024;  ///< Least nodes per eval chunk.
+
+    TableHandler<T>     diagram;      ///< The diagram structure.
+    NodeId              root_{};      ///< Root node ID.
+    std::vector<NodeId> savedRoots;   ///< Root at each open checkpoint.
+    Executor*           executor_{};  ///< Runs parallel passes if not null.
+
+    template <typename U>
+    friend class DdStructure;
 
    public:
     /**
@@ -90,6 +121,16 @@ class DdStructure : public DdSpec<DdStructure<T>, NodeId> {
         root_ = f;
     }
 
+    /**
+     * Adopts a node table built elsewhere, e.g. assembled from the shards of
+     * DdPartitionedBuilder.
+     * @param table the node table.
+     * @param root the root node ID.
+     */
+    DdStructure(TableHandler<T> table, NodeId root)
+        : diagram(std::move(table)),
+          root_(root) {}
+
     /**
      * DD construction.
      * @param spec DD spec.
@@ -99,39 +140,272 @@ class DdStructure : public DdSpec<DdStructure<T>, NodeId> {
         construct_(spec.entity());
     }
 
+    /**
+     * DD construction whose wide levels are expanded on an executor.
+     * The executor is kept for later reduction and subsetting. The spec
+     * must allow get_copy, get_child and destruct on distinct states
+     * concurrently.
+     * @param spec DD spec.
+     * @param executor the executor.
+     */
+    template <typename SPEC>
+    DdStructure(DdSpecBase<SPEC> const& spec, Executor& executor)
+        : executor_(&executor) {
+        construct_(spec.entity());
+    }
+
+    /**
+     * DD construction with a chosen engine.
+     * Depth-first construction yields a reduced diagram directly; its memo
+     * keeps every visited state, so its memory grows with the number of
+     * visited states as with breadth-first construction. Pipelined construction
+     * deduplicates each level on a second thread while the level above is
+     * expanded; it requires a spec whose hashing functions are thread-safe
+     * with respect to get_child on other states.
+     * @param spec DD spec.
+     * @param method construction engine.
+     */
+    template <typename SPEC>
+    DdStructure(DdSpecBase<SPEC> const& spec, DdBuildMethod method) {
+        switch (method) {
+            case DdBuildMethod::DepthFirstBdd:
+                constructDepthFirst_<true, false>(spec.entity());
+                break;
+            case DdBuildMethod::DepthFirstZdd:
+                constructDepthFirst_<false, true>(spec.entity());
+                break;
+            case DdBuildMethod::Pipelined:
+                constructPipelined_(spec.entity());
+                break;
+            case DdBuildMethod::Fingerprinted: {
+                FingerprintReport report;
+                constructFingerprinted_(spec.entity(), report, false);
+                break;
+            }
+            default:
+                construct_(spec.entity());
+                break;
+        }
+    }
+
+    /**
+     * DD construction deduplicating states by 128-bit fingerprints, which
+     * keeps one state per node instead of every scheduled state.
+     * @param spec DD spec.
+     * @param report receives the lookups and the collision probability bound.
+     * @param verify confirm every fingerprint match with equal_to; a
+     * collision then throws std::runtime_error.
+     */
+    template <typename SPEC>
+    DdStructure(DdSpecBase<SPEC> const& spec,
+                FingerprintReport&      report,
+                bool                    verify = false) {
+        constructFingerprinted_(spec.entity(), report, verify);
+    }
+
    private:
+    template <bool BDD, bool ZDD, typename SPEC>
+    void constructDepthFirst_(SPEC const& spec) {
+        DdDfsBuilder<SPEC, T, BDD, ZDD> zc(spec, diagram);
+        zc.build(root_);
+    }
+
     template <typename SPEC>
     void construct_(SPEC const& spec) {
+        DdBuilder<SPEC, T> zc(spec, diagram, 0, executor_);
+        int                n = zc.initialize(root_);
+
+        if (n > 0) {
+            for (auto i = size_t(n); i > 0UL; --i) {
+                zc.construct(i);
+            }
+        }
+    }
+
+    template <typename SPEC>
+    void constructPipelined_(SPEC const& spec) {
         DdBuilder<SPEC, T> zc(spec, diagram);
         int                n = zc.initialize(root_);
 
+        if (n > 0) {
+            for (auto i = size_t(n); i > 0UL; --i) {
+                zc.constructPipelined(i);
+            }
+        }
+    }
+
+    template <typename SPEC>
+    void constructFingerprinted_(SPEC const&        spec,
+                                 FingerprintReport& report,
+                                 bool               verify) {
+        DdFingerprintBuilder<SPEC, T> zc(spec, diagram, verify);
+        int                           n = zc.initialize(root_);
+
         if (n > 0) {
             for (auto i = size_t(n); i > 0UL; --i) {
                 zc.construct(i);
             }
         }
+        report = zc.report();
+    }
+
+    void checkNoCheckpoint_() const {
+        if (!savedRoots.empty()) {
+            throw std::runtime_error(
+                "DdStructure: the table cannot be replaced while a checkpoint "
+                "is open");
+        }
     }
 
    public:
+    /**
+     * Starts recording in-place modifications such as fix().
+     * Checkpoints nest; each one is closed by rollback() or commit().
+     * Operations that replace the table, such as reduction and subsetting,
+     * are rejected while a checkpoint is open.
+     */
+    void checkpoint() {
+        (*diagram).checkpoint();
+        savedRoots.push_back(root_);
+    }
+
+    /**
+     * Undoes the modifications since the latest checkpoint in time
+     * proportional to their number, and closes it.
+     */
+    void rollback() {
+        (*diagram).rollback();
+        root_ = savedRoots.back();
+        savedRoots.pop_back();
+    }
+
+    /**
+     * Closes the latest checkpoint and keeps its modifications.
+     */
+    void commit() {
+        (*diagram).commit();
+        savedRoots.pop_back();
+    }
+
+    /**
+     * Makes a diagram with the same structure and another node type, e.g.
+     * to run evaluators with different per-node payloads on one build.
+     * Every row is allocated once; its nodes are default-constructed and get
+     * the child pointers of this diagram. No spec is evaluated.
+     * @tparam U the node type of the new diagram.
+     * @return the new diagram.
+     */
+    template <typename U>
+    DdStructure<U> rebind() const& {
+        DdStructure<U> dd;
+        auto const     n = (*diagram).numRows();
+
+        dd.diagram = TableHandler<U>(n);
+        for (auto i = 1UL; i < n; ++i) {
+            (*dd.diagram).copyRowStructure(*diagram, i);
+        }
+        dd.root_ = root_;
+        return dd;
+    }
+
+    /**
+     * Moves the structure of this diagram into a diagram of another node
+     * type. Every row of this diagram is released as soon as it has been
+     * converted, so the peak memory stays close to the larger of the two
+     * tables. This diagram is left empty.
+     * @tparam U the node type of the new diagram.
+     * @return the new diagram.
+     */
+    template <typename U>
+    DdStructure<U> rebind() && {
+        checkNoCheckpoint_();
+        DdStructure<U> dd;
+        auto const     n = (*diagram).numRows();
+
+        dd.diagram = TableHandler<U>(n);
+        for (auto i = 1UL; i < n; ++i) {
+            (*dd.diagram).copyRowStructure(*diagram, i);
+            std::vector<T>().swap((*diagram)[i]);
+        }
+        dd.root_ = root_;
+
+        (*diagram).init(1);
+        (*diagram).deleteIndex();
+        root_ = 0;
+        return dd;
+    }
+
+    /**
+     * Fixes a variable of this ZDD in place.
+     * Only the rows at and above @p level are visited and only the modified
+     * ones are re-reduced, so a reduced ZDD stays reduced except for nodes
+     * left unreachable.
+     * @param level the level of the variable.
+     * @param value the value of the variable.
+     */
+    void fix(int level, bool value) {
+        assert(level >= 1);
+        DdFixer<T> fixer(diagram, root_);
+        fixer.fix(static_cast<size_t>(level), value);
+    }
+
+    /**
+     * Rebuilds the levels at or below @p k for a spec that agrees with the
+     * one this diagram was built from at every level above @p k.
+     * The rows above @p k are kept and the states reaching them are
+     * recovered by replaying the spec from the root, so this diagram must be
+     * the unreduced output of the breadth-first builder. The result is not
+     * reduced either. Edges above @p k that lead to the 0-terminal, such as
+     * those the builder cut off below dead nodes, are expanded again if the
+     * spec yields a node, so the spec may also admit more than before.
+     * If the replay contradicts the kept rows, the diagram is cleared and
+     * std::runtime_error is thrown.
+     * @param spec DD spec.
+     * @param k the highest level to rebuild.
+     */
+    template <typename SPEC>
+    void rebuildBelow(DdSpecBase<SPEC> const& spec, int k) {
+        checkNoCheckpoint_();
+        if (k <= 0) {
+            return;
+        }
+        if (root_.row() <= static_cast<size_t>(k)) {
+            diagram = TableHandler<T>();
+            root_ = NodeId();
+            construct_(spec.entity());
+            return;
+        }
+
+        (*diagram).deleteIndex();
+        try {
+            DdBuilder<SPEC, T> zc(spec.entity(), diagram);
+            auto n = zc.initializeBelow(root_, static_cast<size_t>(k));
+
+            for (auto i = n; i > 0UL; --i) {
+                zc.construct(i);
+            }
+        } catch (...) {
+            diagram = TableHandler<T>();
+            root_ = NodeId();
+            throw;
+        }
+    }
+
     /**
      * ZDD subsetting.
      * @param spec ZDD spec.
      */
     template <typename SPEC>
     void zddSubset(SPEC const& spec) {
-#ifdef _OPENMP
-        if (useMP)
-            zddSubsetMP_(spec.entity());
-        else
-#endif
-            zddSubset_(spec.entity());
+        checkNoCheckpoint_();
+        zddSubset_(spec.entity());
     }
 
    private:
     template <typename SPEC>
     void zddSubset_(SPEC const& spec) {
         TableHandler<T>       tmpTable;
-        ZddSubsetter<T, SPEC> zs(diagram, spec, tmpTable);
+        ZddSubsetter<T, SPEC> zs(diagram, spec, tmpTable, executor_);
         int                   n = zs.initialize(root_);
 
         if (n > 0) {
@@ -145,6 +419,20 @@ class DdStructure : public DdSpec<DdStructure<T>, NodeId> {
     }
 
    public:
+    /**
+     * Sets the executor of construction, reduction and subsetting.
+     * Specs then must allow get_copy, get_child and destruct on distinct
+     * states concurrently.
+     * @param executor the executor, or nullptr to run on the calling thread.
+     */
+    void setExecutor(Executor* executor) { executor_ = executor; }
+
+    /**
+     * Gets the executor of construction, reduction and subsetting.
+     * @return the executor, or nullptr.
+     */
+    [[nodiscard]] Executor* getExecutor() const { return executor_; }
+
     /**
      * Gets the root node.
      * @return root node ID.
@@ -286,9 +574,10 @@ class DdStructure : public DdSpec<DdStructure<T>, NodeId> {
      */
     template <bool BDD, bool ZDD>
     void reduce() {
+        checkNoCheckpoint_();
         auto n = root_.row();
 
-        DdReducer<T, BDD, ZDD> zr(diagram);
+        DdReducer<T, BDD, ZDD> zr(diagram, executor_);
         zr.setRoot(root_);
 
         for (auto i : ranges::views::ints(1UL, n + 1)) {
@@ -345,6 +634,7 @@ class DdStructure : public DdSpec<DdStructure<T>, NodeId> {
             R retval{};
             return retval;
         }
+        DdProfile::Scope const profile(DdPhase::Evaluate, n);
 
         evaluator.initialize_root_node(work.node(1));
         for (auto& it : work | ranges::views::take(n + 1) |
@@ -366,6 +656,7 @@ class DdStructure : public DdSpec<DdStructure<T>, NodeId> {
             // fmt::print("empty DDstructure\n");
             return;
         }
+        DdProfile::Scope const profile(DdPhase::Evaluate, n);
 
         evaluator.initialize_root_node(work.node(1));
         // for (int i = 1; i <= n; ++i) {
@@ -377,6 +668,55 @@ class DdStructure : public DdSpec<DdStructure<T>, NodeId> {
         // }
     }
 
+    /**
+     * Backward evaluation whose wide levels are split among the threads of
+     * an executor. evalNode may then only read the children of its node and
+     * write to the node itself.
+     * @param evaluator the evaluator.
+     * @param executor the executor.
+     * @return the objective at the root.
+     */
+    template <typename R>
+    R evaluate_backward(Eval<T, R>& evaluator, Executor& executor) {
+        if (this->size() == 0) {
+            evaluator.set_table(&(*diagram));
+            R retval{};
+            return retval;
+        }
+        compute_labels_backward(evaluator, executor);
+        return evaluator.get_objective((*diagram).node(root()));
+    }
+
+    /**
+     * Backward labelling whose wide levels are split among the threads of
+     * an executor, with the restrictions of the parallel evaluate_backward.
+     * @param evaluator the evaluator.
+     * @param executor the executor.
+     */
+    template <typename R>
+    void compute_labels_backward(Eval<T, R>& evaluator, Executor& executor) {
+        auto  n = root_.row();
+        auto& work = *diagram;
+        evaluator.set_table(&work);
+
+        if (this->size() == 0) {
+            return;
+        }
+        DdProfile::Scope const profile(DdPhase::Evaluate, n);
+
+        evaluator.initialize_root_node(work.node(1));
+        for (auto i = 1UL; i <= n; ++i) {
+            auto& row = work[i];
+            forChunks(&executor, row.size(), EVAL_GRAIN, maxChunks(&executor),
+                      [&](size_t begin, size_t end, size_t) {
+                          for (auto j = begin; j < end; ++j) {
+                              evaluator.initialize_node(row[j]);
+                              evaluator.evalNode(row[j]);
+                          }
+                      });
+        }
+    }
+
     template <typename R>
     R evaluate_forward(Eval<T, R>& evaluator) {
         auto  n = root_.row();
@@ -388,6 +728,7 @@ class DdStructure : public DdSpec<DdStructure<T>, NodeId> {
             R retval;
             return retval;
         }
+        DdProfile::Scope const profile(DdPhase::Evaluate, n);
 
         /**
          * Initialize nodes of the DD
@@ -417,6 +758,65 @@ class DdStructure : public DdSpec<DdStructure<T>, NodeId> {
         return evaluator.get_objective(work.node(1));
     }
 
+    /**
+     * Forward evaluation restricted to the paths that can cost less than a
+     * cutoff, e.g. pricing, where only negative reduced costs matter.
+     * A node is expanded only if its cost from the root plus its completion
+     * bound is below @p cutoff. A level is initialized when an expanded node
+     * first reaches it, and levels that none reaches are skipped, so the
+     * sweep ends as soon as no path can beat the cutoff; if the root itself
+     * is pruned, nothing but the terminals is visited. Every path cheaper
+     * than the cutoff is fully evaluated, so the objective is exact when it
+     * beats the cutoff. Other labels are partial.
+     * @param evaluator the evaluator.
+     * @param cutoff the cost to beat.
+     * @return the objective at the 1-terminal, whose cost is not below
+     * @p cutoff if no path beats it.
+     */
+    template <typename R>
+    R evaluate_forward_bounded(BoundedEval<T, R>& evaluator, double cutoff) {
+        auto  n = root_.row();
+        auto& work = *diagram;
+        evaluator.set_table(&work);
+
+        if (this->size() == 0) {
+            R retval{};
+            return retval;
+        }
+        DdProfile::Scope const profile(DdPhase::Evaluate, n);
+
+        std::vector<bool> reached(n + 1);
+        auto const        reach = [&](size_t i) {
+            if (!reached[i]) {
+                reached[i] = true;
+                for (auto& it : work[i]) {
+                    evaluator.initialize_node(it);
+                }
+            }
+        };
+        reach(0);
+        reach(n);
+        evaluator.initialize_root_node(work.node(root()));
+
+        for (auto i = n; i > 0; --i) {
+            if (!reached[i]) {
+                continue;
+            }
+            for (auto& it : work[i]) {
+                if (!(evaluator.cost(it) + evaluator.completion_bound(it) <
+                      cutoff)) {
+                    continue;
+                }
+                for (auto const& f : it) {
+                    reach(f.row());
+                }
+                evaluator.evalNode(it);
+            }
+        }
+
+        return evaluator.get_objective(work.node(1));
+    }
+
     template <typename R>
     void compute_labels_forward(Eval<T, R>& evaluator) {
         auto  n = root_.row();
@@ -427,6 +827,7 @@ class DdStructure : public DdSpec<DdStructure<T>, NodeId> {
             // fmt::print("empty DDstructure\n");
             return;
         }
+        DdProfile::Scope const profile(DdPhase::Evaluate, n);
 
         /**
          * Initialize nodes of the DD
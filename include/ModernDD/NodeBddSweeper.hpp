@@ -30,9 +30,11 @@
 #include <ext/alloc_traits.h>  // for __alloc_traits<>::value_type
 #include <memory>              // for allocator_traits<>::value_type
 #include <vector>              // for vector
+#include "NodeBddProfile.hpp"  // for DdProfile, DdPhase
 #include "NodeBddTable.hpp"    // for NodeTableEntity
 #include "NodeBranchId.hpp"    // for NodeBranchId
 #include "NodeId.hpp"          // for NodeId
+#include "util/Executor.hpp"   // for Executor, forChunks, maxChunks
 
 /**
  * On-the-fly DD cleaner.
@@ -42,9 +44,11 @@
 template <typename T>
 class DdSweeper {
     static size_t const SWEEP_RATIO = 20;
+    static size_t const GRAIN = 4096;  ///< Least nodes per parallel chunk.
 
     NodeTableEntity<T>&        diagram;
     std::vector<NodeBranchId>* oneSrcPtr;
+    Executor*                  executor;
 
     std::vector<size_t> sweepLevel;
     std::vector<size_t> deadCount;
@@ -60,6 +64,7 @@ class DdSweeper {
     explicit DdSweeper(NodeTableEntity<T>& _diagram)
         : diagram(_diagram),
           oneSrcPtr(nullptr),
+          executor(nullptr),
           allCount(0),
           maxCount(0),
           rootPtr(nullptr) {}
@@ -68,11 +73,15 @@ class DdSweeper {
      * Constructor.
      * @param diagram the diagram to sweep.
      * @param oneSrcPtr collection of node branch IDs.
+     * @param _executor redirects the edges of wide levels in parallel;
+     * nullptr sweeps on the calling thread.
      */
     DdSweeper(NodeTableEntity<T>&        _diagram,
-              std::vector<NodeBranchId>& _oneSrcPtr)
+              std::vector<NodeBranchId>& _oneSrcPtr,
+              Executor*                  _executor = nullptr)
         : diagram(_diagram),
           oneSrcPtr(&_oneSrcPtr),
+          executor(_executor),
           allCount(0),
           maxCount(0),
           rootPtr(nullptr) {}
@@ -94,6 +103,7 @@ class DdSweeper {
         if (current <= 1) {
             return;
         }
+        DdProfile::Scope const profile(DdPhase::Sweep, current);
 
         if (size_t(current) >= sweepLevel.size()) {
             sweepLevel.resize(current + 1);
@@ -128,27 +138,33 @@ class DdSweeper {
             size_t m = diagram[i].size();
             newId[i].resize(m);
 
+            // redirect the edges; newId marks the live nodes with 1
+            forChunks(executor, m, GRAIN, maxChunks(executor),
+                      [&](size_t begin, size_t end, size_t) {
+                          for (auto j = begin; j < end; ++j) {
+                              T&   p = diagram[i][j];
+                              bool dead = true;
+
+                              for (auto b = 0UL; b < 2; ++b) {
+                                  auto& f = p[b];
+                                  if (f.row() >= k) {
+                                      f = newId[f.row()][f.col()];
+                                  }
+                                  if (f != 0) {
+                                      dead = false;
+                                  }
+                              }
+
+                              newId[i][j] = dead ? 0 : 1;
+                          }
+                      });
+
             size_t jj = 0;
 
             for (size_t j = 0; j < m; ++j) {
-                T&   p = diagram[i][j];
-                bool dead = true;
-
-                for (auto b = 0UL; b < 2; ++b) {
-                    auto& f = p[b];
-                    if (f.row() >= k) {
-                        f = newId[f.row()][f.col()];
-                    }
-                    if (f != 0) {
-                        dead = false;
-                    }
-                }
-
-                if (dead) {
-                    newId[i][j] = 0;
-                } else {
+                if (newId[i][j] != 0) {
                     newId[i][j] = NodeId(i, jj);
-                    diagram[i][jj] = p;
+                    diagram[i][jj] = diagram[i][j];
                     ++jj;
                 }
             }
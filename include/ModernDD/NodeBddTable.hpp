@@ -1,15 +1,20 @@
 #ifndef NODE_BDD_TABLE_HPP
 #define NODE_BDD_TABLE_HPP
 
+#include <algorithm>           // for min
 #include <cassert>             // for assert
 #include <cstddef>             // for size_t
 #include <memory>              // for allocator, allocator_traits<>::value_type
 #include <ostream>             // for operator<<, ostream, basic_ostream
 #include <stdexcept>           // for runtime_error
 #include <string>              // for operator<<, char_traits, string
+#include <type_traits>         // for decay_t, is_same_v
+#include <utility>             // for move
+#include <variant>             // for variant, visit
 #include <vector>              // for vector, _Bit_reference, vector<>::refe...
 #include "NodeId.hpp"          // for NodeId, operator<<
 #include "util/DataTable.hpp"  // for DataTable
+#include "util/Executor.hpp"   // for Executor, forChunks, maxChunks
 
 template <typename T>
 using data_table_node = DataTable<T>;
@@ -18,9 +23,35 @@ using my_vector = std::vector<T>;
 
 template <typename T>
 class NodeTableEntity : public data_table_node<T> {
+    static size_t const INDEX_GRAIN = 4096;  ///< Least nodes per index chunk.
+
     mutable my_vector<my_vector<size_t>> higherLevelTable;
     mutable my_vector<my_vector<size_t>> lowerLevelTable;
 
+    struct ChildWrite {
+        size_t row;
+        size_t col;
+        size_t b;
+        NodeId old;
+    };
+
+    struct NodeWrite {
+        size_t row;
+        size_t col;
+        T      old;
+    };
+
+    struct RowResize {
+        size_t       row;
+        size_t       size;
+        my_vector<T> removed;
+    };
+
+    using JournalEntry = std::variant<ChildWrite, NodeWrite, RowResize>;
+
+    my_vector<JournalEntry> journal;
+    my_vector<size_t>       checkpoints;
+
    public:
     /**
      * Constructor.
@@ -224,6 +255,138 @@ class NodeTableEntity : public data_table_node<T> {
         return f;
     }
 
+    /**
+     * Starts recording modifications made through setChild, setNode and
+     * resizeRow. Checkpoints nest.
+     */
+    void checkpoint() { checkpoints.push_back(journal.size()); }
+
+    /**
+     * Undoes the modifications since the latest checkpoint and removes it.
+     * Takes time proportional to the number of recorded modifications.
+     */
+    void rollback() {
+        if (checkpoints.empty()) {
+            throw std::runtime_error("NodeTableEntity: no checkpoint");
+        }
+
+        while (journal.size() > checkpoints.back()) {
+            std::visit(
+                [this](auto& e) {
+                    using E = std::decay_t<decltype(e)>;
+                    auto& row = (*this)[e.row];
+                    if constexpr (std::is_same_v<E, ChildWrite>) {
+                        row[e.col][e.b] = e.old;
+                    } else if constexpr (std::is_same_v<E, NodeWrite>) {
+                        row[e.col] = std::move(e.old);
+                    } else {
+                        row.resize(e.size - e.removed.size());
+                        for (auto& node : e.removed) {
+                            row.push_back(std::move(node));
+                        }
+                    }
+                },
+                journal.back());
+            journal.pop_back();
+        }
+
+        checkpoints.pop_back();
+        deleteIndex();
+    }
+
+    /**
+     * Removes the latest checkpoint and keeps its modifications, which an
+     * enclosing checkpoint can still undo.
+     */
+    void commit() {
+        if (checkpoints.empty()) {
+            throw std::runtime_error("NodeTableEntity: no checkpoint");
+        }
+
+        checkpoints.pop_back();
+        if (checkpoints.empty()) {
+            journal.clear();
+        }
+    }
+
+    /**
+     * Checks whether a checkpoint is open.
+     * @return true if modifications are being recorded.
+     */
+    [[nodiscard]] bool journaling() const { return !checkpoints.empty(); }
+
+    /**
+     * Returns the number of recorded modifications.
+     * @return the journal length.
+     */
+    [[nodiscard]] size_t journalSize() const { return journal.size(); }
+
+    /**
+     * Sets a child node ID, recording the old one if journaling.
+     * @param i parent row.
+     * @param j parent column.
+     * @param b child branch.
+     * @param f new child.
+     */
+    void setChild(size_t i, size_t j, size_t b, NodeId f) {
+        auto& old = child(i, j, b);
+        if (journaling()) {
+            journal.emplace_back(ChildWrite{i, j, b, old});
+        }
+        old = f;
+    }
+
+    /**
+     * Overwrites a node, recording the old one if journaling.
+     * @param i row.
+     * @param j column.
+     * @param node new content.
+     */
+    void setNode(size_t i, size_t j, T const& node) {
+        auto& old = (*this)[i][j];
+        if (journaling()) {
+            journal.emplace_back(NodeWrite{i, j, old});
+        }
+        old = node;
+    }
+
+    /**
+     * Resizes a row, recording the removed nodes if journaling.
+     * @param i row.
+     * @param m new size.
+     */
+    void resizeRow(size_t i, size_t m) {
+        auto& row = (*this)[i];
+        if (journaling() && m != row.size()) {
+            RowResize e{i, row.size(), {}};
+            if (m < row.size()) {
+                e.removed.assign(row.begin() + m, row.end());
+            }
+            journal.emplace_back(std::move(e));
+        }
+        row.resize(m);
+    }
+
+    /**
+     * Copies the child pointers of a row of a table of another node type.
+     * The row is allocated once and its nodes are default-constructed
+     * before their children are set.
+     * @param o the source table.
+     * @param i the row.
+     */
+    template <typename U>
+    void copyRowStructure(NodeTableEntity<U> const& o, size_t i) {
+        auto const& src = o[i];
+        auto&       row = (*this)[i];
+
+        row.clear();
+        row.resize(src.size());
+        for (auto j = 0UL; j < src.size(); ++j) {
+            row[j][0] = src[j][0];
+            row[j][1] = src[j][1];
+        }
+    }
+
     /**
      * Deletes current index information.
      */
@@ -232,11 +395,18 @@ class NodeTableEntity : public data_table_node<T> {
         lowerLevelTable.clear();
     }
 
+    /**
+     * Checks whether index information is available.
+     * @return true if higherLevels and lowerLevels need no scan.
+     */
+    [[nodiscard]] bool hasIndex() const { return !higherLevelTable.empty(); }
+
     /**
      * Makes index information.
-     * @param useMP use an algorithm for multiple processors.
+     * @param executor runs the scan of the wide levels; nullptr scans on the
+     * calling thread.
      */
-    void makeIndex(bool useMP = false) const {
+    void makeIndex(Executor* executor = nullptr) const {
         size_t const n = this->numRows() - 1;
         higherLevelTable.clear();
         higherLevelTable.resize(n + 1);
@@ -244,49 +414,52 @@ class NodeTableEntity : public data_table_node<T> {
         lowerLevelTable.resize(n + 1);
         my_vector<bool> lowerMark(n + 1);
 
+        struct Scan {
+            size_t            lowest;
+            my_vector<size_t> rows;  ///< Child levels not marked yet.
+        };
+        std::vector<Scan> scans(maxChunks(executor));
+
         for (auto i = n; i >= 1; --i) {
             auto const&     node = (*this)[i];
             auto const      m = node.size();
             auto            lowest = i;
             my_vector<bool> myLower(n + 1);
 
-            if (useMP) {
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-                for (intmax_t j = 0; j < intmax_t(m); ++j) {
-                    for (int b = 0; b < 2; ++b) {
-                        int const ii = node[j][b].row();
-                        if (ii == 0)
-                            continue;
-                        if (ii < lowest) {
-#pragma omp critical
-                            if (ii < lowest)
-                                lowest = ii;
-                        }
-                        if (!lowerMark[ii]) {
-                            myLower[ii] = true;
-                            lowerMark[ii] = true;
-                        }
-                    }
-                }
-#endif
-            } else {
-                for (size_t j = 0; j < m; ++j) {
-                    for (auto b = 0UL; b < 2; ++b) {
-                        auto const ii = node[j][b].row();
-
-                        if (ii == 0UL) {
-                            continue;
-                        }
-
-                        if (ii < lowest) {
-                            lowest = ii;
-                        }
-
-                        if (!lowerMark[ii]) {
-                            myLower[ii] = true;
-                            lowerMark[ii] = true;
-                        }
+            for (auto& it : scans) {
+                it.lowest = i;
+                it.rows.clear();
+            }
+            forChunks(executor, m, INDEX_GRAIN, scans.size(),
+                      [&](size_t begin, size_t end, size_t k) {
+                          auto& scan = scans[k];
+                          for (auto j = begin; j < end; ++j) {
+                              for (auto b = 0UL; b < 2; ++b) {
+                                  auto const ii = node[j][b].row();
+
+                                  if (ii == 0UL) {
+                                      continue;
+                                  }
+
+                                  if (ii < scan.lowest) {
+                                      scan.lowest = ii;
+                                  }
+
+                                  if (!lowerMark[ii] &&
+                                      (scan.rows.empty() ||
+                                       scan.rows.back() != ii)) {
+                                      scan.rows.push_back(ii);
+                                  }
+                              }
+                          }
+                      });
+
+            for (auto& scan : scans) {
+                lowest = std::min(lowest, scan.lowest);
+                for (auto ii : scan.rows) {
+                    if (!lowerMark[ii]) {
+                        myLower[ii] = true;
+                        lowerMark[ii] = true;
                     }
                 }
             }
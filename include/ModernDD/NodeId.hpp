@@ -1,9 +1,10 @@
 #ifndef NODE_ID_HPP
 #define NODE_ID_HPP
 
-#include <cstddef>  // for size_t
-#include <cstdint>  // for unint64_t
-#include <ostream>  // for operator <<, ostream, basic_ostream...
+#include <cstddef>              // for size_t
+#include <cstdint>              // for unint64_t
+#include <ostream>              // for operator <<, ostream, basic_ostream...
+#include "util/HashPolicy.hpp"  // for DdHash
 
 int const NODE_ROW_BITS = 20;
 int const NODE_ATTR_BITS = 1;
@@ -21,8 +22,6 @@ uint64_t const NODE_ATTR_MASK = uint64_t(1) << NODE_ATTR_OFFSET;
 class NodeId {
     uint64_t code_{};
 
-    static constexpr size_t HASH_CONSTANT = 314159257;
-
    public:
     NodeId() = default;
     // {  // 'code_' is not initialized in the default constructor for
@@ -59,7 +58,7 @@ class NodeId {
 
     [[nodiscard]] uint64_t code() const { return code_ & ~NODE_ATTR_MASK; }
 
-    [[nodiscard]] size_t hash() const { return code() * HASH_CONSTANT; }
+    [[nodiscard]] size_t hash() const { return DdHash::hash(code()); }
 
     bool operator==(NodeId const& o) const { return code() == o.code(); }
 
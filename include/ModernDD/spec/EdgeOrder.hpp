@@ -0,0 +1,376 @@
+#ifndef EDGE_ORDER_HPP
+#define EDGE_ORDER_HPP
+
+#include <algorithm>            // for sort, max, min, partial_sort, reverse
+#include <cstddef>              // for size_t
+#include <stdexcept>            // for runtime_error
+#include <tuple>                // for tuple, get
+#include <utility>              // for move
+#include <vector>               // for vector, erase_if
+#include "FrontierManager.hpp"  // for Graph
+
+/**
+ * An edge order and the frontier width it produces.
+ */
+struct EdgeOrder {
+    std::vector<int> edges;    ///< Indices of the edges of the graph, in order.
+    int              width{};  ///< Maximum frontier size.
+};
+
+/**
+ * Heuristics for edge orders of small frontier width.
+ * Every heuristic computes a vertex order, which is turned into an edge order
+ * by taking the vertices one by one and appending the edges to the vertices
+ * already taken, oldest first. The width of an order is known exactly
+ * before any diagram is built, and equals
+ * FrontierManager::maxFrontierSize() of the reordered graph.
+ */
+class EdgeOrderOptimizer {
+    Graph const                   g;
+    std::vector<std::vector<int>> adj;  ///< Neighbours of every vertex.
+
+    [[nodiscard]] int degree(int v) const {
+        return static_cast<int>(adj[v].size());
+    }
+
+    /**
+     * Runs a breadth-first search.
+     * @param start the start vertex.
+     * @param byDegree visit the neighbours in increasing order of degree.
+     * @param visited visited flags, updated.
+     * @param order visited vertices, appended.
+     */
+    void bfs(int                start,
+             bool               byDegree,
+             std::vector<char>& visited,
+             std::vector<int>&  order) const {
+        std::vector<int> next;
+
+        visited[start] = 1;
+        order.push_back(start);
+        for (auto i = order.size() - 1; i < order.size(); ++i) {
+            next.clear();
+            for (int u : adj[order[i]]) {
+                if (!visited[u]) {
+                    visited[u] = 1;
+                    next.push_back(u);
+                }
+            }
+            if (byDegree) {
+                std::sort(next.begin(), next.end(), [&](int a, int b) {
+                    return degree(a) < degree(b);
+                });
+            }
+            order.insert(order.end(), next.begin(), next.end());
+        }
+    }
+
+    /**
+     * Finds a pseudo-peripheral vertex of the component of a vertex by
+     * repeated breadth-first searches from a farthest vertex of least degree.
+     * @param v a vertex.
+     * @return the pseudo-peripheral vertex.
+     */
+    [[nodiscard]] int peripheral(int v) const {
+        std::vector<int> dist(g.numVertices(), -1);
+        std::vector<int> queue;
+        auto const       eccentricity = [&](int start) {
+            std::fill(dist.begin(), dist.end(), -1);
+            queue.assign(1, start);
+            dist[start] = 0;
+            for (auto i = 0UL; i < queue.size(); ++i) {
+                for (int u : adj[queue[i]]) {
+                    if (dist[u] < 0) {
+                        dist[u] = dist[queue[i]] + 1;
+                        queue.push_back(u);
+                    }
+                }
+            }
+            return dist[queue.back()];
+        };
+
+        int ecc = eccentricity(v);
+        while (true) {
+            int best = -1;
+            for (int u : queue) {
+                if (dist[u] == ecc && (best < 0 || degree(u) < degree(best))) {
+                    best = u;
+                }
+            }
+            int const e = eccentricity(best);
+            if (e <= ecc) {
+                return best;
+            }
+            ecc = e;
+        }
+    }
+
+    /**
+     * Computes a vertex order by breadth-first search of every component.
+     * @param byDegree visit the neighbours in increasing order of degree.
+     * @return the vertex order.
+     */
+    [[nodiscard]] std::vector<int> searchOrder(bool byDegree) const {
+        std::vector<char> visited(g.numVertices());
+        std::vector<int>  order;
+        for (int v = 0; v < g.numVertices(); ++v) {
+            if (!visited[v] && degree(v) > 0) {
+                bfs(peripheral(v), byDegree, visited, order);
+            }
+        }
+        return order;
+    }
+
+   public:
+    /**
+     * Constructor.
+     * @param _g the graph.
+     */
+    explicit EdgeOrderOptimizer(Graph const& _g)
+        : g(_g),
+          adj(_g.numVertices()) {
+        for (int e = 0; e < g.numEdges(); ++e) {
+            adj[g.edge(e).first].push_back(g.edge(e).second);
+            adj[g.edge(e).second].push_back(g.edge(e).first);
+        }
+        for (auto& a : adj) {
+            std::sort(a.begin(), a.end());
+        }
+    }
+
+    /**
+     * Computes the frontier width of an edge order in linear time.
+     * @param edges the edge order.
+     * @return the maximum frontier size.
+     */
+    [[nodiscard]] int width(std::vector<int> const& edges) const {
+        auto const       m = static_cast<int>(edges.size());
+        std::vector<int> first(g.numVertices(), -1);
+        std::vector<int> last(g.numVertices(), -1);
+        std::vector<int> delta(m + 1);
+
+        for (int k = 0; k < m; ++k) {
+            for (int v : {g.edge(edges[k]).first, g.edge(edges[k]).second}) {
+                if (first[v] < 0) {
+                    first[v] = k;
+                }
+                last[v] = k;
+            }
+        }
+        for (int v = 0; v < g.numVertices(); ++v) {
+            if (first[v] >= 0) {
+                ++delta[first[v]];
+                --delta[last[v] + 1];
+            }
+        }
+
+        int w = 0;
+        int current = 0;
+        for (int k = 0; k < m; ++k) {
+            current += delta[k];
+            w = std::max(w, current);
+        }
+        return w;
+    }
+
+    /**
+     * Turns a vertex order into an edge order.
+     * @param vertices the vertex order; vertices without edges may be
+     * omitted.
+     * @return the edge order and its width.
+     */
+    [[nodiscard]] EdgeOrder fromVertexOrder(
+        std::vector<int> const& vertices) const {
+        std::vector<int>              pos(g.numVertices(), -1);
+        std::vector<std::vector<int>> incident(g.numVertices());
+
+        for (auto i = 0UL; i < vertices.size(); ++i) {
+            pos[vertices[i]] = static_cast<int>(i);
+        }
+        for (int e = 0; e < g.numEdges(); ++e) {
+            auto [u, v] = g.edge(e);
+            if (pos[u] < 0 || pos[v] < 0) {
+                throw std::runtime_error(
+                    "EdgeOrderOptimizer: the vertex order misses a vertex");
+            }
+            incident[pos[u] > pos[v] ? u : v].push_back(e);
+        }
+
+        EdgeOrder result;
+        result.edges.reserve(g.numEdges());
+        for (int v : vertices) {
+            auto& list = incident[v];
+            auto  other = [&](int e) {
+                return pos[g.edge(e).first] + pos[g.edge(e).second] - pos[v];
+            };
+            std::sort(list.begin(), list.end(), [&](int a, int b) {
+                return other(a) < other(b);
+            });
+            result.edges.insert(result.edges.end(), list.begin(), list.end());
+        }
+        result.width = width(result.edges);
+        return result;
+    }
+
+    /**
+     * Breadth-first order from a pseudo-peripheral vertex of every
+     * component.
+     * @return the edge order and its width.
+     */
+    [[nodiscard]] EdgeOrder breadthFirst() const {
+        return fromVertexOrder(searchOrder(false));
+    }
+
+    /**
+     * Reverse Cuthill-McKee order: breadth-first with the neighbours taken
+     * in increasing order of degree, reversed.
+     * @return the edge order and its width.
+     */
+    [[nodiscard]] EdgeOrder cuthillMcKee() const {
+        auto order = searchOrder(true);
+        std::reverse(order.begin(), order.end());
+        return fromVertexOrder(order);
+    }
+
+    /**
+     * Beam search over vertex orders minimising the vertex separation, i.e.
+     * the number of taken vertices with neighbours not yet taken.
+     * Every step extends each kept order by a neighbour of its taken
+     * vertices and keeps the @p beamWidth best extensions. Each step copies
+     * the kept orders, so the cost grows quadratically with the number of
+     * vertices.
+     * @param beamWidth the number of orders kept at every step.
+     * @return the edge order and its width.
+     */
+    [[nodiscard]] EdgeOrder beam(size_t beamWidth = 8) const {
+        struct Partial {
+            std::vector<int>  order;
+            std::vector<char> taken;
+            std::vector<int>  open;      ///< Neighbours not taken yet.
+            std::vector<int>  frontier;  ///< Taken vertices with open > 0.
+            int               worst{};
+        };
+        using Score = std::tuple<int, int, int>;  // worst, frontier, open
+        struct Candidate {
+            Score  score;
+            size_t parent;
+            int    v;
+        };
+
+        auto const n = g.numVertices();
+        beamWidth = std::max<size_t>(beamWidth, 1);
+
+        std::vector<Partial> kept(1);
+        kept[0].taken.assign(n, 0);
+        kept[0].open.resize(n);
+        int active = 0;
+        for (int v = 0; v < n; ++v) {
+            kept[0].open[v] = degree(v);
+            active += (degree(v) > 0) ? 1 : 0;
+        }
+
+        std::vector<Candidate> candidates;
+        std::vector<char>      seen(n);
+        for (int step = 0; step < active; ++step) {
+            candidates.clear();
+            for (auto p = 0UL; p < kept.size(); ++p) {
+                auto const& x = kept[p];
+                auto const  size = static_cast<int>(x.frontier.size());
+                auto const  consider = [&](int v) {
+                    int closed = 0;
+                    for (int u : adj[v]) {
+                        closed += (x.taken[u] && x.open[u] == 1) ? 1 : 0;
+                    }
+                    int const f = size - closed + ((x.open[v] > 0) ? 1 : 0);
+                    Score     s{std::max(x.worst, size + 1), f, x.open[v]};
+                    candidates.push_back({s, p, v});
+                };
+
+                bool any = false;
+                for (int u : x.frontier) {
+                    for (int v : adj[u]) {
+                        if (!x.taken[v] && !seen[v]) {
+                            seen[v] = 1;
+                            consider(v);
+                            any = true;
+                        }
+                    }
+                }
+                for (int u : x.frontier) {
+                    for (int v : adj[u]) {
+                        seen[v] = 0;
+                    }
+                }
+                if (!any) {  // start a new component
+                    int start = -1;
+                    for (int v = 0; v < n; ++v) {
+                        if (!x.taken[v] && degree(v) > 0 &&
+                            (start < 0 || degree(v) < degree(start))) {
+                            start = v;
+                        }
+                    }
+                    consider(peripheral(start));
+                }
+            }
+
+            auto const keep = std::min(beamWidth, candidates.size());
+            std::partial_sort(candidates.begin(), candidates.begin() + keep,
+                              candidates.end(),
+                              [](Candidate const& a, Candidate const& b) {
+                                  return a.score < b.score;
+                              });
+
+            std::vector<Partial> next;
+            next.reserve(keep);
+            for (auto c = 0UL; c < keep; ++c) {
+                Partial   x = kept[candidates[c].parent];
+                int const v = candidates[c].v;
+                x.worst = std::get<0>(candidates[c].score);
+                x.taken[v] = 1;
+                x.order.push_back(v);
+                for (int u : adj[v]) {
+                    --x.open[u];
+                }
+                std::erase_if(x.frontier,
+                              [&](int u) { return x.open[u] == 0; });
+                if (x.open[v] > 0) {
+                    x.frontier.push_back(v);
+                }
+                next.push_back(std::move(x));
+            }
+            kept.swap(next);
+        }
+
+        return fromVertexOrder(kept.front().order);
+    }
+
+    /**
+     * Runs every heuristic and returns the narrowest order.
+     * @param beamWidth the number of orders kept by the beam search.
+     * @return the edge order and its width.
+     */
+    [[nodiscard]] EdgeOrder best(size_t beamWidth = 8) const {
+        EdgeOrder result = breadthFirst();
+        for (auto&& x : {cuthillMcKee(), beam(beamWidth)}) {
+            if (x.width < result.width) {
+                result = x;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Makes a copy of the graph with the edges in the given order.
+     * @param edges the edge order.
+     * @return the reordered graph.
+     */
+    [[nodiscard]] Graph apply(std::vector<int> const& edges) const {
+        Graph h(g.numVertices());
+        for (int e : edges) {
+            h.addEdge(g.edge(e).first, g.edge(e).second);
+        }
+        return h;
+    }
+};
+
+#endif  // EDGE_ORDER_HPP
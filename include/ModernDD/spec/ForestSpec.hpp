@@ -0,0 +1,125 @@
+#ifndef FOREST_SPEC_HPP
+#define FOREST_SPEC_HPP
+
+#include <algorithm>            // for min, max
+#include <cstdint>              // for int16_t, INT16_MAX
+#include <stdexcept>            // for runtime_error
+#include "../NodeBddSpec.hpp"   // for PodArrayDdSpec
+#include "FrontierManager.hpp"  // for FrontierManager, Graph
+
+/**
+ * Forests or spanning trees, as sets of edges.
+ * Slot k of the state holds the component of its vertex, labelled by the
+ * lowest slot of the component on the frontier, or FREE for unused slots.
+ * @tparam TREE true for spanning trees, false for all forests.
+ */
+template <bool TREE>
+class ComponentSpec
+    : public PodArrayDdSpec<ComponentSpec<TREE>, std::int16_t, 2> {
+   public:
+    using Comp = std::int16_t;
+
+    static Comp const FREE = -1;
+    static int const  MAX_WIDTH = INT16_MAX;
+
+   private:
+    FrontierManager fm;
+
+    /**
+     * Removes the vertices leaving after an edge from the frontier.
+     * @param comp the state.
+     * @param e the edge.
+     * @return false if a component of a spanning tree is closed too early.
+     */
+    bool leave(Comp* comp, int e) const {
+        bool ok = true;
+        fm.forEachLeaving(e, [&](int, int k) {
+            Comp const c = comp[k];
+            Comp       next = FREE;
+            bool       others = false;
+            comp[k] = FREE;
+            for (int j = 0; j < fm.maxFrontierSize(); ++j) {
+                if (comp[j] == c && next == FREE) {
+                    next = static_cast<Comp>(j);
+                }
+                others = others || comp[j] != FREE;
+            }
+            if (next == FREE) {  // the component is closed
+                ok = ok && !(TREE && (others || !fm.allEntered(e)));
+            } else if (c == k) {
+                for (int j = next; j < fm.maxFrontierSize(); ++j) {
+                    if (comp[j] == c) {
+                        comp[j] = next;
+                    }
+                }
+            }
+        });
+        return ok;
+    }
+
+   public:
+    /**
+     * Constructor.
+     * @param g the graph.
+     */
+    explicit ComponentSpec(Graph const& g) : fm(g) {
+        if (fm.maxFrontierSize() > MAX_WIDTH) {
+            throw std::runtime_error("ComponentSpec: the frontier is too wide");
+        }
+        this->setArraySize(fm.maxFrontierSize());
+    }
+
+    int getRoot(Comp* comp) const {
+        if (TREE && fm.numIsolated() > 0 && fm.numVertices() > 1) {
+            return 0;
+        }
+        if (fm.numEdges() == 0) {
+            return -1;
+        }
+        for (int k = 0; k < fm.maxFrontierSize(); ++k) {
+            comp[k] = FREE;
+        }
+        fm.forEachEntering(0, [&](int, int k) { comp[k] = k; });
+        return fm.numEdges();
+    }
+
+    int getChild(Comp* comp, int level, size_t value) const {
+        int const e = fm.edgeAt(level);
+        int const a = fm.slot1(e);
+        int const b = fm.slot2(e);
+
+        if (value) {
+            Comp const lo = std::min(comp[a], comp[b]);
+            Comp const hi = std::max(comp[a], comp[b]);
+            if (lo == hi) {
+                return 0;  // cycle
+            }
+            for (int j = hi; j < fm.maxFrontierSize(); ++j) {
+                if (comp[j] == hi) {
+                    comp[j] = lo;
+                }
+            }
+        }
+
+        if (!leave(comp, e)) {
+            return 0;
+        }
+        if (level == 1) {
+            return -1;
+        }
+        fm.forEachEntering(e + 1, [&](int, int k) { comp[k] = k; });
+        return level - 1;
+    }
+};
+
+/**
+ * All forests of a graph.
+ */
+using ForestSpec = ComponentSpec<false>;
+
+/**
+ * Spanning trees of a graph.
+ */
+using SpanningTreeSpec = ComponentSpec<true>;
+
+#endif  // FOREST_SPEC_HPP
@@ -0,0 +1,244 @@
+#ifndef FRONTIER_MANAGER_HPP
+#define FRONTIER_MANAGER_HPP
+
+#include <cstddef>    // for size_t
+#include <stdexcept>  // for runtime_error
+#include <utility>    // for pair
+#include <vector>     // for vector
+
+/**
+ * Undirected graph given by an ordered edge list.
+ * Vertices are numbered from 0; the order of the edges is the variable order
+ * of the frontier-based specs, edge e being decided at level m - e.
+ */
+class Graph {
+   public:
+    using Edge = std::pair<int, int>;
+
+   private:
+    int               numVertex;
+    std::vector<Edge> edges;
+
+   public:
+    /**
+     * Constructor.
+     * @param n the number of vertices.
+     */
+    explicit Graph(int n = 0) : numVertex(n) {}
+
+    /**
+     * Adds an edge at the end of the edge order.
+     * @param u an end vertex.
+     * @param v the other end vertex.
+     */
+    void addEdge(int u, int v) {
+        if (u < 0 || v < 0 || u >= numVertex || v >= numVertex || u == v) {
+            throw std::runtime_error("Graph: invalid edge");
+        }
+        edges.emplace_back(u, v);
+    }
+
+    [[nodiscard]] int numVertices() const { return numVertex; }
+
+    [[nodiscard]] int numEdges() const {
+        return static_cast<int>(edges.size());
+    }
+
+    [[nodiscard]] Edge const& edge(int e) const { return edges[e]; }
+
+    /**
+     * Makes a grid graph with row-major vertices and edges, the usual order
+     * with a frontier of cols + 1 vertices.
+     * @param rows the number of rows of vertices.
+     * @param cols the number of columns of vertices.
+     * @return the graph.
+     */
+    static Graph grid(int rows, int cols) {
+        Graph g(rows * cols);
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+                int const v = i * cols + j;
+                if (j + 1 < cols) {
+                    g.addEdge(v, v + 1);
+                }
+                if (i + 1 < rows) {
+                    g.addEdge(v, v + cols);
+                }
+            }
+        }
+        return g;
+    }
+
+    /**
+     * Makes a complete graph.
+     * @param n the number of vertices.
+     * @return the graph.
+     */
+    static Graph complete(int n) {
+        Graph g(n);
+        for (int u = 0; u < n; ++u) {
+            for (int v = u + 1; v < n; ++v) {
+                g.addEdge(u, v);
+            }
+        }
+        return g;
+    }
+};
+
+/**
+ * Frontier bookkeeping of a graph for frontier-based search.
+ * A vertex enters the frontier before its first edge is decided and leaves
+ * it after its last one. Every vertex occupies a fixed slot of the state
+ * array while it is on the frontier and the lowest free slot is taken first,
+ * so processing an edge only touches the slots of the vertices that enter or
+ * leave; nothing is shifted. Since the slot layout depends on the edge alone,
+ * equal frontier configurations have equal states.
+ */
+class FrontierManager {
+    struct EdgeInfo {
+        int    slot1{};     ///< Slot of the first end vertex.
+        int    slot2{};     ///< Slot of the second end vertex.
+        size_t entering{};  ///< Offset of the vertices entering before it.
+        size_t leaving{};   ///< Offset of the vertices leaving after it.
+    };
+
+    int                   numVertex{};
+    int                   numEdge{};
+    int                   width{};
+    int                   isolated{};
+    std::vector<EdgeInfo> info;
+    std::vector<int>      entering;  ///< Vertices, grouped by edge.
+    std::vector<int>      leaving;   ///< Vertices, grouped by edge.
+    std::vector<int>      slot;      ///< Slot of every vertex.
+
+   public:
+    /**
+     * Constructor.
+     * @param g the graph.
+     */
+    explicit FrontierManager(Graph const& g)
+        : numVertex(g.numVertices()),
+          numEdge(g.numEdges()),
+          info(numEdge + 1),
+          slot(numVertex, -1) {
+        std::vector<int> first(numVertex, -1);
+        std::vector<int> last(numVertex, -1);
+        for (int e = 0; e < numEdge; ++e) {
+            for (int v : {g.edge(e).first, g.edge(e).second}) {
+                if (first[v] < 0) {
+                    first[v] = e;
+                }
+                last[v] = e;
+            }
+        }
+
+        std::vector<bool> used;
+        for (int e = 0; e < numEdge; ++e) {
+            auto& x = info[e];
+            x.entering = entering.size();
+            for (int v : {g.edge(e).first, g.edge(e).second}) {
+                if (first[v] != e || slot[v] >= 0) {
+                    continue;
+                }
+                int k = 0;
+                while (k < static_cast<int>(used.size()) && used[k]) {
+                    ++k;
+                }
+                if (k == static_cast<int>(used.size())) {
+                    used.push_back(false);
+                }
+                used[k] = true;
+                slot[v] = k;
+                entering.push_back(v);
+            }
+            x.slot1 = slot[g.edge(e).first];
+            x.slot2 = slot[g.edge(e).second];
+
+            x.leaving = leaving.size();
+            for (int v : {g.edge(e).first, g.edge(e).second}) {
+                if (last[v] == e) {
+                    used[slot[v]] = false;
+                    leaving.push_back(v);
+                }
+            }
+        }
+        info[numEdge].entering = entering.size();
+        info[numEdge].leaving = leaving.size();
+        width = static_cast<int>(used.size());
+
+        for (int v = 0; v < numVertex; ++v) {
+            isolated += (first[v] < 0) ? 1 : 0;
+        }
+    }
+
+    [[nodiscard]] int numVertices() const { return numVertex; }
+
+    [[nodiscard]] int numEdges() const { return numEdge; }
+
+    /**
+     * Returns the number of slots of the state array.
+     * @return the maximum frontier size.
+     */
+    [[nodiscard]] int maxFrontierSize() const { return width; }
+
+    /**
+     * Returns the number of vertices without edges.
+     * @return the number of isolated vertices.
+     */
+    [[nodiscard]] int numIsolated() const { return isolated; }
+
+    /**
+     * Returns the slot of a vertex, or -1 if it has no edge.
+     * @param v the vertex.
+     * @return the slot.
+     */
+    [[nodiscard]] int slotOf(int v) const { return slot[v]; }
+
+    /**
+     * Returns the index of the edge decided at a level.
+     * @param level the level.
+     * @return the edge index.
+     */
+    [[nodiscard]] int edgeAt(int level) const { return numEdge - level; }
+
+    [[nodiscard]] int slot1(int e) const { return info[e].slot1; }
+
+    [[nodiscard]] int slot2(int e) const { return info[e].slot2; }
+
+    /**
+     * Checks if no vertex enters the frontier after an edge.
+     * @param e the edge.
+     * @return true if every vertex with an edge has entered by edge e.
+     */
+    [[nodiscard]] bool allEntered(int e) const {
+        return info[e + 1].entering == entering.size();
+    }
+
+    /**
+     * Calls f(v, slot) for every vertex that enters the frontier before an
+     * edge is decided.
+     * @param e the edge.
+     * @param f the function.
+     */
+    template <typename F>
+    void forEachEntering(int e, F&& f) const {
+        for (auto i = info[e].entering; i < info[e + 1].entering; ++i) {
+            f(entering[i], slot[entering[i]]);
+        }
+    }
+
+    /**
+     * Calls f(v, slot) for every vertex that leaves the frontier after an
+     * edge is decided.
+     * @param e the edge.
+     * @param f the function.
+     */
+    template <typename F>
+    void forEachLeaving(int e, F&& f) const {
+        for (auto i = info[e].leaving; i < info[e + 1].leaving; ++i) {
+            f(leaving[i], slot[leaving[i]]);
+        }
+    }
+};
+
+#endif  // FRONTIER_MANAGER_HPP
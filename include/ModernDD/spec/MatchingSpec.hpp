@@ -0,0 +1,67 @@
+#ifndef MATCHING_SPEC_HPP
+#define MATCHING_SPEC_HPP
+
+#include <cstdint>              // for uint8_t
+#include "../NodeBddSpec.hpp"   // for PodArrayDdSpec
+#include "FrontierManager.hpp"  // for FrontierManager, Graph
+
+/**
+ * Matchings or perfect matchings, as sets of edges.
+ * Slot k of the state is 1 if its vertex is matched, and 0 if it is not or
+ * the slot is unused.
+ */
+class MatchingSpec : public PodArrayDdSpec<MatchingSpec, std::uint8_t, 2> {
+    FrontierManager fm;
+    bool const      perfect;
+
+   public:
+    /**
+     * Constructor.
+     * @param g the graph.
+     * @param _perfect only accept perfect matchings.
+     */
+    explicit MatchingSpec(Graph const& g, bool _perfect = false)
+        : fm(g),
+          perfect(_perfect) {
+        setArraySize(fm.maxFrontierSize());
+    }
+
+    int getRoot(std::uint8_t* matched) const {
+        if (perfect && fm.numIsolated() > 0) {
+            return 0;
+        }
+        if (fm.numEdges() == 0) {
+            return -1;
+        }
+        for (int k = 0; k < fm.maxFrontierSize(); ++k) {
+            matched[k] = 0;
+        }
+        return fm.numEdges();
+    }
+
+    int getChild(std::uint8_t* matched, int level, size_t value) const {
+        int const e = fm.edgeAt(level);
+        int const a = fm.slot1(e);
+        int const b = fm.slot2(e);
+
+        if (value) {
+            if (matched[a] || matched[b]) {
+                return 0;
+            }
+            matched[a] = 1;
+            matched[b] = 1;
+        }
+
+        bool ok = true;
+        fm.forEachLeaving(e, [&](int, int k) {
+            ok = ok && (matched[k] || !perfect);
+            matched[k] = 0;
+        });
+        if (!ok) {
+            return 0;
+        }
+        return (level == 1) ? -1 : level - 1;
+    }
+};
+
+#endif  // MATCHING_SPEC_HPP
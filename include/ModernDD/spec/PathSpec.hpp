@@ -0,0 +1,204 @@
+#ifndef PATH_SPEC_HPP
+#define PATH_SPEC_HPP
+
+#include <cstdint>              // for int16_t, INT16_MAX
+#include <stdexcept>            // for runtime_error
+#include "../NodeBddSpec.hpp"   // for PodArrayDdSpec
+#include "FrontierManager.hpp"  // for FrontierManager, Graph
+
+/**
+ * Mate array shared by the path and cycle specs.
+ * Slot k of the state holds one of:
+ * - k: the vertex has degree 0, or the slot is unused;
+ * - DEG2: the vertex has degree 2, or it is a terminal of degree 1;
+ * - TERMINAL: a terminal of degree 0, or the end of a path from a terminal;
+ * - another slot j: the end of a path whose other end is in slot j.
+ */
+class MateFrontier {
+   public:
+    using Mate = std::int16_t;
+
+    static Mate const DEG2 = -1;
+    static Mate const TERMINAL = -2;
+    static int const  MAX_WIDTH = INT16_MAX;
+
+   protected:
+    FrontierManager fm;
+
+    explicit MateFrontier(Graph const& g) : fm(g) {
+        if (fm.maxFrontierSize() > MAX_WIDTH) {
+            throw std::runtime_error("MateFrontier: the frontier is too wide");
+        }
+    }
+
+    [[nodiscard]] static bool isEnd(Mate const* mate, int k) {
+        return mate[k] != k && mate[k] != DEG2;
+    }
+
+    /**
+     * Checks that no frontier vertex other than two given ones is the end of
+     * a path.
+     * @param mate the state.
+     * @param a a slot to skip.
+     * @param b the other slot to skip.
+     * @return true if no other path end exists.
+     */
+    [[nodiscard]] bool noOtherEnd(Mate const* mate, int a, int b) const {
+        for (int k = 0; k < fm.maxFrontierSize(); ++k) {
+            if (k != a && k != b && isEnd(mate, k)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Connects the vertices of two slots by an edge.
+     * @param mate the state.
+     * @param a the slot of an end vertex.
+     * @param b the slot of the other end vertex.
+     */
+    static void connect(Mate* mate, int a, int b) {
+        Mate const w1 = mate[a];
+        Mate const w2 = mate[b];
+        mate[a] = DEG2;
+        mate[b] = DEG2;
+        if (w1 >= 0) {
+            mate[w1] = w2;
+        }
+        if (w2 >= 0) {
+            mate[w2] = w1;
+        }
+    }
+
+    /**
+     * Removes the vertices leaving after an edge from the frontier.
+     * @param mate the state.
+     * @param e the edge.
+     * @return false if a path end leaves.
+     */
+    bool leave(Mate* mate, int e) const {
+        bool ok = true;
+        fm.forEachLeaving(e, [&](int, int k) {
+            ok = ok && !isEnd(mate, k);
+            mate[k] = static_cast<Mate>(k);
+        });
+        return ok;
+    }
+};
+
+/**
+ * Simple paths between two vertices, as sets of edges.
+ */
+class SimplePathSpec : public PodArrayDdSpec<SimplePathSpec,
+                                             MateFrontier::Mate,
+                                             2>,
+                       MateFrontier {
+    int const s;
+    int const t;
+
+    void enter(Mate* mate, int e) const {
+        fm.forEachEntering(e, [&](int v, int k) {
+            mate[k] = (v == s || v == t) ? TERMINAL : static_cast<Mate>(k);
+        });
+    }
+
+   public:
+    /**
+     * Constructor.
+     * @param g the graph.
+     * @param _s an end vertex of the paths.
+     * @param _t the other end vertex of the paths.
+     */
+    SimplePathSpec(Graph const& g, int _s, int _t)
+        : MateFrontier(g),
+          s(_s),
+          t(_t) {
+        if (s == t || s < 0 || t < 0 || s >= g.numVertices() ||
+            t >= g.numVertices()) {
+            throw std::runtime_error("SimplePathSpec: invalid end vertices");
+        }
+        setArraySize(fm.maxFrontierSize());
+    }
+
+    int getRoot(Mate* mate) const {
+        if (fm.slotOf(s) < 0 || fm.slotOf(t) < 0) {
+            return 0;
+        }
+        for (int k = 0; k < fm.maxFrontierSize(); ++k) {
+            mate[k] = static_cast<Mate>(k);
+        }
+        enter(mate, 0);
+        return fm.numEdges();
+    }
+
+    int getChild(Mate* mate, int level, size_t value) const {
+        int const e = fm.edgeAt(level);
+        int const a = fm.slot1(e);
+        int const b = fm.slot2(e);
+
+        if (value) {
+            if (mate[a] == DEG2 || mate[b] == DEG2 || mate[a] == b) {
+                return 0;  // degree 3 or cycle
+            }
+            if (mate[a] == TERMINAL && mate[b] == TERMINAL) {
+                return noOtherEnd(mate, a, b) ? -1 : 0;
+            }
+            connect(mate, a, b);
+        }
+
+        if (!leave(mate, e) || level == 1) {
+            return 0;
+        }
+        enter(mate, e + 1);
+        return level - 1;
+    }
+};
+
+/**
+ * Single cycles, as sets of edges.
+ */
+class CycleSpec : public PodArrayDdSpec<CycleSpec, MateFrontier::Mate, 2>,
+                  MateFrontier {
+   public:
+    /**
+     * Constructor.
+     * @param g the graph.
+     */
+    explicit CycleSpec(Graph const& g) : MateFrontier(g) {
+        setArraySize(fm.maxFrontierSize());
+    }
+
+    int getRoot(Mate* mate) const {
+        if (fm.numEdges() == 0) {
+            return 0;
+        }
+        for (int k = 0; k < fm.maxFrontierSize(); ++k) {
+            mate[k] = static_cast<Mate>(k);
+        }
+        return fm.numEdges();
+    }
+
+    int getChild(Mate* mate, int level, size_t value) const {
+        int const e = fm.edgeAt(level);
+        int const a = fm.slot1(e);
+        int const b = fm.slot2(e);
+
+        if (value) {
+            if (mate[a] == DEG2 || mate[b] == DEG2) {
+                return 0;
+            }
+            if (mate[a] == b) {  // the cycle is closed
+                return noOtherEnd(mate, a, b) ? -1 : 0;
+            }
+            connect(mate, a, b);
+        }
+
+        if (!leave(mate, e) || level == 1) {
+            return 0;
+        }
+        return level - 1;  // entering vertices have degree 0, like free slots
+    }
+};
+
+#endif  // PATH_SPEC_HPP
@@ -0,0 +1,122 @@
+#ifndef CANONICALIZER_HPP
+#define CANONICALIZER_HPP
+
+#include <algorithm>  // for sort, lexicographical_compare, swap_ranges
+#include <cstddef>    // for size_t
+
+/**
+ * Common canonicalizers for state arrays of DD specs.
+ * They are meant to be called from the canonicalize hook of a spec, which
+ * must only use those that are symmetries of its own state.
+ * None of them allocates memory.
+ */
+struct Canonicalizer {
+    /**
+     * Sorts a sub-array; for states in which the order of the entries is
+     * irrelevant, such as the loads of identical machines.
+     * @param a the array.
+     * @param n the number of entries.
+     */
+    template <typename T>
+    static void sortRange(T* a, size_t n) {
+        std::sort(a, a + n);
+    }
+
+    /**
+     * Sorts fixed-size blocks of a sub-array lexicographically; for
+     * interchangeable records of several entries.
+     * @param a the array.
+     * @param width the number of entries of a block.
+     * @param count the number of blocks.
+     */
+    template <typename T>
+    static void sortBlocks(T* a, size_t width, size_t count) {
+        for (auto i = 1UL; i < count; ++i) {
+            for (auto j = i; j > 0; --j) {
+                T* const p = a + (j - 1) * width;
+                T* const q = p + width;
+                if (!std::lexicographical_compare(q, q + width, p, p + width)) {
+                    break;
+                }
+                std::swap_ranges(p, q, q);
+            }
+        }
+    }
+
+    /**
+     * Renames labels in the order of their first occurrence.
+     * Entries smaller than @p first are flags and are not renamed; the
+     * others are replaced by first, first + 1, ... so that arrays that differ
+     * by a renaming of labels, such as component labels of a frontier,
+     * become equal.
+     * @param a the array.
+     * @param n the number of entries.
+     * @param first the smallest label.
+     */
+    template <typename T>
+    static void normalizeLabels(T* a, size_t n, T first = 1) {
+        T next = first;
+        for (auto i = 0UL; i < n; ++i) {
+            T const x = a[i];
+            if (x < next) {  // a flag or an assigned label
+                continue;
+            }
+            if (x != next) {
+                for (auto j = i; j < n; ++j) {
+                    if (a[j] == x) {
+                        a[j] = next;
+                    } else if (a[j] == next) {
+                        a[j] = x;
+                    }
+                }
+            }
+            ++next;
+        }
+    }
+
+    /**
+     * Replaces a mate array by its mirror image if that is lexicographically
+     * smaller; for frontiers whose remaining graph is symmetric under
+     * reversal of the frontier.
+     * Entries in [offset, offset + n) refer to positions of the array
+     * (position k is offset + k); the others are flags and are kept.
+     * @param mate the array.
+     * @param n the number of entries.
+     * @param offset the value that refers to the first position.
+     */
+    template <typename T>
+    static void mirrorMates(T* mate, size_t n, T offset = 0) {
+        auto const reflect = [&](T v) {
+            if (v < offset || v >= static_cast<T>(offset + n)) {
+                return v;
+            }
+            return static_cast<T>(offset + (n - 1) - (v - offset));
+        };
+
+        if (n == 0) {
+            return;
+        }
+
+        for (auto k = 0UL; k < n; ++k) {
+            T const x = mate[k];
+            T const y = reflect(mate[n - 1 - k]);
+            if (x < y) {
+                return;
+            }
+            if (y < x) {
+                break;
+            }
+        }
+
+        for (auto k = 0UL; k < n - 1 - k; ++k) {
+            T const x = reflect(mate[k]);
+            mate[k] = reflect(mate[n - 1 - k]);
+            mate[n - 1 - k] = x;
+        }
+        if (n % 2 == 1) {
+            mate[n / 2] = reflect(mate[n / 2]);
+        }
+    }
+};
+
+#endif  // CANONICALIZER_HPP
@@ -0,0 +1,235 @@
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#include <algorithm>           // for min, max
+#include <atomic>              // for atomic
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <exception>           // for exception_ptr, current_exception
+#include <functional>          // for function, ref
+#include <memory>              // for make_shared, shared_ptr
+#include <mutex>               // for mutex, lock_guard, unique_lock
+#include <utility>             // for move
+#ifdef _OPENMP
+#include <omp.h>  // for omp_get_max_threads
+#endif
+
+/**
+ * Runs the loops that the library parallelizes.
+ * Components that accept an Executor* run on the calling thread when it is
+ * nullptr, so that the library itself never starts threads unless asked to.
+ * parallel_for must tolerate being called from inside one of its own tasks.
+ */
+class Executor {
+   public:
+    Executor() = default;
+    Executor(Executor const&) = delete;
+    Executor& operator=(Executor const&) = delete;
+    Executor(Executor&&) = delete;
+    Executor& operator=(Executor&&) = delete;
+    virtual ~Executor() = default;
+
+    /**
+     * Gets the number of threads that run tasks concurrently.
+     * @return the concurrency, at least one.
+     */
+    [[nodiscard]] virtual size_t size() const = 0;
+
+    /**
+     * Runs f(i) for every 0 <= i < n and waits for completion.
+     * The first exception thrown by a task is rethrown after all tasks have
+     * finished.
+     * @param n the number of iterations.
+     * @param f the function.
+     */
+    template <typename F>
+    void parallel_for(size_t n, F&& f) {
+        if (n == 0) {
+            return;
+        }
+        std::function<void(size_t)> const g = std::ref(f);
+        run(n, g);
+    }
+
+   protected:
+    /**
+     * Runs f(i) for every 0 <= i < n and waits for completion.
+     * @param n the number of iterations, at least one.
+     * @param f the function.
+     */
+    virtual void run(size_t n, std::function<void(size_t)> const& f) = 0;
+};
+
+/**
+ * Executor running the loops as OpenMP parallel regions.
+ * Without OpenMP support the loops run on the calling thread.
+ */
+class OpenMpExecutor : public Executor {
+    size_t threads;
+
+   public:
+    /**
+     * Constructor.
+     * @param n the number of threads of every region; 0 takes the OpenMP
+     * default.
+     */
+    explicit OpenMpExecutor(size_t n = 0) {
+#ifdef _OPENMP
+        threads = (n == 0) ? static_cast<size_t>(omp_get_max_threads()) : n;
+#else
+        threads = std::max<size_t>(n, 1);
+#endif
+    }
+
+    [[nodiscard]] size_t size() const override { return threads; }
+
+   protected:
+    void run(size_t n, std::function<void(size_t)> const& f) override {
+        std::exception_ptr error;
+#ifdef _OPENMP
+        std::mutex errorMutex;
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+        for (long i = 0; i < static_cast<long>(n); ++i) {
+            try {
+                f(static_cast<size_t>(i));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+#else
+        for (auto i = 0UL; i < n; ++i) {
+            try {
+                f(i);
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+#endif
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+/**
+ * Executor running the loops on a thread pool owned by the caller, e.g. the
+ * pool of an application embedding the library.
+ * A loop submits up to size() - 1 helper tasks and the calling thread works
+ * on the loop too; iterations are claimed one at a time by whoever is free.
+ * The loop waits only for iterations that have been claimed, so it also
+ * completes when it is called from a worker of a saturated pool. Helpers
+ * that start after the loop has finished return at once.
+ */
+class ExternalExecutor : public Executor {
+   public:
+    using Submit = std::function<void(std::function<void()>)>;
+
+   private:
+    struct Loop {
+        std::function<void(size_t)> const* f;
+        size_t                              n;
+        std::atomic<size_t>                 next{0};
+        std::atomic<size_t>                 done{0};
+        std::mutex                          mtx;
+        std::condition_variable             finished;
+        std::exception_ptr                  error;
+
+        /**
+         * Runs iterations until none is left to claim.
+         */
+        void work() {
+            for (auto i = next++; i < n; i = next++) {
+                try {
+                    (*f)(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+                if (++done == n) {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    finished.notify_all();
+                }
+            }
+        }
+    };
+
+    Submit const submit;
+    size_t const threads;
+
+   public:
+    /**
+     * Constructor.
+     * @param _submit schedules a task on the caller's pool.
+     * @param _threads the number of threads of the pool.
+     */
+    ExternalExecutor(Submit _submit, size_t _threads)
+        : submit(std::move(_submit)),
+          threads(std::max<size_t>(_threads, 1)) {}
+
+    [[nodiscard]] size_t size() const override { return threads; }
+
+   protected:
+    void run(size_t n, std::function<void(size_t)> const& f) override {
+        auto loop = std::make_shared<Loop>();
+        loop->f = &f;
+        loop->n = n;
+
+        auto const helpers = std::min(threads, n) - 1;
+        for (auto k = 0UL; k < helpers; ++k) {
+            submit([loop] { loop->work(); });
+        }
+        loop->work();
+
+        std::unique_lock<std::mutex> lock(loop->mtx);
+        loop->finished.wait(lock, [&] { return loop->done == n; });
+        if (loop->error) {
+            std::rethrow_exception(loop->error);
+        }
+    }
+};
+
+/**
+ * Runs f(begin, end, k) over contiguous chunks of [0, n).
+ * Chunk k may own the k-th of @p maxChunks accumulators. The chunks run on
+ * the calling thread, as a single chunk, if @p executor is nullptr or n is
+ * below two grains.
+ * @param executor the executor, or nullptr.
+ * @param n the number of items.
+ * @param grain the least number of items per chunk.
+ * @param maxChunks the largest number of chunks.
+ * @param f the function.
+ */
+template <typename F>
+void forChunks(Executor* executor,
+               size_t    n,
+               size_t    grain,
+               size_t    maxChunks,
+               F&&       f) {
+    grain = std::max<size_t>(grain, 1);
+    auto const chunks = std::min(maxChunks, (n + grain - 1) / grain);
+    if (executor == nullptr || chunks <= 1) {
+        f(0UL, n, 0UL);
+        return;
+    }
+    executor->parallel_for(chunks, [&](size_t k) {
+        f(n * k / chunks, n * (k + 1) / chunks, k);
+    });
+}
+
+/**
+ * Gets the number of chunks that forChunks uses at most for an executor.
+ * @param executor the executor, or nullptr.
+ * @return four chunks per thread, or one on the calling thread.
+ */
+inline size_t maxChunks(Executor const* executor) {
+    return (executor == nullptr) ? 1UL : 4 * executor->size();
+}
+
+#endif  // EXECUTOR_HPP
@@ -0,0 +1,55 @@
+#ifndef FINGERPRINT_HPP
+#define FINGERPRINT_HPP
+
+#include <algorithm>       // for min
+#include <cstddef>         // for size_t
+#include <cstdint>         // for uint64_t
+#include <cstring>         // for memcpy
+#include "HashPolicy.hpp"  // for Mix64Hash
+
+/**
+ * 128-bit fingerprint of a byte string.
+ * The words of the string are folded into two lanes with different mixing
+ * steps, each ending with the MurmurHash3 finaliser. It is not a
+ * cryptographic hash: the collision bounds derived from it assume that the
+ * fingerprints of distinct strings behave as independent uniform values.
+ */
+struct Fingerprint {
+    uint64_t lo{};
+    uint64_t hi{};
+
+    bool operator==(Fingerprint const&) const = default;
+
+    /**
+     * Gets a hash code for hash tables; the low word is already uniform.
+     * @return the hash code.
+     */
+    [[nodiscard]] size_t hash() const { return lo; }
+
+    /**
+     * Computes the fingerprint of a byte string.
+     * @param p the first byte.
+     * @param n the number of bytes.
+     * @param seed distinguishes strings of different contexts.
+     * @return the fingerprint.
+     */
+    static Fingerprint of(void const* p, size_t n, uint64_t seed = 0) {
+        auto const* bytes = static_cast<unsigned char const*>(p);
+        uint64_t    a = 0x9e3779b97f4a7c15ULL ^ seed;
+        uint64_t    b = 0xc2b2ae3d27d4eb4fULL + seed;
+        for (size_t k = 0; k < n; k += sizeof(uint64_t)) {
+            uint64_t w = 0;
+            std::memcpy(&w, bytes + k, std::min(sizeof(w), n - k));
+            a = Mix64Hash::mix(a ^ w);
+            b = (((b << 27U) | (b >> 37U)) ^ w) * 0x9fb21c651e98df25ULL +
+                0x165667b19e3779f9ULL;
+        }
+        Fingerprint f{Mix64Hash::mix(a ^ n), Mix64Hash::mix(b ^ (a >> 1U))};
+        if (f == Fingerprint{}) {
+            f.lo = 1;  // the empty key of hash tables
+        }
+        return f;
+    }
+};
+
+#endif  // FINGERPRINT_HPP
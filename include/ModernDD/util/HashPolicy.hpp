@@ -0,0 +1,73 @@
+#ifndef HASH_POLICY_HPP
+#define HASH_POLICY_HPP
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t
+
+/**
+ * Hash policies for node IDs, nodes and spec states.
+ *
+ * A policy hashes a word with hash(x); a sequence of words is hashed by
+ * folding them into a seed of 0 with combine(h, x) and applying finish(h)
+ * to the result. A policy whose historical member is true keeps instead the
+ * formula every structure used before policies existed, bit for bit. The
+ * policy used by the library is chosen at compile time by defining
+ * MODERNDD_HASH_POLICY, e.g. -DMODERNDD_HASH_POLICY=Mix64Hash, and is
+ * available as DdHash.
+ */
+
+/**
+ * Multiplication by a constant, the historical hash of the library.
+ * It is the fastest but leaves the low bits of a hash depending only on the
+ * low bits of the words, so that node IDs differing in their row collide
+ * in power-of-two tables; prime-sized tables hide most of this.
+ * The fold below is that of the spec states; nodes keep boost's
+ * hash_combine, MyVector h * 31 + x, HybridDdSpec its premultiplied scalar
+ * state and the pair keys of DdChain and EdgeValuedDd their two-constant
+ * sums.
+ */
+struct MultiplicativeHash {
+    static constexpr bool   historical = true;
+    static constexpr size_t MULTIPLIER = 314159257;
+
+    static size_t hash(uint64_t x) { return x * MULTIPLIER; }
+
+    static size_t combine(size_t h, uint64_t x) { return (h + x) * MULTIPLIER; }
+
+    static size_t finish(size_t h) { return h; }
+};
+
+/**
+ * Strong 64-bit mixing: words are folded by a rotate-xor-multiply step and
+ * the result goes through the MurmurHash3 finaliser, so that every input
+ * bit affects every output bit. It costs a few more cycles per hash than
+ * MultiplicativeHash but not per word.
+ */
+struct Mix64Hash {
+    static constexpr bool historical = false;
+
+    static size_t mix(uint64_t x) {
+        x ^= x >> 33U;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33U;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33U;
+        return x;
+    }
+
+    static size_t hash(uint64_t x) { return mix(x); }
+
+    static size_t combine(size_t h, uint64_t x) {
+        return (((h << 5U) | (h >> 59U)) ^ x) * 0x517cc1b727220a95ULL;
+    }
+
+    static size_t finish(size_t h) { return mix(h); }
+};
+
+#ifndef MODERNDD_HASH_POLICY
+#define MODERNDD_HASH_POLICY MultiplicativeHash
+#endif
+
+using DdHash = MODERNDD_HASH_POLICY;
+
+#endif  // HASH_POLICY_HPP
@@ -28,11 +28,12 @@
 // #include <stdint.h>
 // #include <cassert>
 // #include <ostream>
-#include <stddef.h>   // for size_t
-#include <stdint.h>   // for int16_t, int32_t, int64_t, int8_t, uint16_t
-#include <algorithm>  // for max
-#include <cassert>    // for assert
-#include <ostream>    // for operator<<, ostream
+#include <stddef.h>        // for size_t
+#include <stdint.h>        // for int16_t, int32_t, int64_t, int8_t, uint16_t
+#include <algorithm>       // for max
+#include <cassert>         // for assert
+#include <ostream>         // for operator<<, ostream
+#include "HashPolicy.hpp"  // for DdHash
 
 // namespace tdzdd {
 
@@ -95,7 +96,9 @@ struct MyHashDefault<T*> {
 
 template <typename T>
 struct MyHashDefaultForInt {
-    size_t operator()(T k) const { return k * 314159257ULL; }
+    size_t operator()(T k) const {
+        return DdHash::hash(static_cast<uint64_t>(k));
+    }
 
     bool operator()(T k1, T k2) const { return k1 == k2; }
 };
@@ -29,17 +29,151 @@
 #include <cstring>
 #include <iostream>
 #include <stdexcept>
+#include <vector>
 
 // namespace tdzdd {
 
+/**
+ * Opt-in reuse of the memory blocks of MyList on the calling thread.
+ * While an instance lives, the blocks released by the lists of the thread
+ * are kept, up to MAX_BLOCKS blocks and MAX_CELLS cells per list type, and
+ * handed out again to lists of the same block size, so that consecutive
+ * builds on one thread reuse their memory. Instances nest; the kept blocks
+ * are freed when the outermost one is destroyed. Outside of any instance,
+ * blocks are allocated and freed directly.
+ */
+class MyListBlockReuse {
+    using Drain = void (*)();
+
+    static int& depth() {
+        thread_local int d = 0;
+        return d;
+    }
+
+    static std::vector<Drain>& drains() {
+        thread_local std::vector<Drain> v;
+        return v;
+    }
+
+   public:
+    static size_t const MAX_BLOCKS = 64;
+    static size_t const MAX_CELLS = size_t(1) << 20;
+
+    MyListBlockReuse() { ++depth(); }
+
+    ~MyListBlockReuse() {
+        if (--depth() == 0) {
+            for (auto drain : drains()) {
+                drain();
+            }
+        }
+    }
+
+    MyListBlockReuse(MyListBlockReuse const&) = delete;
+    MyListBlockReuse& operator=(MyListBlockReuse const&) = delete;
+    MyListBlockReuse(MyListBlockReuse&&) = delete;
+    MyListBlockReuse& operator=(MyListBlockReuse&&) = delete;
+
+    /**
+     * Checks whether released blocks are kept on the calling thread.
+     * @return true inside an instance.
+     */
+    static bool active() { return depth() > 0; }
+
+    /**
+     * Registers a function freeing the blocks kept for a list type.
+     * @param drain the function, called when the outermost instance ends.
+     */
+    static void onExit(Drain drain) { drains().push_back(drain); }
+};
+
 template <typename T, size_t BLOCK_ELEMENTS = 1000>
 class MyList {
-    static int const headerCells = 1;
+    static int const headerCells = 2;
 
     struct Cell {
         Cell* next;
     };
 
+    /*
+     * Blocks kept by MyListBlockReuse for this list type on one thread.
+     * The first cell of a block records its size.
+     */
+    class BlockCache {
+        std::vector<Cell*> blocks;
+        size_t             cells{};
+
+       public:
+        BlockCache() { MyListBlockReuse::onExit(&drain); }
+        BlockCache(BlockCache const&) = delete;
+        BlockCache& operator=(BlockCache const&) = delete;
+        BlockCache(BlockCache&&) = delete;
+        BlockCache& operator=(BlockCache&&) = delete;
+
+        ~BlockCache() { clear(); }
+
+        void clear() {
+            for (auto* block : blocks) {
+                delete[] block;
+            }
+            blocks.clear();
+            cells = 0;
+        }
+
+        Cell* get(size_t m) {
+            for (auto k = blocks.size(); k > 0; --k) {
+                Cell* block = blocks[k - 1];
+                if (blockSize(block) == m) {
+                    blocks[k - 1] = blocks.back();
+                    blocks.pop_back();
+                    cells -= m;
+                    return block;
+                }
+            }
+            return newBlock(m);
+        }
+
+        void put(Cell* block) {
+            auto const m = blockSize(block);
+            if (blocks.size() == MyListBlockReuse::MAX_BLOCKS ||
+                cells + m > MyListBlockReuse::MAX_CELLS) {
+                delete[] block;
+                return;
+            }
+            blocks.push_back(block);
+            cells += m;
+        }
+    };
+
+    static void drain() { cache().clear(); }
+
+    static Cell* newBlock(size_t m) {
+        Cell* block = new Cell[m];
+        block->next = reinterpret_cast<Cell*>(m);
+        return block;
+    }
+
+    static BlockCache& cache() {
+        thread_local BlockCache c;
+        return c;
+    }
+
+    static size_t blockSize(Cell const* block) {
+        return reinterpret_cast<size_t>(block->next);
+    }
+
+    static Cell* acquireBlock(size_t m) {
+        return MyListBlockReuse::active() ? cache().get(m) : newBlock(m);
+    }
+
+    static void releaseBlock(Cell* block) {
+        if (MyListBlockReuse::active()) {
+            cache().put(block);
+        } else {
+            delete[] block;
+        }
+    }
+
     Cell*  front_;
     size_t size_;
 
@@ -118,7 +252,7 @@ class MyList {
                 p = p->next;
             }
 
-            delete[] blockStart(front_);
+            releaseBlock(blockStart(front_));
             front_ = clearFlag(p);
         }
         size_ = 0;
@@ -148,9 +282,9 @@ class MyList {
 
         if (front_ == 0 || front_ < blockStart(front_) + headerCells + n) {
             size_t const m = headerCells + n * BLOCK_ELEMENTS;
-            Cell*        newBlock = new Cell[m];
-            Cell*        newFront = newBlock + m - n;
-            blockStart(newFront) = newBlock;
+            Cell*        block = acquireBlock(m);
+            Cell*        newFront = block + m - n;
+            blockStart(newFront) = block;
             newFront->next = setFlag(front_);
             front_ = newFront;
         } else {
@@ -172,7 +306,7 @@ class MyList {
         Cell* next = front_->next;
 
         if (flagged(next)) {
-            delete[] blockStart(front_);
+            releaseBlock(blockStart(front_));
             front_ = clearFlag(next);
         } else {
             blockStart(next) = blockStart(front_);
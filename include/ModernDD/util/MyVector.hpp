@@ -25,11 +25,12 @@
 #ifndef MY_VECTOR_HPP
 #define MY_VECTOR_HPP
 
-#include <cassert>   // for assert
-#include <cstring>   // for memmove, size_t
-#include <iostream>  // for operator<<, ostream
-#include <new>       // for operator new
-#include <vector>    // for allocator, vector
+#include <cassert>         // for assert
+#include <cstring>         // for memmove, size_t
+#include <iostream>        // for operator<<, ostream
+#include <new>             // for operator new
+#include <vector>          // for allocator, vector
+#include "HashPolicy.hpp"  // for DdHash
 
 template <typename T, typename Size = size_t>
 class MyVector {
@@ -463,9 +464,13 @@ class MyVector {
     size_t hash() const {
         size_t h = size_;
         for (Size i = 0; i < size_; ++i) {
-            h = h * 31 + array_[i].hash();
+            if constexpr (DdHash::historical) {
+                h = h * 31 + array_[i].hash();
+            } else {
+                h = DdHash::combine(h, array_[i].hash());
+            }
         }
-        return h;
+        return DdHash::finish(h);
     }
 
     /**
@@ -0,0 +1,146 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <array>    // for array
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t
+#include <cstring>  // for memset
+
+#ifdef __linux__
+#include <linux/perf_event.h>  // for perf_event_attr, PERF_*
+#include <sys/syscall.h>       // for SYS_perf_event_open
+#include <unistd.h>            // for syscall, read, close
+#endif
+
+/**
+ * Events counted by PerfCounters.
+ * TaskClock is a software event in nanoseconds that is normally available
+ * even where the hardware events are not, e.g. in virtual machines.
+ */
+enum class PerfEvent : size_t {
+    TaskClock,
+    Cycles,
+    Instructions,
+    LlcMisses,
+    BranchMisses,
+    DtlbMisses,
+};
+
+inline constexpr size_t PERF_EVENT_COUNT = 6;
+
+inline constexpr std::array<char const*, PERF_EVENT_COUNT> PERF_EVENT_NAMES{
+    "task-clock", "cycles",        "instructions",
+    "llc-misses", "branch-misses", "dtlb-misses"};
+
+/**
+ * Accumulated event counts.
+ */
+struct PerfSample {
+    std::array<uint64_t, PERF_EVENT_COUNT> value{};
+    uint64_t                               calls{};
+
+    uint64_t operator[](PerfEvent e) const {
+        return value[static_cast<size_t>(e)];
+    }
+
+    PerfSample& operator+=(PerfSample const& o) {
+        for (auto k = 0UL; k < PERF_EVENT_COUNT; ++k) {
+            value[k] += o.value[k];
+        }
+        calls += o.calls;
+        return *this;
+    }
+};
+
+/**
+ * Per-thread hardware performance counters through Linux perf_event_open.
+ * Every event is opened separately for the calling thread in user space
+ * only, so that an event the kernel or the hypervisor refuses leaves the
+ * others working; the counters of unavailable events read as 0. On other
+ * systems no event is available. When the kernel multiplexes the events,
+ * the counts are scaled by the fraction of time they were scheduled.
+ */
+class PerfCounters {
+    std::array<int, PERF_EVENT_COUNT> fd{};
+
+#ifdef __linux__
+    static int open(uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format =
+            PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(
+            syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static constexpr uint64_t cacheMiss(uint64_t cache) {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8U) |
+               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U);
+    }
+#endif
+
+   public:
+    PerfCounters() {
+        fd.fill(-1);
+#ifdef __linux__
+        fd[0] = open(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK);
+        fd[1] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        fd[2] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fd[3] = open(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL));
+        fd[4] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        fd[5] = open(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB));
+#endif
+    }
+
+    PerfCounters(PerfCounters const&) = delete;
+    PerfCounters& operator=(PerfCounters const&) = delete;
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (auto f : fd) {
+            if (f >= 0) {
+                ::close(f);
+            }
+        }
+#endif
+    }
+
+    /**
+     * Checks whether an event is counted.
+     * @param e the event.
+     * @return true if the event could be opened.
+     */
+    [[nodiscard]] bool available(PerfEvent e) const {
+        return fd[static_cast<size_t>(e)] >= 0;
+    }
+
+    /**
+     * Reads the counts since the counters were opened.
+     * @return the counts, 0 for unavailable events.
+     */
+    [[nodiscard]] std::array<uint64_t, PERF_EVENT_COUNT> read() const {
+        std::array<uint64_t, PERF_EVENT_COUNT> result{};
+#ifdef __linux__
+        for (auto k = 0UL; k < PERF_EVENT_COUNT; ++k) {
+            uint64_t buf[3]{};  // value, time enabled, time running
+            if (fd[k] < 0 || ::read(fd[k], buf, sizeof(buf)) !=
+                                 static_cast<ssize_t>(sizeof(buf))) {
+                continue;
+            }
+            result[k] = (buf[2] == 0 || buf[2] == buf[1])
+                            ? buf[0]
+                            : static_cast<uint64_t>(
+                                  static_cast<long double>(buf[0]) * buf[1] /
+                                  buf[2]);
+        }
+#endif
+        return result;
+    }
+};
+
+#endif  // PERF_COUNTERS_HPP
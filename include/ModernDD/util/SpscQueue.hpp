@@ -0,0 +1,103 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <array>    // for array
+#include <atomic>   // for atomic, memory_order_acquire, memory_order_release
+#include <cstddef>  // for size_t
+
+/**
+ * Unbounded lock-free single-producer single-consumer queue.
+ * Elements are stored in a linked list of fixed-size blocks; a block is
+ * released by the consumer as soon as it has been drained.
+ * @tparam T type of elements.
+ * @tparam BLOCK_ELEMENTS the number of elements per block.
+ */
+template <typename T, size_t BLOCK_ELEMENTS = 1024>
+class SpscQueue {
+    struct Block {
+        std::array<T, BLOCK_ELEMENTS> data{};
+        std::atomic<Block*>           next{nullptr};
+    };
+
+    static size_t const CACHE_LINE = 64;
+
+    alignas(CACHE_LINE) Block* tail;
+    size_t                     tailPos{};
+    size_t                     pushCount{};
+
+    alignas(CACHE_LINE) Block* head;
+    size_t                     headPos{};
+    size_t                     popCount{};
+
+    alignas(CACHE_LINE) std::atomic<size_t> published{0};
+    std::atomic<bool>                       closed_{false};
+
+   public:
+    SpscQueue() : tail(new Block), head(tail) {}
+
+    SpscQueue(const SpscQueue<T, BLOCK_ELEMENTS>&) = delete;
+    SpscQueue<T, BLOCK_ELEMENTS>& operator=(
+        const SpscQueue<T, BLOCK_ELEMENTS>&) = delete;
+    SpscQueue(SpscQueue<T, BLOCK_ELEMENTS>&&) = delete;
+    SpscQueue<T, BLOCK_ELEMENTS>& operator=(SpscQueue<T, BLOCK_ELEMENTS>&&) =
+        delete;
+
+    ~SpscQueue() {
+        while (head != nullptr) {
+            Block* next = head->next.load(std::memory_order_relaxed);
+            delete head;
+            head = next;
+        }
+    }
+
+    /**
+     * Appends an element; called by the producer only.
+     * @param elem the element.
+     */
+    void push(T const& elem) {
+        if (tailPos == BLOCK_ELEMENTS) {
+            auto* block = new Block;
+            tail->next.store(block, std::memory_order_release);
+            tail = block;
+            tailPos = 0;
+        }
+        tail->data[tailPos++] = elem;
+        published.store(++pushCount, std::memory_order_release);
+    }
+
+    /**
+     * Marks the end of the stream; called by the producer only.
+     */
+    void close() { closed_.store(true, std::memory_order_release); }
+
+    /**
+     * Checks whether the producer has closed the stream.
+     * Elements pushed before close() may still be pending.
+     * @return true if closed.
+     */
+    [[nodiscard]] bool closed() const {
+        return closed_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Removes the first element if any; called by the consumer only.
+     * @param elem result storage.
+     * @return false if the queue is currently empty.
+     */
+    bool pop(T& elem) {
+        if (popCount == published.load(std::memory_order_acquire)) {
+            return false;
+        }
+        if (headPos == BLOCK_ELEMENTS) {
+            Block* next = head->next.load(std::memory_order_acquire);
+            delete head;
+            head = next;
+            headPos = 0;
+        }
+        elem = head->data[headPos++];
+        ++popCount;
+        return true;
+    }
+};
+
+#endif  // SPSC_QUEUE_HPP
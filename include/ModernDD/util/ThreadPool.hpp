@@ -0,0 +1,237 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>           // for max
+#include <atomic>              // for atomic
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <deque>               // for deque
+#include <exception>           // for exception_ptr, current_exception
+#include <functional>          // for function
+#include <limits>              // for numeric_limits
+#include <memory>              // for unique_ptr, make_unique
+#include <mutex>               // for mutex, lock_guard, unique_lock
+#include <stdexcept>           // for runtime_error
+#include <string>              // for to_string
+#include <thread>              // for thread, hardware_concurrency
+#include <utility>             // for move
+#include <vector>              // for vector
+#include "Executor.hpp"        // for Executor
+#ifdef __linux__
+#include <pthread.h>  // for pthread_setaffinity_np
+#include <sched.h>    // for cpu_set_t, CPU_SET, CPU_ZERO
+#endif
+
+/**
+ * Fixed-size thread pool with work stealing.
+ * Every worker owns a task deque; it takes its own tasks from the back and
+ * steals from the front of the others when it runs out of work.
+ * Threads waiting in parallel_for execute pending tasks, so that it can be
+ * nested inside tasks without deadlock. It is the default Executor.
+ */
+class ThreadPool : public Executor {
+    struct TaskQueue {
+        std::mutex                        mtx;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread>                threads;
+    std::mutex                              sleepMutex;
+    std::condition_variable                 wakeUp;
+    std::atomic<size_t>                     pending{0};
+    std::atomic<size_t>                     nextQueue{0};
+    bool                                    stopping{false};
+
+    static ThreadPool*& currentPool() {
+        thread_local ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    static size_t& currentIndex() {
+        thread_local size_t index = 0;
+        return index;
+    }
+
+    bool take(size_t k, bool back, std::function<void()>& task) {
+        auto&                       q = *queues[k];
+        std::lock_guard<std::mutex> lock(q.mtx);
+        if (q.tasks.empty()) {
+            return false;
+        }
+        if (back) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+        } else {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        }
+        --pending;
+        return true;
+    }
+
+    /**
+     * Runs one pending task if any.
+     * @return false if no task was found.
+     */
+    bool runPendingTask() {
+        std::function<void()> task;
+        auto const            n = queues.size();
+        auto const            self = (currentPool() == this) ? currentIndex()
+                                                             : nextQueue % n;
+
+        if (currentPool() == this && take(self, true, task)) {
+            task();
+            return true;
+        }
+        for (auto k = 0UL; k < n; ++k) {
+            if (take((self + k) % n, false, task)) {
+                task();
+                return true;
+            }
+        }
+        return false;
+    }
+
+#ifdef __linux__
+    static constexpr int MAX_CPU = CPU_SETSIZE;
+#else
+    static constexpr int MAX_CPU = std::numeric_limits<int>::max();
+#endif
+
+    static void pin(int cpu) {
+#ifdef __linux__
+        if (cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+#endif
+    }
+
+    void workerLoop(size_t index, int cpu) {
+        pin(cpu);
+        currentPool() = this;
+        currentIndex() = index;
+
+        while (true) {
+            if (runPendingTask()) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeUp.wait(lock, [&] { return stopping || pending > 0; });
+            if (stopping && pending == 0) {
+                return;
+            }
+        }
+    }
+
+   public:
+    /**
+     * Starts the workers.
+     * @param n the number of worker threads; at least one is started.
+     */
+    explicit ThreadPool(size_t n = std::thread::hardware_concurrency())
+        : ThreadPool(n, {}) {}
+
+    /**
+     * Starts the workers pinned to CPUs.
+     * Worker k runs on cpus[k % cpus.size()]; an empty list leaves the
+     * placement to the scheduler. Pinning is only done on Linux.
+     * @param n the number of worker threads; at least one is started.
+     * @param cpus the CPU numbers.
+     * @exception std::runtime_error a CPU number is out of range.
+     */
+    ThreadPool(size_t n, std::vector<int> const& cpus) {
+        for (auto cpu : cpus) {
+            if (cpu < 0 || cpu >= MAX_CPU) {
+                throw std::runtime_error("ThreadPool: invalid CPU number " +
+                                         std::to_string(cpu));
+            }
+        }
+        n = std::max<size_t>(n, 1);
+        for (auto k = 0UL; k < n; ++k) {
+            queues.emplace_back(std::make_unique<TaskQueue>());
+        }
+        for (auto k = 0UL; k < n; ++k) {
+            auto const cpu = cpus.empty() ? -1 : cpus[k % cpus.size()];
+            threads.emplace_back([this, k, cpu] { workerLoop(k, cpu); });
+        }
+    }
+
+    ~ThreadPool() override {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /**
+     * Returns the number of worker threads.
+     * @return the number of worker threads.
+     */
+    [[nodiscard]] size_t size() const override { return threads.size(); }
+
+    /**
+     * Schedules a task.
+     * Tasks submitted by a worker go to its own deque; others are
+     * distributed round-robin.
+     * @param task the task.
+     */
+    void submit(std::function<void()> task) {
+        auto const k = (currentPool() == this) ? currentIndex()
+                                               : nextQueue++ % queues.size();
+        {
+            std::lock_guard<std::mutex> lock(queues[k]->mtx);
+            queues[k]->tasks.push_back(std::move(task));
+            ++pending;
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wakeUp.notify_one();
+    }
+
+   protected:
+    void run(size_t n, std::function<void(size_t)> const& f) override {
+        std::atomic<size_t> remaining{n};
+        std::exception_ptr  error;
+        std::mutex          errorMutex;
+
+        for (auto i = 0UL; i < n; ++i) {
+            submit([&, i] {
+                try {
+                    f(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+                --remaining;
+            });
+        }
+
+        while (remaining > 0) {
+            if (!runPendingTask()) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+#endif  // THREAD_POOL_HPP
@@ -0,0 +1,287 @@
+#ifndef TRANSPORT_HPP
+#define TRANSPORT_HPP
+
+#include <poll.h>        // for poll, pollfd, POLLIN, POLLOUT
+#include <sys/socket.h>  // for socketpair, send, recv, AF_UNIX
+#include <unistd.h>      // for close
+#include <cerrno>        // for errno, EINTR, EAGAIN, ECONNRESET
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint64_t
+#include <cstring>       // for memcpy, strerror
+#include <stdexcept>     // for runtime_error
+#include <string>        // for string
+#include <utility>       // for move, exchange, swap
+#include <vector>        // for vector
+
+/**
+ * Message passing between the ranks of a group of processes.
+ * The only operation is a collective all-to-all exchange, which every rank
+ * must call the same number of times; this is the level-synchronous
+ * pattern of DdPartitionedBuilder.
+ */
+class Transport {
+   public:
+    using Message = std::vector<char>;
+
+    Transport() = default;
+    Transport(Transport const&) = delete;
+    Transport& operator=(Transport const&) = delete;
+    virtual ~Transport() = default;
+
+    /**
+     * Gets the rank of this process.
+     * @return the rank, between 0 and size() - 1.
+     */
+    [[nodiscard]] virtual int rank() const = 0;
+
+    /**
+     * Gets the number of ranks.
+     * @return the number of ranks.
+     */
+    [[nodiscard]] virtual int size() const = 0;
+
+    /**
+     * Sends a message to every rank and receives one from every rank.
+     * @param out the message for each rank, including this one.
+     * @return the message from each rank.
+     * @exception std::runtime_error a peer failed or went away.
+     */
+    virtual std::vector<Message> exchange(std::vector<Message> out) = 0;
+};
+
+/**
+ * Transport of a single process.
+ */
+class LoopbackTransport : public Transport {
+   public:
+    [[nodiscard]] int rank() const override { return 0; }
+
+    [[nodiscard]] int size() const override { return 1; }
+
+    std::vector<Message> exchange(std::vector<Message> out) override {
+        return out;
+    }
+};
+
+/**
+ * Transport between local processes over a full mesh of Unix socket pairs.
+ * Every pair of ranks shares one stream socket; messages are framed by
+ * their 8-byte length. An exchange polls all peers at once, writing and
+ * reading as the sockets allow, so that large messages in both directions
+ * cannot deadlock.
+ */
+class UnixSocketTransport : public Transport {
+    int              rank_;
+    std::vector<int> peer;  ///< Socket to every rank, -1 for this one.
+
+    [[noreturn]] static void fail(char const* what) {
+        throw std::runtime_error(std::string("UnixSocketTransport: ") + what +
+                                 ": " + std::strerror(errno));
+    }
+
+    struct Channel {
+        Message out;
+        size_t  sent{};
+        Message in;
+        size_t  received{};
+        char    header[8]{};
+        bool    hasHeader{};
+    };
+
+    UnixSocketTransport(int _rank, std::vector<int> _peer)
+        : rank_(_rank),
+          peer(std::move(_peer)) {}
+
+    friend class UnixSocketMesh;
+
+   public:
+    UnixSocketTransport(UnixSocketTransport&& o) noexcept
+        : rank_(o.rank_),
+          peer(std::move(o.peer)) {}
+
+    ~UnixSocketTransport() override {
+        for (auto fd : peer) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    [[nodiscard]] int rank() const override { return rank_; }
+
+    [[nodiscard]] int size() const override {
+        return static_cast<int>(peer.size());
+    }
+
+    std::vector<Message> exchange(std::vector<Message> out) override {
+        auto const           n = peer.size();
+        std::vector<Channel> ch(n);
+        std::vector<Message> result(n);
+        for (auto r = 0UL; r < n; ++r) {
+            if (static_cast<int>(r) == rank_) {
+                result[r] = std::move(out[r]);
+                continue;
+            }
+            uint64_t const length = out[r].size();
+            ch[r].out.resize(sizeof(length) + length);
+            std::memcpy(ch[r].out.data(), &length, sizeof(length));
+            if (length > 0) {
+                std::memcpy(ch[r].out.data() + sizeof(length), out[r].data(),
+                            length);
+            }
+            Message().swap(out[r]);
+        }
+
+        std::vector<pollfd> fds;
+        std::vector<size_t> rankOf;
+        while (true) {
+            fds.clear();
+            rankOf.clear();
+            for (auto r = 0UL; r < n; ++r) {
+                if (static_cast<int>(r) == rank_) {
+                    continue;
+                }
+                short events = 0;
+                if (ch[r].sent < ch[r].out.size()) {
+                    events |= POLLOUT;
+                }
+                if (!ch[r].hasHeader || ch[r].received < ch[r].in.size()) {
+                    events |= POLLIN;
+                }
+                if (events != 0) {
+                    fds.push_back({peer[r], events, 0});
+                    rankOf.push_back(r);
+                }
+            }
+            if (fds.empty()) {
+                break;
+            }
+            if (::poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                fail("poll");
+            }
+
+            for (auto k = 0UL; k < fds.size(); ++k) {
+                auto& c = ch[rankOf[k]];
+                if ((fds[k].revents & POLLOUT) != 0) {
+                    auto const w = ::send(fds[k].fd, c.out.data() + c.sent,
+                                          c.out.size() - c.sent,
+                                          MSG_NOSIGNAL | MSG_DONTWAIT);
+                    if (w < 0 && errno != EAGAIN && errno != EINTR) {
+                        fail("send");
+                    }
+                    if (w > 0) {
+                        c.sent += static_cast<size_t>(w);
+                    }
+                    if (c.sent == c.out.size()) {
+                        Message().swap(c.out);
+                        c.sent = 0;
+                    }
+                }
+                if ((fds[k].revents & (POLLIN | POLLHUP | POLLERR)) == 0) {
+                    continue;
+                }
+                char* dest = c.hasHeader ? c.in.data() : c.header;
+                auto  want = c.hasHeader ? c.in.size() : sizeof(c.header);
+                if (want == c.received) {
+                    continue;  // hung up after its whole message arrived
+                }
+                auto const rd = ::recv(fds[k].fd, dest + c.received,
+                                       want - c.received, MSG_DONTWAIT);
+                if (rd == 0) {
+                    errno = ECONNRESET;
+                    fail("peer closed");
+                }
+                if (rd < 0) {
+                    if (errno == EAGAIN || errno == EINTR) {
+                        continue;
+                    }
+                    fail("recv");
+                }
+                c.received += static_cast<size_t>(rd);
+                if (!c.hasHeader && c.received == sizeof(c.header)) {
+                    uint64_t length = 0;
+                    std::memcpy(&length, c.header, sizeof(length));
+                    c.in.resize(length);
+                    c.hasHeader = true;
+                    c.received = 0;
+                }
+            }
+        }
+
+        for (auto r = 0UL; r < n; ++r) {
+            if (static_cast<int>(r) != rank_) {
+                result[r] = std::move(ch[r].in);
+            }
+        }
+        return result;
+    }
+};
+
+/**
+ * The sockets of a UnixSocketTransport group. The mesh is created before
+ * the ranks are forked, or shared by ranks running as threads; every rank
+ * takes its own endpoints with connect(). A forked rank then calls close()
+ * so that it does not keep the other ranks' endpoints open.
+ */
+class UnixSocketMesh {
+    int              n;
+    std::vector<int> end;  ///< end[a * n + b]: a's socket to b.
+
+   public:
+    /**
+     * Constructor.
+     * @param _n the number of ranks.
+     * @exception std::runtime_error the sockets cannot be created.
+     */
+    explicit UnixSocketMesh(int _n) : n(_n), end(_n * _n, -1) {
+        for (int a = 0; a < n; ++a) {
+            for (int b = a + 1; b < n; ++b) {
+                int sv[2];
+                if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+                    auto const error = errno;
+                    close();
+                    errno = error;
+                    throw std::runtime_error(
+                        std::string("UnixSocketMesh: socketpair: ") +
+                        std::strerror(errno));
+                }
+                end[a * n + b] = sv[0];
+                end[b * n + a] = sv[1];
+            }
+        }
+    }
+
+    UnixSocketMesh(UnixSocketMesh const&) = delete;
+    UnixSocketMesh& operator=(UnixSocketMesh const&) = delete;
+
+    ~UnixSocketMesh() { close(); }
+
+    /**
+     * Closes the sockets not yet taken.
+     */
+    void close() {
+        for (auto& fd : end) {
+            if (fd >= 0) {
+                ::close(std::exchange(fd, -1));
+            }
+        }
+    }
+
+    /**
+     * Takes the endpoints of a rank.
+     * @param rank the rank.
+     * @return the transport of the rank.
+     */
+    UnixSocketTransport connect(int rank) {
+        std::vector<int> peer(n, -1);
+        for (int b = 0; b < n; ++b) {
+            std::swap(peer[b], end[rank * n + b]);
+        }
+        return {rank, std::move(peer)};
+    }
+};
+
+#endif  // TRANSPORT_HPP
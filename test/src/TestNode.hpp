@@ -0,0 +1,150 @@
+#ifndef TEST_NODE_HPP
+#define TEST_NODE_HPP
+
+#include <ModernDD/NodeBase.hpp>     // for NodeBase
+#include <ModernDD/NodeBddEval.hpp>  // for Eval
+#include <ModernDD/NodeBddSpec.hpp>  // for DdSpec
+#include <ModernDD/NodeId.hpp>       // for NodeId
+#include <cstddef>                   // for size_t
+#include <cstdint>                   // for uint64_t
+#include <functional>                // for function
+#include <map>                       // for map
+#include <utility>                   // for make_pair, pair
+
+/**
+ * Minimal node type for the tests.
+ * It carries the node label bookkeeping that DdReducer expects.
+ */
+class TestNode : public NodeBase {
+    NodeId label{};
+    NodeId ptr{};
+
+   public:
+    TestNode() = default;
+    TestNode(size_t i, size_t j) : NodeBase(i, j) {}
+    TestNode(NodeId f0, NodeId f1) : NodeBase(f0, f1) {}
+
+    void set_node_id_label(NodeId f) { label = f; }
+
+    [[nodiscard]] NodeId get_node_id_label() const { return label; }
+
+    void set_ptr_node_id(NodeId f) { ptr = f; }
+
+    [[nodiscard]] NodeId get_ptr_node_id() const { return ptr; }
+};
+
+/**
+ * Test node with the number of paths to the 1-terminal.
+ */
+struct PathCountNode : TestNode {
+    using TestNode::TestNode;
+
+    uint64_t count{};
+};
+
+/**
+ * Counts the paths to the 1-terminal, which are the sets of a ZDD.
+ */
+class PathCountEval : public Eval<PathCountNode, uint64_t> {
+   public:
+    void initialize_node(PathCountNode& n) const override { n.count = 0; }
+
+    void initialize_root_node(PathCountNode& n) const override { n.count = 1; }
+
+    void evalNode(PathCountNode& n) const override {
+        auto* nodes = get_table();
+        n.count = nodes->node(n[0]).count + nodes->node(n[1]).count;
+    }
+
+    uint64_t get_objective(PathCountNode& n) const override { return n.count; }
+};
+
+/**
+ * Counts the sets of a ZDD by enumerating them.
+ * @param dd the ZDD.
+ * @return the number of sets.
+ */
+template <typename DD>
+uint64_t countSets(DD const& dd) {
+    uint64_t n = 0;
+    for (auto it = dd.begin(); it != dd.end(); ++it) {
+        ++n;
+    }
+    return n;
+}
+
+/**
+ * Counts the sets of a ZDD by dynamic programming over its nodes.
+ * @param dd the ZDD.
+ * @return the number of sets.
+ */
+template <typename DD>
+uint64_t countZdd(DD const& dd) {
+    std::map<std::pair<size_t, size_t>, uint64_t> memo;
+    std::function<uint64_t(NodeId)>               count = [&](NodeId f) {
+        if (f.row() == 0) {
+            return f.col();
+        }
+        auto key = std::make_pair(f.row(), f.col());
+        auto it = memo.find(key);
+        if (it != memo.end()) {
+            return it->second;
+        }
+        auto n = count(dd.child(f, 0)) + count(dd.child(f, 1));
+        memo[key] = n;
+        return n;
+    };
+    return count(dd.root());
+}
+
+/**
+ * Evaluates a diagram on a complete assignment.
+ * @param dd the diagram.
+ * @param x assignment indexed by level.
+ * @param zdd true for ZDD semantics of skipped levels, false for BDD.
+ * @return the value of the function.
+ */
+template <typename DD, typename X>
+bool evalAssignment(DD const& dd, X const& x, bool zdd) {
+    NodeId f = dd.root();
+    for (size_t i = x.size() - 1; i >= 1; --i) {
+        if (f.row() == i) {
+            f = dd.child(f, x[i] ? 1 : 0);
+        } else if (zdd && x[i]) {
+            return false;
+        }
+    }
+    return f == 1;
+}
+
+/**
+ * k-subsets of n items.
+ */
+class Combination : public DdSpec<Combination, int, 2> {
+    int n;
+    int k;
+
+   public:
+    Combination(int _n, int _k) : n(_n), k(_k) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state += value;
+        if (--level == 0) {
+            return (state == k) ? -1 : 0;
+        }
+        if (state > k) {
+            return 0;
+        }
+        if (state + level < k) {
+            return 0;
+        }
+        return level;
+    }
+};
+
+#endif  // TEST_NODE_HPP
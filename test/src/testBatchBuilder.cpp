@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddBatchBuilder.hpp>
+#include <ModernDD/util/MyList.hpp>
+#include <ModernDD/util/ThreadPool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "TestNode.hpp"
+
+/**
+ * Combination that fails at the root for a negative k.
+ */
+class CheckedCombination : public DdSpec<CheckedCombination, int, 2> {
+    Combination spec;
+    bool        negative;
+
+   public:
+    CheckedCombination(int _n, int _k)
+        : spec(_n, std::max(_k, 0)), negative(_k < 0) {}
+
+    int getRoot(int& state) const {
+        if (negative) {
+            throw std::runtime_error("negative k");
+        }
+        return spec.getRoot(state);
+    }
+
+    int getChild(int& state, int level, int value) const {
+        return spec.getChild(state, level, value);
+    }
+};
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+    ThreadPool                     pool(4);
+    std::vector<std::atomic<int>> hits(1000);
+
+    pool.parallel_for(hits.size(), [&](size_t i) { ++hits[i]; });
+
+    for (auto& h : hits) {
+        ASSERT_EQ(1, h.load());
+    }
+}
+
+TEST(ThreadPoolTest, NestedParallelFor) {
+    ThreadPool       pool(2);
+    std::atomic<int> sum{0};
+
+    pool.parallel_for(8, [&](size_t) {
+        pool.parallel_for(8, [&](size_t j) { sum += static_cast<int>(j); });
+    });
+
+    ASSERT_EQ(8 * 28, sum.load());
+}
+
+TEST(BatchBuilderTest, MatchesSerialBuilds) {
+    ThreadPool               pool(3);
+    std::vector<Combination> specs;
+    for (int n = 1; n <= 40; ++n) {
+        specs.emplace_back(n, n / 3);
+    }
+
+    DdBatchBuilder<TestNode> batch(pool, DdBuildMethod::BreadthFirst, true);
+    auto                     results = batch.build(specs);
+
+    ASSERT_EQ(specs.size(), results.size());
+    for (auto i = 0UL; i < specs.size(); ++i) {
+        DdStructure<TestNode> dd(specs[i]);
+        dd.reduceZdd();
+        ASSERT_EQ(dd.size(), results[i].dd.size());
+        ASSERT_EQ(dd, results[i].dd);
+        ASSERT_GE(results[i].seconds, 0.0);
+    }
+}
+
+TEST(BatchBuilderTest, PropagatesSpecErrors) {
+    ThreadPool               pool(2);
+    std::vector<CheckedCombination> specs{{5, 2}, {5, -1}, {6, 3}};
+    DdBatchBuilder<TestNode>        batch(pool);
+
+    ASSERT_THROW(batch.build(specs), std::runtime_error);
+}
+
+TEST(BatchBuilderTest, BlockReuseIsScoped) {
+    ASSERT_FALSE(MyListBlockReuse::active());
+    MyList<int> outer;
+    *outer.alloc_front() = 1;
+    {
+        MyListBlockReuse const reuse;
+        ASSERT_TRUE(MyListBlockReuse::active());
+        {
+            MyListBlockReuse const nested;
+            MyList<int>            inner;
+            *inner.alloc_front() = 2;
+        }
+        ASSERT_TRUE(MyListBlockReuse::active());
+        outer.clear();  // kept until the scope ends
+        *outer.alloc_front() = 3;
+    }
+    ASSERT_FALSE(MyListBlockReuse::active());
+    ASSERT_EQ(3, *outer.front());
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddQuery.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <random>
+#include <vector>
+
+#include "TestNode.hpp"
+
+/**
+ * Sets whose sum of levels is r modulo m.
+ */
+class ModSum : public DdSpec<ModSum, int, 2> {
+    int const n;
+    int const m;
+    int const r;
+
+   public:
+    ModSum(int _n, int _m, int _r) : n(_n), m(_m), r(_r) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        if (value) {
+            state = (state + level) % m;
+        }
+        if (--level == 0) {
+            return (state == r) ? -1 : 0;
+        }
+        return level;
+    }
+};
+
+bool walkZdd(DdStructure<TestNode> const& dd, std::vector<char> const& x) {
+    NodeId f = dd.root();
+    for (auto i = x.size() - 1; i >= 1; --i) {
+        if (f.row() == i) {
+            f = dd.child(f, x[i]);
+        } else if (x[i]) {
+            return false;
+        }
+    }
+    return f == 1;
+}
+
+bool walkBdd(DdStructure<TestNode> const& dd, std::vector<char> const& x) {
+    NodeId f = dd.root();
+    while (f.row() > 0) {
+        f = dd.child(f, x[f.row()]);
+    }
+    return f == 1;
+}
+
+/**
+ * Random inputs, half of them members of the family of @p dd.
+ */
+std::vector<std::vector<char>> inputs(DdStructure<TestNode> const& dd,
+                                      size_t                       top,
+                                      size_t                       count,
+                                      unsigned                     seed) {
+    std::mt19937                   gen(seed);
+    std::vector<std::vector<char>> x;
+    std::vector<std::vector<char>> members;
+    for (auto const& s : dd) {
+        members.emplace_back(top + 1, 0);
+        for (int i : s) {
+            members.back()[i] = 1;
+        }
+    }
+    while (x.size() < count) {
+        if (!members.empty() && gen() % 2 == 0) {
+            x.push_back(members[gen() % members.size()]);
+            x.back()[1 + gen() % top] ^= (gen() % 4 == 0) ? 1 : 0;
+        } else {
+            x.emplace_back(top + 1, 0);
+            for (auto i = 1UL; i <= top; ++i) {
+                x.back()[i] = static_cast<char>(gen() % 2);
+            }
+        }
+    }
+    return x;
+}
+
+DdBitSlices slice(std::vector<std::vector<char>> const& x, size_t top) {
+    DdBitSlices s(top, x.size());
+    for (auto q = 0UL; q < x.size(); ++q) {
+        for (auto i = 1UL; i <= top; ++i) {
+            s.set(q, i, x[q][i] != 0);
+        }
+    }
+    return s;
+}
+
+TEST(BatchQueryTest, ZddMembership) {
+    std::vector<DdStructure<TestNode>> dds;
+    dds.emplace_back(Combination(14, 5));
+    dds.emplace_back(ModSum(14, 5, 2));
+    dds.emplace_back(Combination(10, 0));
+    dds.emplace_back(Combination(10, 12));
+    for (auto& dd : dds) {
+        dd.reduceZdd();
+    }
+
+    for (auto const& dd : dds) {
+        for (size_t top : {14UL, 17UL}) {
+            auto const x = inputs(dd, top, 301, static_cast<unsigned>(top));
+            DdBatchQuery<TestNode> query(dd);
+            auto const             result = query.contains(slice(x, top));
+            ASSERT_EQ(x.size(), result.size());
+            for (auto q = 0UL; q < x.size(); ++q) {
+                ASSERT_EQ(walkZdd(dd, x[q]), result[q]);
+            }
+        }
+    }
+}
+
+TEST(BatchQueryTest, ZddMembershipOfSets) {
+    DdStructure<TestNode> dd(Combination(8, 3));
+    dd.reduceZdd();
+    DdBatchQuery<TestNode> query(dd);
+
+    std::vector<std::vector<int>> sets{
+        {1, 2, 3}, {8, 4, 1}, {1, 2}, {1, 2, 3, 4}, {}, {2, 5, 9}, {7, 8, 6}};
+    std::vector<bool> const expected{true,  true,  false, false,
+                                     false, false, true};
+    ASSERT_EQ(expected, query.contains(sets));
+    ASSERT_THROW(query.contains({{0}}), std::runtime_error);
+}
+
+TEST(BatchQueryTest, BddEvaluation) {
+    std::vector<DdStructure<TestNode>> dds;
+    dds.emplace_back(Combination(16, 6));
+    dds.emplace_back(ModSum(16, 7, 3));
+    for (auto& dd : dds) {
+        dd.bddReduce();
+    }
+
+    for (auto const& dd : dds) {
+        auto const             x = inputs(dd, 16, 1000, 5);
+        DdBatchQuery<TestNode> query(dd);
+        auto const             result = query.evaluate(slice(x, 16));
+        for (auto q = 0UL; q < x.size(); ++q) {
+            ASSERT_EQ(walkBdd(dd, x[q]), result[q]);
+        }
+    }
+}
+
+TEST(BatchQueryTest, EmptyBatch) {
+    DdStructure<TestNode>  dd(Combination(6, 2));
+    DdBatchQuery<TestNode> query(dd);
+    ASSERT_TRUE(query.contains(DdBitSlices(6, 0)).empty());
+    ASSERT_TRUE(query.evaluate(DdBitSlices(6, 0)).empty());
+}
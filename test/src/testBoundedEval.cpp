@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddEval.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "TestNode.hpp"
+
+constexpr double inf = std::numeric_limits<double>::infinity();
+
+/**
+ * Node carrying its level, its cost from the root and its completion bound.
+ */
+struct PathNode : TestNode {
+    using TestNode::TestNode;
+
+    size_t level{};
+    double cost{};
+    double bound{};
+};
+
+/**
+ * Cheapest set of a ZDD, taking item i costs w[i].
+ */
+class CheapestSet : public BoundedEval<PathNode, double> {
+    std::vector<double> const& w;
+
+   public:
+    mutable size_t evaluated{};
+
+    explicit CheapestSet(std::vector<double> const& _w) : w(_w) {}
+
+    void initialize_node(PathNode& n) const override { n.cost = inf; }
+
+    void initialize_root_node(PathNode& n) const override { n.cost = 0.0; }
+
+    void evalNode(PathNode& n) const override {
+        ++evaluated;
+        auto& nodes = *get_table();
+        for (auto b = 0UL; b < 2; ++b) {
+            auto& c = nodes.node(n[b]);
+            c.cost = std::min(c.cost, n.cost + (b ? w[n.level] : 0.0));
+        }
+    }
+
+    double get_objective(PathNode& n) const override { return n.cost; }
+
+    double cost(PathNode const& n) const override { return n.cost; }
+
+    double completion_bound(PathNode const& n) const override {
+        return n.bound;
+    }
+};
+
+class BoundedEvalTest : public ::testing::Test {
+   protected:
+    std::vector<double>   w{0.0,  3.0, -2.0, 1.5, -4.0, 2.0, -1.0,
+                          -0.5, 4.0, -3.0, 0.5, -1.5, 2.5};
+    DdStructure<PathNode> dd{Combination(12, 5)};
+
+    void SetUp() override {
+        dd.reduceZdd();
+        auto& table = *dd.getDiagram();
+        for (auto i = 0UL; i < table.numRows(); ++i) {
+            for (auto& it : table[i]) {
+                it.level = i;
+            }
+        }
+    }
+
+    /** Sets the bounds to the exact cost of completing a path. */
+    void exactBounds() {
+        auto& table = *dd.getDiagram();
+        table.node(0).bound = inf;
+        table.node(1).bound = 0.0;
+        for (auto i = 1UL; i < table.numRows(); ++i) {
+            for (auto& it : table[i]) {
+                it.bound = std::min(table.node(it[0]).bound,
+                                    table.node(it[1]).bound + w[i]);
+            }
+        }
+    }
+
+    /** Sets the bounds to the sum of the negative costs below the node. */
+    void relaxedBounds() {
+        auto&  table = *dd.getDiagram();
+        double sum = 0.0;
+        for (auto i = 1UL; i < table.numRows(); ++i) {
+            sum += std::min(0.0, w[i]);
+            for (auto& it : table[i]) {
+                it.bound = sum;
+            }
+        }
+    }
+
+    double cheapest() const {
+        double best = inf;
+        for (auto const& s : dd) {
+            double c = 0.0;
+            for (auto i : s) {
+                c += w[i];
+            }
+            best = std::min(best, c);
+        }
+        return best;
+    }
+};
+
+TEST_F(BoundedEvalTest, UnboundedMatchesForward) {
+    relaxedBounds();
+    CheapestSet full(w);
+    CheapestSet bounded(w);
+    auto const  opt = dd.evaluate_forward(full);
+    ASSERT_DOUBLE_EQ(cheapest(), opt);
+    ASSERT_DOUBLE_EQ(opt, dd.evaluate_forward_bounded(bounded, inf));
+    ASSERT_EQ(full.evaluated, bounded.evaluated);
+}
+
+TEST_F(BoundedEvalTest, PrunesWithExactBounds) {
+    exactBounds();
+    auto const  opt = cheapest();
+    CheapestSet eval(w);
+    ASSERT_DOUBLE_EQ(opt, dd.evaluate_forward_bounded(eval, opt + 0.25));
+    ASSERT_GT(eval.evaluated, 0UL);
+    ASSERT_LT(eval.evaluated, dd.size() / 2);
+}
+
+TEST_F(BoundedEvalTest, PrunesWithRelaxedBounds) {
+    relaxedBounds();
+    auto const  opt = cheapest();
+    CheapestSet eval(w);
+    ASSERT_DOUBLE_EQ(opt, dd.evaluate_forward_bounded(eval, opt + 0.25));
+    ASSERT_LT(eval.evaluated, dd.size());
+}
+
+TEST_F(BoundedEvalTest, ExitsAtRootWhenNoPathBeatsCutoff) {
+    exactBounds();
+    CheapestSet eval(w);
+    ASSERT_GE(dd.evaluate_forward_bounded(eval, cheapest()), cheapest());
+    ASSERT_EQ(0UL, eval.evaluated);
+
+    relaxedBounds();
+    CheapestSet relaxed(w);
+    auto const  cutoff = dd.getDiagram()->node(dd.root()).bound;
+    ASSERT_GE(dd.evaluate_forward_bounded(relaxed, cutoff), cutoff);
+    ASSERT_EQ(0UL, relaxed.evaluated);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddBulkLoader.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "TestNode.hpp"
+
+/**
+ * Sets of at most k items.
+ */
+class AtMost : public DdSpec<AtMost, int, 2> {
+    int const n;
+    int const k;
+
+   public:
+    AtMost(int _n, int _k) : n(_n), k(_k) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state += value;
+        if (state > k) {
+            return 0;
+        }
+        return (--level == 0) ? -1 : level;
+    }
+};
+
+using Family = std::set<std::set<int>>;
+
+template <typename DD>
+Family sets(DD const& dd) {
+    Family s;
+    for (auto const& x : dd) {
+        s.insert(x);
+    }
+    return s;
+}
+
+/**
+ * Loads a family, sorting it first.
+ */
+DdStructure<TestNode> load(size_t n, std::vector<std::set<int>> family) {
+    std::sort(family.begin(), family.end(), ZddLoadOrder());
+    ZddBulkLoader<TestNode> loader(n);
+    for (auto const& s : family) {
+        loader.add(s);
+    }
+    return loader.finish();
+}
+
+/**
+ * Checks that a diagram is reduced and carries the attributes that
+ * reduceZdd would give it.
+ */
+void expectReduced(DdStructure<TestNode> const& dd) {
+    auto copy = dd;
+    copy.reduceZdd();
+    ASSERT_EQ(copy.size(), dd.size());
+    ASSERT_EQ(copy, dd);
+    ASSERT_EQ(copy.root().getAttr(), dd.root().getAttr());
+}
+
+TEST(BulkLoaderTest, MatchesReducedSpec) {
+    for (auto const& spec : {Combination(14, 5), Combination(9, 0)}) {
+        DdStructure<TestNode> dd(spec);
+        dd.reduceZdd();
+        ZddBulkLoader<TestNode> loader(14);
+        for (auto const& s : dd) {  // enumerated in ZddLoadOrder
+            loader.add(s);
+        }
+        auto const loaded = loader.finish();
+        ASSERT_EQ(dd.size(), loaded.size());
+        ASSERT_EQ(dd, loaded);
+        ASSERT_EQ(sets(dd), sets(loaded));
+    }
+    DdStructure<TestNode> dd(AtMost(12, 3));
+    dd.reduceZdd();
+    auto const all = sets(dd);
+    auto const loaded = load(12, {all.begin(), all.end()});
+    ASSERT_EQ(dd, loaded);
+    ASSERT_TRUE(loaded.root().getAttr());
+}
+
+TEST(BulkLoaderTest, RandomFamilies) {
+    std::mt19937 rng(7);
+    for (auto round = 0; round < 20; ++round) {
+        size_t const               n = 1 + rng() % 16;
+        std::vector<std::set<int>> family;
+        Family                     expected;
+        for (auto k = rng() % 300; k > 0; --k) {
+            std::set<int> s;
+            for (auto i = 1UL; i <= n; ++i) {
+                if (rng() % 3 == 0) {
+                    s.insert(static_cast<int>(i));
+                }
+            }
+            family.push_back(s);
+            family.push_back(s);  // duplicates are dropped
+            expected.insert(s);
+        }
+        auto const dd = load(n, family);
+        ASSERT_EQ(expected, sets(dd));
+        expectReduced(dd);
+    }
+}
+
+TEST(BulkLoaderTest, TerminalFamilies) {
+    ZddBulkLoader<TestNode> loader(5);
+    ASSERT_EQ(NodeId(0), loader.finish().root());
+    loader.add(std::vector<int>{});
+    ASSERT_EQ(1UL, loader.count());
+    ASSERT_EQ(NodeId(1), loader.finish().root());
+    ASSERT_EQ(0UL, loader.count());
+}
+
+TEST(BulkLoaderTest, ItemsInAnyOrder) {
+    ZddBulkLoader<TestNode> loader(6);
+    loader.add(std::vector<int>{1, 3, 3});
+    loader.add(std::vector<int>{6, 2, 4});
+    ASSERT_EQ((Family{{1, 3}, {2, 4, 6}}), sets(loader.finish()));
+}
+
+TEST(BulkLoaderTest, RejectsBadInput) {
+    ZddBulkLoader<TestNode> loader(6);
+    loader.add(std::vector<int>{2, 5});
+    ASSERT_THROW(loader.add(std::vector<int>{5}), std::runtime_error);
+    ASSERT_THROW(loader.add(std::vector<int>{1, 5}), std::runtime_error);
+    ASSERT_THROW(loader.add(std::vector<int>{7}), std::runtime_error);
+    ASSERT_THROW(loader.add(std::vector<int>{0, 6}), std::runtime_error);
+    loader.add(std::vector<int>{3, 5});
+    ASSERT_EQ((Family{{2, 5}, {3, 5}}), sets(loader.finish()));
+}
+
+TEST(BulkLoaderTest, IntersectsWithSpec) {
+    std::vector<std::set<int>> family;
+    for (auto const& s : DdStructure<TestNode>(AtMost(10, 4))) {
+        if (s.size() % 2 == 0) {
+            family.push_back(s);
+        }
+    }
+    auto dd = load(10, family);
+    dd.zddSubset(Combination(10, 4));
+    dd.reduceZdd();
+    DdStructure<TestNode> expected(Combination(10, 4));
+    expected.reduceZdd();
+    ASSERT_EQ(expected, dd);
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/util/Canonicalizer.hpp>
+#include <vector>
+
+#include "TestNode.hpp"
+
+/**
+ * Items packed by best fit into identical bins: a selected item goes to the
+ * fullest bin that can hold it. The outcome only depends on the multiset of
+ * the bin loads, so sorting them is a symmetry of the state.
+ */
+template <bool CANONICAL>
+class BestFit : public PodArrayDdSpec<BestFit<CANONICAL>, int, 2> {
+    std::vector<int> weights;
+    int const        bins;
+    int const        capacity;
+
+   public:
+    BestFit(std::vector<int> _weights, int _bins, int _capacity)
+        : weights(std::move(_weights)),
+          bins(_bins),
+          capacity(_capacity) {
+        this->setArraySize(bins);
+    }
+
+    int getRoot(int* load) const {
+        for (int k = 0; k < bins; ++k) {
+            load[k] = 0;
+        }
+        return static_cast<int>(weights.size());
+    }
+
+    int getChild(int* load, int level, int value) const {
+        if (value) {
+            int const w = weights[weights.size() - level];
+            int       best = -1;
+            for (int k = 0; k < bins; ++k) {
+                if (load[k] + w <= capacity &&
+                    (best < 0 || load[k] > load[best])) {
+                    best = k;
+                }
+            }
+            if (best < 0) {
+                return 0;
+            }
+            load[best] += w;
+        }
+        return (level == 1) ? -1 : level - 1;
+    }
+
+    void canonicalize(int* load, [[maybe_unused]] int level) {
+        if (CANONICAL) {
+            Canonicalizer::sortRange(load, bins);
+        }
+    }
+};
+
+/**
+ * Subsets of items of even size, for the subsetting tests.
+ */
+class EvenSize : public DdSpec<EvenSize, int, 2> {
+    int const n;
+
+   public:
+    explicit EvenSize(int _n) : n(_n) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state ^= value;
+        if (level == 1) {
+            return (state == 0) ? -1 : 0;
+        }
+        return level - 1;
+    }
+};
+
+static std::vector<int> const weights{3, 5, 2, 4, 3, 6, 2, 5, 4, 3, 2, 4};
+
+TEST(CanonicalizeTest, BreadthFirstMergesSymmetricStates) {
+    DdStructure<TestNode> plain(BestFit<false>(weights, 3, 9));
+    DdStructure<TestNode> canon(BestFit<true>(weights, 3, 9));
+
+    ASSERT_LT(canon.size(), plain.size());
+    ASSERT_EQ(countSets(plain), countSets(canon));
+
+    plain.reduceZdd();
+    canon.reduceZdd();
+    ASSERT_EQ(plain, canon);
+}
+
+TEST(CanonicalizeTest, AllBuildMethodsAgree) {
+    DdStructure<TestNode> expected(BestFit<false>(weights, 3, 9));
+    expected.reduceZdd();
+
+    for (auto method : {DdBuildMethod::BreadthFirst, DdBuildMethod::Pipelined,
+                        DdBuildMethod::DepthFirstZdd}) {
+        DdStructure<TestNode> dd(BestFit<true>(weights, 3, 9), method);
+        dd.reduceZdd();
+        ASSERT_EQ(expected, dd);
+    }
+}
+
+TEST(CanonicalizeTest, SubsetMergesSymmetricStates) {
+    auto const n = static_cast<int>(weights.size());
+
+    DdStructure<TestNode> plain(EvenSize{n});
+    plain.zddSubset(BestFit<false>(weights, 3, 9));
+    DdStructure<TestNode> canon(EvenSize{n});
+    canon.zddSubset(BestFit<true>(weights, 3, 9));
+
+    ASSERT_LT(canon.size(), plain.size());
+    plain.reduceZdd();
+    canon.reduceZdd();
+    ASSERT_EQ(plain, canon);
+}
+
+TEST(CanonicalizeTest, RebuildBelowReplaysCanonicalStates) {
+    DdStructure<TestNode> expected(BestFit<true>(weights, 3, 9));
+    DdStructure<TestNode> dd(BestFit<true>(weights, 3, 9));
+
+    dd.rebuildBelow(BestFit<true>(weights, 3, 9), 5);
+    expected.reduceZdd();
+    dd.reduceZdd();
+    ASSERT_EQ(expected, dd);
+}
+
+TEST(CanonicalizerTest, SortBlocks) {
+    std::vector<int> a{3, 1, 1, 2, 3, 0, 1, 2};
+    Canonicalizer::sortBlocks(a.data(), 2, 4);
+    ASSERT_EQ((std::vector<int>{1, 2, 1, 2, 3, 0, 3, 1}), a);
+}
+
+TEST(CanonicalizerTest, NormalizeLabels) {
+    std::vector<int> a{0, 7, 2, 7, -1, 1, 2, 9};
+    Canonicalizer::normalizeLabels(a.data(), a.size());
+    ASSERT_EQ((std::vector<int>{0, 1, 2, 1, -1, 3, 2, 4}), a);
+
+    std::vector<int> b{4, 4, 1, 3};
+    Canonicalizer::normalizeLabels(b.data(), b.size());
+    ASSERT_EQ((std::vector<int>{1, 1, 2, 3}), b);
+}
+
+TEST(CanonicalizerTest, MirrorMates) {
+    // positions 0 and 3 are paired, position 1 is a flag, 2 is the end of
+    // the path from s
+    std::vector<int> a{3, -1, -2, 0};
+    std::vector<int> b{3, -2, -1, 0};
+    Canonicalizer::mirrorMates(a.data(), a.size());
+    Canonicalizer::mirrorMates(b.data(), b.size());
+    ASSERT_EQ(a, b);
+    ASSERT_EQ((std::vector<int>{3, -2, -1, 0}), a);
+
+    std::vector<int> c{11, 10, -1};  // offset 10
+    Canonicalizer::mirrorMates(c.data(), c.size(), 10);
+    ASSERT_EQ((std::vector<int>{-1, 12, 11}), c);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddChain.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "TestNode.hpp"
+
+/**
+ * Function of n variables given by its truth table; bit l - 1 of an index
+ * is the variable of level l.
+ */
+class TruthTable : public DdSpec<TruthTable, uint32_t, 2> {
+    int const         n;
+    std::vector<char> ones;
+
+   public:
+    TruthTable(int _n, std::vector<char> _ones)
+        : n(_n),
+          ones(std::move(_ones)) {}
+
+    int getRoot(uint32_t& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(uint32_t& state, int level, int value) const {
+        state |= static_cast<uint32_t>(value) << (level - 1);
+        if (--level == 0) {
+            return ones[state] ? -1 : 0;
+        }
+        return level;
+    }
+};
+
+std::vector<char> randomTable(int n, double density, unsigned seed) {
+    std::mt19937                gen(seed);
+    std::bernoulli_distribution coin(density);
+    std::vector<char>           ones(1U << n);
+    for (auto& x : ones) {
+        x = coin(gen) ? 1 : 0;
+    }
+    return ones;
+}
+
+/**
+ * Sets in which the items of the upper half are free and at most one item
+ * of every pair of the lower half is chosen, with exactly k chosen there.
+ */
+std::vector<char> mixedTable(int n, int k) {
+    std::vector<char> ones(1U << n);
+    for (auto s = 0U; s < ones.size(); ++s) {
+        int  chosen = 0;
+        bool ok = true;
+        for (int l = 1; l + 1 <= n / 2; l += 2) {
+            int const pair = ((s >> (l - 1)) & 1U) + ((s >> l) & 1U);
+            ok = ok && pair <= 1;
+            chosen += pair;
+        }
+        ones[s] = (ok && chosen == k) ? 1 : 0;
+    }
+    return ones;
+}
+
+std::vector<std::vector<int>> setsOf(ChainDd const& c) {
+    std::vector<std::vector<int>> sets;
+    c.forEachSet([&](std::vector<int> const& items) {
+        sets.push_back(items);
+    });
+    return sets;
+}
+
+std::vector<std::vector<int>> setsOf(std::vector<char> const& ones, int n) {
+    std::vector<std::vector<int>> sets;
+    for (auto s = 0U; s < ones.size(); ++s) {
+        if (ones[s]) {
+            sets.emplace_back();
+            for (int l = n; l >= 1; --l) {
+                if ((s >> (l - 1)) & 1U) {
+                    sets.back().push_back(l);
+                }
+            }
+        }
+    }
+    return sets;
+}
+
+void checkFunction(int n, std::vector<char> const& ones) {
+    TruthTable const      spec(n, ones);
+    DdStructure<TestNode> full(spec);
+    DdStructure<TestNode> zdd(full);
+    DdStructure<TestNode> bdd(full);
+    zdd.reduceZdd();
+    bdd.bddReduce();
+
+    ChainDd const fromFull(full, true, n);
+    ChainDd const fromZdd(zdd, true, n);
+    ChainDd const fromBdd(bdd, false, n);
+    ASSERT_EQ(fromFull.size(), fromZdd.size());
+    ASSERT_EQ(fromFull.size(), fromBdd.size());
+    ASSERT_LE(fromZdd.size(), std::min(zdd.size(), bdd.size()));
+
+    auto expected = setsOf(ones, n);
+    std::sort(expected.begin(), expected.end());
+    for (auto const* c : {&fromFull, &fromZdd, &fromBdd}) {
+        auto sets = setsOf(*c);
+        std::sort(sets.begin(), sets.end());
+        ASSERT_EQ(expected, sets);
+        auto const count = c->evaluate<uint64_t>(
+            [](bool b) { return b ? 1UL : 0UL; },
+            [](int, uint64_t c0, uint64_t c1) { return c0 + c1; });
+        ASSERT_EQ(expected.size(), count);
+    }
+}
+
+TEST(ChainTest, RandomFunctions) {
+    unsigned seed = 0;
+    for (double density : {0.0, 0.02, 0.1, 0.5, 0.9, 0.98, 1.0}) {
+        for (int n : {1, 3, 6, 9}) {
+            checkFunction(n, randomTable(n, density, ++seed));
+        }
+    }
+}
+
+TEST(ChainTest, MixedFamilyIsSmallerThanBoth) {
+    int const  n = 14;
+    auto const ones = mixedTable(n, 2);
+    checkFunction(n, ones);
+
+    DdStructure<TestNode> zdd(TruthTable(n, ones));
+    DdStructure<TestNode> bdd(zdd);
+    zdd.reduceZdd();
+    bdd.bddReduce();
+    ChainDd const c(zdd, true, n);
+    ASSERT_LT(c.size(), bdd.size());
+    ASSERT_LT(c.size(), zdd.size());
+}
+
+TEST(ChainTest, SkippedLevelsAboveRoot) {
+    // only the lowest of 5 variables matters: as a BDD, 16 sets, as a ZDD, 1
+    std::vector<char>     ones{0, 1};
+    DdStructure<TestNode> dd(TruthTable(1, ones));
+    dd.reduceZdd();
+
+    ChainDd const asBdd(dd, false, 5);
+    ChainDd const asZdd(dd, true, 5);
+    ASSERT_EQ(16UL, setsOf(asBdd).size());
+    ASSERT_EQ(std::vector<std::vector<int>>{{1}}, setsOf(asZdd));
+    ASSERT_FALSE(ChainDd::zeroSuppressed(asBdd.root()));
+    ASSERT_TRUE(ChainDd::zeroSuppressed(asZdd.root()));
+    ASSERT_EQ(1UL, asBdd.size());
+    ASSERT_TRUE(setsOf(ChainDd()).empty());
+}
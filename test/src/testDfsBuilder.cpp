@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "TestNode.hpp"
+
+TEST(DfsBuilderTest, ZddMatchesReducedBreadthFirst) {
+    for (int n = 1; n <= 14; ++n) {
+        uint64_t binom = 1;
+        for (int k = 0; k <= n; ++k) {
+            DdStructure<TestNode> bfs(Combination(n, k));
+            bfs.reduceZdd();
+            DdStructure<TestNode> dfs(Combination(n, k),
+                                      DdBuildMethod::DepthFirstZdd);
+
+            ASSERT_EQ(bfs.size(), dfs.size());
+            ASSERT_EQ(bfs, dfs);
+            ASSERT_EQ(binom, countSets(dfs));
+            binom = binom * (n - k) / (k + 1);
+        }
+    }
+}
+
+TEST(DfsBuilderTest, BddEvaluatesLikeSpec) {
+    int const n = 8;
+    for (int k = 0; k <= n; ++k) {
+        DdStructure<TestNode> dfs(Combination(n, k),
+                                  DdBuildMethod::DepthFirstBdd);
+
+        for (unsigned m = 0; m < (1U << n); ++m) {
+            std::vector<int> x(n + 1);
+            int              ones = 0;
+            for (int i = 1; i <= n; ++i) {
+                x[i] = (m >> (i - 1)) & 1;
+                ones += x[i];
+            }
+            ASSERT_EQ(ones == k, evalAssignment(dfs, x, false));
+        }
+    }
+}
+
+TEST(DfsBuilderTest, TerminalRoot) {
+    DdStructure<TestNode> dd(Combination(3, 4), DdBuildMethod::DepthFirstZdd);
+    ASSERT_TRUE(dd.empty());
+    ASSERT_EQ(0UL, dd.size());
+}
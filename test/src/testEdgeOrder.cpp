@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/EdgeOrder.hpp>
+#include <ModernDD/spec/PathSpec.hpp>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "TestNode.hpp"
+
+Graph shuffledGrid(int rows, int cols, unsigned seed) {
+    auto             g = Graph::grid(rows, cols);
+    std::vector<int> order(g.numEdges());
+    std::iota(order.begin(), order.end(), 0);
+    std::mt19937 gen(seed);
+    std::shuffle(order.begin(), order.end(), gen);
+    return EdgeOrderOptimizer(g).apply(order);
+}
+
+bool isPermutation(std::vector<int> order, int m) {
+    std::sort(order.begin(), order.end());
+    for (int e = 0; e < m; ++e) {
+        if (order[e] != e) {
+            return false;
+        }
+    }
+    return static_cast<int>(order.size()) == m;
+}
+
+TEST(EdgeOrderTest, WidthMatchesFrontierManager) {
+    for (unsigned seed = 0; seed < 8; ++seed) {
+        auto                     g = shuffledGrid(5, 7, seed);
+        EdgeOrderOptimizer const opt(g);
+        std::vector<int>         identity(g.numEdges());
+        std::iota(identity.begin(), identity.end(), 0);
+
+        ASSERT_EQ(FrontierManager(g).maxFrontierSize(), opt.width(identity));
+        for (auto const& x : {opt.breadthFirst(), opt.cuthillMcKee(),
+                              opt.beam(4)}) {
+            ASSERT_TRUE(isPermutation(x.edges, g.numEdges()));
+            ASSERT_EQ(FrontierManager(opt.apply(x.edges)).maxFrontierSize(),
+                      x.width);
+        }
+    }
+}
+
+TEST(EdgeOrderTest, RecoversNarrowGridOrders) {
+    auto                     g = shuffledGrid(12, 12, 7);
+    EdgeOrderOptimizer const opt(g);
+    std::vector<int>         identity(g.numEdges());
+    std::iota(identity.begin(), identity.end(), 0);
+
+    ASSERT_GT(opt.width(identity), 40);
+    ASSERT_LE(opt.breadthFirst().width, 13);
+    ASSERT_LE(opt.cuthillMcKee().width, 13);
+    ASSERT_LE(opt.beam().width, 13);
+    ASSERT_LE(opt.best().width, 13);
+}
+
+TEST(EdgeOrderTest, DisconnectedGraph) {
+    Graph g(9);
+    g.addEdge(0, 1);
+    g.addEdge(5, 6);
+    g.addEdge(1, 2);
+    g.addEdge(6, 7);
+    g.addEdge(2, 0);
+
+    EdgeOrderOptimizer const opt(g);
+    for (auto const& x : {opt.breadthFirst(), opt.cuthillMcKee(),
+                          opt.beam(2)}) {
+        ASSERT_TRUE(isPermutation(x.edges, g.numEdges()));
+        ASSERT_LE(x.width, 3);
+    }
+}
+
+TEST(EdgeOrderTest, ReorderedGraphHasSameFamily) {
+    auto                     g = shuffledGrid(4, 4, 3);
+    EdgeOrderOptimizer const opt(g);
+    auto const               x = opt.best();
+    auto const               h = opt.apply(x.edges);
+
+    DdStructure<TestNode> before(SimplePathSpec(g, 0, 15));
+    DdStructure<TestNode> after(SimplePathSpec(h, 0, 15));
+    before.reduceZdd();
+    after.reduceZdd();
+    ASSERT_EQ(184UL, countSets(before));
+    ASSERT_EQ(184UL, countSets(after));
+    ASSERT_LT(after.size(), before.size());
+}
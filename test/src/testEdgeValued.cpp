@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddEdgeValued.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "TestNode.hpp"
+
+struct Load {
+    int64_t weight;
+    int64_t cost;
+};
+
+/**
+ * Sets of items whose total weight is at most a capacity; the state carries
+ * the cost added since the last node.
+ */
+class Knapsack : public DdSpec<Knapsack, Load, 2> {
+    std::vector<int64_t> const weights;
+    std::vector<int64_t> const costs;
+    int64_t const              capacity;
+    int64_t const              base;
+
+   public:
+    Knapsack(std::vector<int64_t> _weights,
+             std::vector<int64_t> _costs,
+             int64_t              _capacity,
+             int64_t              _base = 0)
+        : weights(std::move(_weights)),
+          costs(std::move(_costs)),
+          capacity(_capacity),
+          base(_base) {}
+
+    int getRoot(Load& s) const {
+        s = {0, base};
+        if (capacity < 0) {
+            return 0;
+        }
+        return weights.empty() ? -1 : static_cast<int>(weights.size());
+    }
+
+    int getChild(Load& s, int level, int value) const {
+        if (value) {
+            s.weight += weights[level - 1];
+            s.cost += costs[level - 1];
+            if (s.weight > capacity) {
+                return 0;
+            }
+        }
+        if (--level == 0) {
+            return -1;
+        }
+        return level;
+    }
+
+    int64_t factorOffset(Load& s, int) const {
+        auto const c = s.cost;
+        s.cost = 0;
+        return c;
+    }
+};
+
+using Family = std::map<std::vector<int>, int64_t>;
+
+Family family(EdgeValuedDd<> const& ev) {
+    Family f;
+    ev.forEachSet([&](std::vector<int> const& items, int64_t cost) {
+        EXPECT_TRUE(f.emplace(items, cost).second);
+    });
+    return f;
+}
+
+/**
+ * The family of a plain diagram, with costs recomputed from the items.
+ */
+Family family(DdStructure<TestNode> const& dd,
+              std::vector<int64_t> const&  costs,
+              int64_t                      base) {
+    Family f;
+    for (auto const& s : dd) {
+        std::vector<int> items(s.rbegin(), s.rend());
+        int64_t          c = base;
+        for (int i : items) {
+            c += costs[i - 1];
+        }
+        f.emplace(items, c);
+    }
+    return f;
+}
+
+std::vector<int64_t> const weights{3, 5, 2, 7, 4, 6, 1, 5, 3, 4, 2, 6};
+std::vector<int64_t> const costs{-4, 9, 2, -7, 3, 8, -1, 6, -3, 5, 2, -6};
+
+TEST(EdgeValuedTest, SharesStatesUpToOffset) {
+    Knapsack const        spec(weights, costs, 15);
+    EdgeValuedDd<>        ev(spec);
+    DdStructure<TestNode> plain(spec);
+
+    ASSERT_LT(ev.size() * 4, plain.size());
+    ASSERT_EQ(family(plain, costs, 0), family(ev));
+
+    ev.reduceZdd();
+    plain.reduceZdd();
+    ASSERT_EQ(family(plain, costs, 0), family(ev));
+    ASSERT_LE(ev.size(), plain.size());
+}
+
+TEST(EdgeValuedTest, Minimum) {
+    Knapsack const spec(weights, costs, 15, 10);
+    EdgeValuedDd<> ev(spec);
+
+    auto const f = family(ev);
+    int64_t    best = f.begin()->second;
+    for (auto const& [items, cost] : f) {
+        best = std::min(best, cost);
+    }
+    auto const least = ev.evaluate<int64_t>(
+        [](bool b) { return b ? 0 : INT64_MAX / 2; },
+        [](int, int64_t c0, int64_t c1) { return std::min(c0, c1); });
+    ASSERT_EQ(best, least);
+    ASSERT_EQ(best, ev.minimum());
+
+    ev.reduceZdd();
+    ASSERT_EQ(best, ev.minimum());
+    ASSERT_EQ(best, ev.root().weight);
+}
+
+TEST(EdgeValuedTest, Canonical) {
+    EdgeValuedDd<> a(Knapsack(weights, costs, 15));
+    EdgeValuedDd<> b(Knapsack(weights, costs, 15, 100));
+    a.reduceZdd();
+    b.reduceZdd();
+
+    ASSERT_EQ(a.root().node, b.root().node);
+    ASSERT_EQ(a.root().weight + 100, b.root().weight);
+    ASSERT_EQ(a.numRows(), b.numRows());
+    for (auto i = 1UL; i < a.numRows(); ++i) {
+        ASSERT_EQ(a.levelSize(i), b.levelSize(i));
+        for (auto j = 0UL; j < a.levelSize(i); ++j) {
+            for (size_t c = 0; c < 2; ++c) {
+                ASSERT_EQ(a.child({i, j}, c), b.child({i, j}, c));
+            }
+        }
+    }
+
+    auto const size = a.size();
+    a.reduceZdd();
+    ASSERT_EQ(size, a.size());
+}
+
+TEST(EdgeValuedTest, BddReduction) {
+    EdgeValuedDd<> ev(Knapsack({1, 0, 2, 0}, {5, 0, 7, 0}, 2));
+    ev.bddReduce();
+
+    // levels 2 and 4 neither weigh nor cost anything
+    ASSERT_EQ(0UL, ev.levelSize(2));
+    ASSERT_EQ(0UL, ev.levelSize(4));
+    auto const f = family(ev);
+    ASSERT_EQ(12UL, f.size());
+    ASSERT_EQ(7, f.at({4, 3, 2}));
+    ASSERT_EQ(5, f.at({1}));
+    ASSERT_EQ(0, ev.minimum());
+}
+
+TEST(EdgeValuedTest, TerminalDiagrams) {
+    EdgeValuedDd<> zero(Knapsack(weights, costs, -1));
+    ASSERT_EQ(0UL, zero.size());
+    ASSERT_TRUE(family(zero).empty());
+    ASSERT_THROW((void)zero.minimum(), std::runtime_error);
+
+    EdgeValuedDd<> one(Knapsack({}, {}, 0, 42));
+    ASSERT_EQ(NodeId(1), one.root().node);
+    ASSERT_EQ(42, one.minimum());
+    ASSERT_THROW((void)EdgeValuedDd<>().minimum(), std::runtime_error);
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/util/Executor.hpp>
+#include <ModernDD/util/ThreadPool.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "TestNode.hpp"
+
+/**
+ * Subsets whose weight sum is divisible by m.
+ */
+class WeightModulo : public DdSpec<WeightModulo, int, 2> {
+    int const n;
+    int const m;
+
+   public:
+    WeightModulo(int _n, int _m) : n(_n), m(_m) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state = (state + value * (level * 7919 % m)) % m;
+        if (--level == 0) {
+            return (state == 0) ? -1 : 0;
+        }
+        return level;
+    }
+};
+
+/**
+ * Sets whose weight sum is below a bound; the levels are thousands of nodes
+ * wide and every node reaches the 1-terminal.
+ */
+class Capacity : public DdSpec<Capacity, int, 2> {
+    int const n;
+    int const bound;
+
+   public:
+    Capacity(int _n, int _bound) : n(_n), bound(_bound) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state += value * (level * 7919 % 1000);
+        if (state >= bound) {
+            return 0;
+        }
+        return (--level == 0) ? -1 : level;
+    }
+};
+
+/**
+ * Compares two node tables node by node.
+ */
+template <typename DD>
+bool sameTable(DD const& a, DD const& b) {
+    auto const& x = *a.getDiagram();
+    auto const& y = *b.getDiagram();
+    if (a.root() != b.root() || x.numRows() != y.numRows()) {
+        return false;
+    }
+    for (auto i = 1UL; i < x.numRows(); ++i) {
+        if (x[i].size() != y[i].size()) {
+            return false;
+        }
+        for (auto j = 0UL; j < x[i].size(); ++j) {
+            if (x[i][j][0] != y[i][j][0] || x[i][j][1] != y[i][j][1]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+TEST(ExecutorTest, ThreadPoolPinsWorkers) {
+#ifdef __linux__
+    ThreadPool        pool(2, {0});
+    std::atomic<bool> elsewhere{false};
+    pool.parallel_for(64, [&](size_t) {
+        if (sched_getcpu() != 0) {
+            elsewhere = true;
+        }
+    });
+    ASSERT_FALSE(elsewhere.load());
+#endif
+    ASSERT_THROW(ThreadPool(2, {-1}), std::runtime_error);
+}
+
+TEST(ExecutorTest, OpenMpVisitsEveryIndexOnce) {
+    OpenMpExecutor                executor(3);
+    std::vector<std::atomic<int>> hits(1000);
+
+    executor.parallel_for(hits.size(), [&](size_t i) { ++hits[i]; });
+
+    for (auto& h : hits) {
+        ASSERT_EQ(1, h.load());
+    }
+    ASSERT_THROW(executor.parallel_for(
+                     10,
+                     [](size_t i) {
+                         if (i == 7) {
+                             throw std::runtime_error("task");
+                         }
+                     }),
+                 std::runtime_error);
+}
+
+TEST(ExecutorTest, ExternalRunsOnCallerPool) {
+    ThreadPool       pool(3);
+    ExternalExecutor executor(
+        [&](std::function<void()> task) { pool.submit(std::move(task)); },
+        pool.size());
+    std::vector<std::atomic<int>> hits(1000);
+
+    executor.parallel_for(hits.size(), [&](size_t i) { ++hits[i]; });
+
+    for (auto& h : hits) {
+        ASSERT_EQ(1, h.load());
+    }
+    ASSERT_THROW(executor.parallel_for(
+                     10,
+                     [](size_t i) {
+                         if (i == 3) {
+                             throw std::runtime_error("task");
+                         }
+                     }),
+                 std::runtime_error);
+}
+
+TEST(ExecutorTest, ExternalNestsInSaturatedPool) {
+    ThreadPool       pool(1);
+    ExternalExecutor executor(
+        [&](std::function<void()> task) { pool.submit(std::move(task)); },
+        4);
+    std::atomic<int> sum{0};
+
+    // the only worker of the pool runs the outer loop and waits on nothing
+    // but the iterations it claims itself
+    pool.parallel_for(1, [&](size_t) {
+        executor.parallel_for(8, [&](size_t) {
+            executor.parallel_for(8, [&](size_t j) {
+                sum += static_cast<int>(j);
+            });
+        });
+    });
+
+    ASSERT_EQ(8 * 28, sum.load());
+}
+
+TEST(ExecutorTest, ParallelBuildMatchesSerial) {
+    ThreadPool pool(3);
+    for (auto const& spec : {Capacity(40, 20000), Capacity(9, 1500)}) {
+        DdStructure<TestNode> serial(spec);
+        DdStructure<TestNode> parallel(spec, pool);
+        ASSERT_EQ(&pool, parallel.getExecutor());
+        ASSERT_TRUE(sameTable(serial, parallel));
+
+        serial.reduceZdd();
+        parallel.reduceZdd();
+        ASSERT_TRUE(sameTable(serial, parallel));
+    }
+}
+
+TEST(ExecutorTest, ParallelSubsetMatchesSerial) {
+    ThreadPool            pool(3);
+    DdStructure<TestNode> serial(Capacity(36, 12000));
+    DdStructure<TestNode> parallel(serial);
+    parallel.setExecutor(&pool);
+
+    serial.zddSubset(WeightModulo(36, 7));
+    parallel.zddSubset(WeightModulo(36, 7));
+    ASSERT_TRUE(sameTable(serial, parallel));
+
+    serial.reduceZdd();
+    parallel.reduceZdd();
+    ASSERT_GT(serial.size(), 0UL);
+    ASSERT_TRUE(sameTable(serial, parallel));
+}
+
+TEST(ExecutorTest, ParallelBackwardEvaluation) {
+    ThreadPool                 pool(3);
+    DdStructure<PathCountNode> small(WeightModulo(16, 50));
+    PathCountEval              count;
+    ASSERT_EQ(countSets(small), small.evaluate_backward(count, pool));
+
+    DdStructure<PathCountNode> dd(Capacity(30, 8000));
+    PathCountEval              serial;
+    PathCountEval              parallel;
+    auto const                 expected = dd.evaluate_backward(serial);
+    ASSERT_GT(expected, 1000000UL);
+    ASSERT_EQ(expected, dd.evaluate_backward(parallel, pool));
+}
@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <algorithm>
+#include <array>
+#include <set>
+#include <stdexcept>
+
+#include "TestNode.hpp"
+
+/**
+ * Subsets whose weight sum is divisible by m; taking an item skips the next
+ * level.
+ */
+class WeightModulo : public DdSpec<WeightModulo, int, 2> {
+    int const n;
+    int const m;
+
+   public:
+    WeightModulo(int _n, int _m) : n(_n), m(_m) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state = (state + value * (level * 7919 % m)) % m;
+        level -= (value != 0) ? 2 : 1;
+        if (level <= 0) {
+            return (state == 0) ? -1 : 0;
+        }
+        return level;
+    }
+};
+
+/**
+ * Sets of the largest weight: the 1-terminal keeps only the heaviest
+ * state merged into it.
+ */
+class Heaviest : public DdSpec<Heaviest, int, 2> {
+    int const n;
+
+   public:
+    explicit Heaviest(int _n) : n(_n) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state += value * (level % 3 + 1);
+        return (--level == 0) ? -1 : level;
+    }
+
+    int mergeStates(int& s1, int& s2) const {
+        return (s1 < s2) ? 1 : (s1 > s2) ? 2 : 0;
+    }
+};
+
+/**
+ * Large state counting its live copies.
+ */
+struct Tracked {
+    static inline int live = 0;
+    static inline int peak = 0;
+
+    std::array<int, 16> count{};
+
+    Tracked() { peak = std::max(peak, ++live); }
+    Tracked(Tracked const& o) : count(o.count) {
+        peak = std::max(peak, ++live);
+    }
+    Tracked& operator=(Tracked const&) = default;
+    ~Tracked() { --live; }
+
+    bool operator==(Tracked const& o) const { return count == o.count; }
+};
+
+/**
+ * Sets of k items out of n whose items fall into 16 classes by residue;
+ * the state records the count of each class.
+ */
+class ClassCounts : public DdSpec<ClassCounts, Tracked, 2> {
+    int const n;
+    int const k;
+
+   public:
+    ClassCounts(int _n, int _k) : n(_n), k(_k) {}
+
+    int getRoot(Tracked& s) const {
+        s.count.fill(0);
+        return n;
+    }
+
+    int getChild(Tracked& s, int level, int value) const {
+        if (value != 0) {
+            ++s.count[level % 16];
+        }
+        int total = 0;
+        for (auto c : s.count) {
+            total += c;
+        }
+        if (--level == 0) {
+            return (total == k) ? -1 : 0;
+        }
+        return (total > k || total + level < k) ? 0 : level;
+    }
+
+    size_t hashCode(Tracked const& s) const {
+        size_t h = 0;
+        for (auto c : s.count) {
+            h = h * 31 + static_cast<size_t>(c);
+        }
+        return h;
+    }
+};
+
+/**
+ * Spec whose equality is finer than the bytes of its states.
+ */
+class Inconsistent : public DdSpec<Inconsistent, int, 2> {
+   public:
+    int getRoot(int& state) const {
+        state = 0;
+        return 6;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state += value;
+        return (--level == 0) ? -1 : level;
+    }
+
+    bool equalTo(int const& s1, int const& s2) const {
+        return s1 == s2 && s1 != 2;
+    }
+};
+
+/**
+ * Spec whose first merge at a level replaces the representative and whose
+ * later merges keep it: the state records whether it took part in a merge.
+ */
+class ReplaceOnce : public DdSpec<ReplaceOnce, int, 2> {
+   public:
+    int getRoot(int& state) const {
+        state = 0;
+        return 3;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state = 0;
+        if (level == 3) {
+            return (value != 0) ? 1 : 2;
+        }
+        return (level == 2) ? 1 : -1;
+    }
+
+    int mergeStates(int& s1, int& s2) const {
+        if (s1 != 0) {
+            return 0;
+        }
+        s1 = s2 = 1;
+        return 1;
+    }
+};
+
+template <typename DD>
+std::set<std::set<int>> sets(DD const& dd) {
+    std::set<std::set<int>> s;
+    for (auto const& x : dd) {
+        s.insert(x);
+    }
+    return s;
+}
+
+template <typename SPEC>
+void expectSameAsBreadthFirst(SPEC const& spec) {
+    DdStructure<TestNode> plain(spec);
+    FingerprintReport     report;
+    DdStructure<TestNode> fp(spec, report);
+    ASSERT_EQ(sets(plain), sets(fp));
+    plain.reduceZdd();
+    fp.reduceZdd();
+    ASSERT_EQ(plain.size(), fp.size());
+    ASSERT_EQ(plain, fp);
+
+    ASSERT_GE(report.lookups, report.entries);
+    ASSERT_GE(report.entries, fp.size());
+    ASSERT_EQ(0UL, report.verified);
+    ASSERT_LT(report.collisionBound, 1e-20);
+}
+
+TEST(FingerprintBuilderTest, SameDiagramAsBreadthFirst) {
+    expectSameAsBreadthFirst(Combination(20, 7));
+    expectSameAsBreadthFirst(WeightModulo(24, 11));
+    expectSameAsBreadthFirst(Heaviest(12));
+    expectSameAsBreadthFirst(ClassCounts(20, 4));
+}
+
+TEST(FingerprintBuilderTest, MergesIntoTerminal) {
+    DdStructure<TestNode> dd(Heaviest(12), DdBuildMethod::Fingerprinted);
+    dd.reduceZdd();
+    std::set<int> all;
+    for (int i = 1; i <= 12; ++i) {
+        all.insert(i);
+    }
+    ASSERT_EQ(std::set<std::set<int>>{all}, sets(dd));
+}
+
+TEST(FingerprintBuilderTest, KeepsOneStatePerNode) {
+    Tracked::peak = Tracked::live;
+    {
+        DdStructure<TestNode> dd(ClassCounts(30, 5));
+    }
+    auto const plainPeak = Tracked::peak;
+
+    Tracked::peak = Tracked::live;
+    FingerprintReport report;
+    {
+        DdStructure<TestNode> dd(ClassCounts(30, 5), report, true);
+    }
+    auto const fpPeak = Tracked::peak;
+
+    ASSERT_EQ(0, Tracked::live);
+    ASSERT_EQ(report.lookups - report.entries, report.verified);
+    // the copies scheduled by the other parents of a node are not pending
+    ASSERT_LT(fpPeak, plainPeak);
+}
+
+TEST(FingerprintBuilderTest, MergesIntoReplacedRepresentative) {
+    // level 1 is reached by the 1-edge of the root and by both edges of the
+    // node at level 2; the second state replaces the first one, and the
+    // third must share the replacement
+    FingerprintReport     report;
+    DdStructure<TestNode> dd(ReplaceOnce(), report);
+    auto const&           table = *dd.getDiagram();
+    NodeId const          node = table.child(3, 0, 0);
+    ASSERT_EQ(2UL, node.row());
+    ASSERT_EQ(1UL, table.child(node, 0).row());
+    ASSERT_EQ(table.child(node, 0), table.child(node, 1));
+    ASSERT_EQ(5UL, report.lookups);
+}
+
+TEST(FingerprintBuilderTest, TerminalRoot) {
+    FingerprintReport     report;
+    DdStructure<TestNode> dd(Combination(0, 0), report);
+    ASSERT_EQ(NodeId(0), dd.root());
+    ASSERT_EQ(0UL, report.lookups);
+}
+
+TEST(FingerprintBuilderTest, VerificationReportsMismatch) {
+    FingerprintReport report;
+    ASSERT_NO_THROW(DdStructure<TestNode>(Inconsistent(), report));
+    ASSERT_THROW(DdStructure<TestNode>(Inconsistent(), report, true),
+                 std::runtime_error);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <set>
+#include <vector>
+
+#include "TestNode.hpp"
+
+/**
+ * Weighted subsets under a capacity, with some variables fixed.
+ * Levels skipped by an edge take the value 0, as in a ZDD.
+ */
+class FixedCapacity : public DdSpec<FixedCapacity, int, 2> {
+    int const        n;
+    int const        cap;
+    std::vector<int> fixed;
+
+    bool skipAllowed(int from, int to) const {
+        for (int i = to + 1; i < from; ++i) {
+            if (fixed[i] == 1) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+   public:
+    FixedCapacity(int _n, int _cap) : n(_n), cap(_cap), fixed(_n + 1, -1) {}
+
+    void fix(int level, int value) { fixed[level] = value; }
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        if (fixed[level] >= 0 && fixed[level] != value) {
+            return 0;
+        }
+        state += value * (level % 4 + 1);
+        if (state > cap) {
+            return 0;
+        }
+        int next = level - 1;
+        if (next > 1 && state % 3 == 2) {
+            --next;
+        }
+        if (next == 0) {
+            return -1;
+        }
+        return skipAllowed(level, next) ? next : 0;
+    }
+};
+
+template <typename DD>
+size_t countReachable(DD const& dd) {
+    std::set<NodeId>    seen;
+    std::vector<NodeId> stack{dd.root()};
+    while (!stack.empty()) {
+        NodeId f = stack.back();
+        stack.pop_back();
+        if (f.row() == 0 || !seen.insert(NodeId(f.row(), f.col())).second) {
+            continue;
+        }
+        stack.push_back(dd.child(f, 0));
+        stack.push_back(dd.child(f, 1));
+    }
+    return seen.size();
+}
+
+TEST(FixTest, SingleFixMatchesFixedSpec) {
+    int const n = 16;
+    for (int level = 1; level <= n; ++level) {
+        for (int value = 0; value <= 1; ++value) {
+            DdStructure<TestNode> dd(FixedCapacity(n, 20));
+            dd.reduceZdd();
+            dd.fix(level, value == 1);
+
+            FixedCapacity spec(n, 20);
+            spec.fix(level, value);
+            DdStructure<TestNode> expected(spec);
+            expected.reduceZdd();
+
+            ASSERT_EQ(countReachable(expected), countReachable(dd));
+            ASSERT_EQ(expected, dd);
+            ASSERT_EQ(countSets(expected), countSets(dd));
+            ASSERT_EQ(expected.root().hasEmpty(), dd.root().hasEmpty());
+        }
+    }
+}
+
+TEST(FixTest, IndexedFixMatchesFixedSpec) {
+    int const n = 16;
+    for (int level = 1; level <= n; ++level) {
+        DdStructure<TestNode> dd(FixedCapacity(n, 20));
+        dd.reduceZdd();
+        (*dd.getDiagram()).makeIndex();
+        dd.fix(level, false);
+        dd.fix(n + 1 - level, false);  // the first fix dropped the index
+
+        FixedCapacity spec(n, 20);
+        spec.fix(level, 0);
+        spec.fix(n + 1 - level, 0);
+        DdStructure<TestNode> expected(spec);
+        expected.reduceZdd();
+
+        ASSERT_EQ(countReachable(expected), countReachable(dd));
+        ASSERT_EQ(expected, dd);
+        ASSERT_FALSE((*dd.getDiagram()).hasIndex());
+    }
+}
+
+TEST(FixTest, SequenceOfFixes) {
+    int const             n = 18;
+    DdStructure<TestNode> dd(FixedCapacity(n, 25));
+    dd.reduceZdd();
+    FixedCapacity spec(n, 25);
+
+    int const levels[] = {7, 15, 2, 11, 18, 4};
+    int const values[] = {1, 0, 1, 1, 0, 0};
+    for (int k = 0; k < 6; ++k) {
+        dd.fix(levels[k], values[k] == 1);
+        spec.fix(levels[k], values[k]);
+
+        DdStructure<TestNode> expected(spec);
+        expected.reduceZdd();
+        ASSERT_EQ(countReachable(expected), countReachable(dd));
+        ASSERT_EQ(expected, dd);
+    }
+}
+
+TEST(FixTest, FixAboveRoot) {
+    DdStructure<TestNode> dd(FixedCapacity(6, 10));
+    dd.reduceZdd();
+    DdStructure<TestNode> copy(dd);
+
+    dd.fix(9, false);
+    ASSERT_EQ(copy, dd);
+    dd.fix(9, true);
+    ASSERT_TRUE(dd.empty());
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/ForestSpec.hpp>
+#include <ModernDD/spec/MatchingSpec.hpp>
+#include <ModernDD/spec/PathSpec.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "TestNode.hpp"
+
+template <typename SPEC>
+uint64_t countFamily(SPEC const& spec) {
+    DdStructure<TestNode> dd(spec);
+    dd.reduceZdd();
+    return countZdd(dd);
+}
+
+/**
+ * Brute force classification of an edge subset.
+ */
+class EdgeSubset {
+    std::vector<int> parent;
+    std::vector<int> degree;
+    int              edges{};
+    bool             acyclic{true};
+
+    int find(int v) {
+        while (parent[v] != v) {
+            v = parent[v] = parent[parent[v]];
+        }
+        return v;
+    }
+
+   public:
+    EdgeSubset(Graph const& g, unsigned mask)
+        : parent(g.numVertices()),
+          degree(g.numVertices()) {
+        std::iota(parent.begin(), parent.end(), 0);
+        for (int e = 0; e < g.numEdges(); ++e) {
+            if (((mask >> e) & 1) == 0) {
+                continue;
+            }
+            auto [u, v] = g.edge(e);
+            ++degree[u];
+            ++degree[v];
+            ++edges;
+            if (find(u) == find(v)) {
+                acyclic = false;
+            }
+            parent[find(u)] = find(v);
+        }
+    }
+
+    /// Number of components among the vertices of positive degree.
+    int touchedComponents() {
+        int n = 0;
+        for (int v = 0; v < static_cast<int>(parent.size()); ++v) {
+            n += (degree[v] > 0 && find(v) == v) ? 1 : 0;
+        }
+        return n;
+    }
+
+    bool isForest() const { return acyclic; }
+
+    bool isSpanningTree() const {
+        return acyclic && edges + 1 == static_cast<int>(parent.size());
+    }
+
+    bool isMatching(bool perfect) const {
+        for (auto d : degree) {
+            if (d > 1 || (perfect && d != 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isCycle() {
+        for (auto d : degree) {
+            if (d != 0 && d != 2) {
+                return false;
+            }
+        }
+        return edges > 0 && touchedComponents() == 1;
+    }
+
+    bool isPath(int s, int t) {
+        for (int v = 0; v < static_cast<int>(degree.size()); ++v) {
+            int const d = degree[v];
+            if ((v == s || v == t) ? d != 1 : (d != 0 && d != 2)) {
+                return false;
+            }
+        }
+        return acyclic && touchedComponents() == 1;
+    }
+};
+
+Graph randomGraph(int n, int m, unsigned seed) {
+    std::mt19937                     gen(seed);
+    std::vector<std::pair<int, int>> all;
+    for (int u = 0; u < n; ++u) {
+        for (int v = u + 1; v < n; ++v) {
+            all.emplace_back(u, v);
+        }
+    }
+    std::shuffle(all.begin(), all.end(), gen);
+    Graph g(n);
+    for (int e = 0; e < std::min<int>(m, all.size()); ++e) {
+        if (gen() % 2) {
+            g.addEdge(all[e].first, all[e].second);
+        } else {
+            g.addEdge(all[e].second, all[e].first);
+        }
+    }
+    return g;
+}
+
+TEST(FrontierSpecTest, GridPaths) {
+    uint64_t const A007764[] = {2, 12, 184, 8512, 1262816, 575780564};
+    for (int n = 1; n <= 6; ++n) {
+        auto g = Graph::grid(n + 1, n + 1);
+        ASSERT_EQ(A007764[n - 1],
+                  countFamily(SimplePathSpec(g, 0, g.numVertices() - 1)));
+    }
+}
+
+TEST(FrontierSpecTest, KnownCounts) {
+    ASSERT_EQ(7UL, countFamily(CycleSpec(Graph::complete(4))));
+    ASSERT_EQ(37UL, countFamily(CycleSpec(Graph::complete(5))));
+    ASSERT_EQ(213UL, countFamily(CycleSpec(Graph::grid(4, 4))));
+
+    ASSERT_EQ(1296UL, countFamily(SpanningTreeSpec(Graph::complete(6))));
+    ASSERT_EQ(100352UL, countFamily(SpanningTreeSpec(Graph::grid(4, 4))));
+    ASSERT_EQ(38UL, countFamily(ForestSpec(Graph::complete(4))));
+
+    ASSERT_EQ(10UL, countFamily(MatchingSpec(Graph::complete(4))));
+    ASSERT_EQ(131UL, countFamily(MatchingSpec(Graph::grid(3, 3))));
+    ASSERT_EQ(6728UL, countFamily(MatchingSpec(Graph::grid(6, 6), true)));
+}
+
+TEST(FrontierSpecTest, RandomGraphsMatchBruteForce) {
+    for (unsigned seed = 0; seed < 12; ++seed) {
+        int const n = 5 + static_cast<int>(seed % 3);
+        auto      g = randomGraph(n, 11, seed);
+
+        uint64_t path = 0;
+        uint64_t cycle = 0;
+        uint64_t forest = 0;
+        uint64_t tree = 0;
+        uint64_t matching = 0;
+        uint64_t perfect = 0;
+        for (unsigned mask = 0; mask < (1U << g.numEdges()); ++mask) {
+            EdgeSubset x(g, mask);
+            path += x.isPath(0, n - 1) ? 1 : 0;
+            cycle += x.isCycle() ? 1 : 0;
+            forest += x.isForest() ? 1 : 0;
+            tree += x.isSpanningTree() ? 1 : 0;
+            matching += x.isMatching(false) ? 1 : 0;
+            perfect += x.isMatching(true) ? 1 : 0;
+        }
+
+        ASSERT_EQ(path, countFamily(SimplePathSpec(g, 0, n - 1)));
+        ASSERT_EQ(cycle, countFamily(CycleSpec(g)));
+        ASSERT_EQ(forest, countFamily(ForestSpec(g)));
+        ASSERT_EQ(tree, countFamily(SpanningTreeSpec(g)));
+        ASSERT_EQ(matching, countFamily(MatchingSpec(g)));
+        ASSERT_EQ(perfect, countFamily(MatchingSpec(g, true)));
+    }
+}
+
+TEST(FrontierSpecTest, DegenerateGraphs) {
+    Graph g(3);
+    ASSERT_EQ(0UL, countFamily(SimplePathSpec(g, 0, 2)));
+    ASSERT_EQ(0UL, countFamily(CycleSpec(g)));
+    ASSERT_EQ(1UL, countFamily(ForestSpec(g)));
+    ASSERT_EQ(0UL, countFamily(SpanningTreeSpec(g)));
+    ASSERT_EQ(1UL, countFamily(MatchingSpec(g)));
+    ASSERT_EQ(0UL, countFamily(MatchingSpec(g, true)));
+
+    ASSERT_EQ(1UL, countFamily(SpanningTreeSpec(Graph(1))));
+    ASSERT_THROW(SimplePathSpec(g, 1, 1), std::runtime_error);
+    ASSERT_THROW(g.addEdge(0, 3), std::runtime_error);
+}
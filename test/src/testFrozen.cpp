@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddBulkLoader.hpp>
+#include <ModernDD/NodeBddFrozen.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/FrontierManager.hpp>
+#include <ModernDD/spec/PathSpec.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "TestNode.hpp"
+
+template <typename T>
+void expectSameStructure(DdStructure<T> const& dd, FrozenDd const& frozen) {
+    auto const& table = *dd.getDiagram();
+    ASSERT_EQ(dd.root(), frozen.root());
+    ASSERT_EQ(dd.root().getAttr(), frozen.root().getAttr());
+    ASSERT_EQ(dd.size(), frozen.size());
+    ASSERT_EQ(table.numRows(), frozen.numRows());
+    for (auto i = 1UL; i < table.numRows(); ++i) {
+        ASSERT_EQ(table[i].size(), frozen.levelSize(i));
+        for (auto j = 0UL; j < table[i].size(); ++j) {
+            for (size_t b = 0; b < 2; ++b) {
+                NodeId const f = table.child(i, j, b);
+                ASSERT_EQ(f, frozen.child({i, j}, b));
+                ASSERT_EQ(f.getAttr(), frozen.child({i, j}, b).getAttr());
+            }
+        }
+    }
+}
+
+uint64_t countFrozen(FrozenDd const& frozen) {
+    return frozen.evaluate<uint64_t>(
+        [](bool b) { return b ? 1UL : 0UL; },
+        [](int, uint64_t c0, uint64_t c1) { return c0 + c1; });
+}
+
+TEST(FrozenTest, SameStructure) {
+    DdStructure<TestNode> unreduced(Combination(30, 11));
+    DdStructure<TestNode> reduced(unreduced);
+    reduced.reduceZdd();
+    auto const            g = Graph::grid(6, 6);
+    DdStructure<TestNode> paths(SimplePathSpec(g, 0, 35));
+    paths.reduceZdd();
+
+    for (auto const* dd : {&unreduced, &reduced, &paths}) {
+        FrozenDd const frozen(*dd);
+        expectSameStructure(*dd, frozen);
+    }
+    ASSERT_EQ(54627300UL, countFrozen(FrozenDd(reduced)));
+    ASSERT_EQ(54627300UL, countFrozen(FrozenDd(unreduced)));
+    ASSERT_EQ(1262816UL, countFrozen(FrozenDd(paths)));
+}
+
+TEST(FrozenTest, EvaluatesMinimum) {
+    DdStructure<TestNode> dd(Combination(20, 7));
+    dd.reduceZdd();
+    FrozenDd const frozen(dd);
+
+    int const none = 1000;
+    auto const least = frozen.evaluate<int>(
+        [&](bool b) { return b ? 0 : none; },
+        [&](int, int c0, int c1) { return std::min(c0, c1 + 1); });
+    auto const most = frozen.evaluate<int>(
+        [&](bool b) { return b ? 0 : -none; },
+        [&](int, int c0, int c1) { return std::max(c0, c1 + 1); });
+    ASSERT_EQ(7, least);
+    ASSERT_EQ(7, most);
+}
+
+TEST(FrozenTest, IsSmallerThanTable) {
+    auto const            g = Graph::grid(7, 7);
+    DdStructure<TestNode> dd(SimplePathSpec(g, 0, 48));
+    dd.reduceZdd();
+    FrozenDd const frozen(dd);
+
+    auto const tableBytes = dd.size() * sizeof(TestNode);
+    auto const childBytes = dd.size() * 2 * sizeof(NodeId);
+    ASSERT_LT(frozen.bytes() * 3, childBytes);
+    ASSERT_LT(frozen.bytes() * 6, tableBytes);
+}
+
+TEST(FrozenTest, KeepsEmptySetAttributes) {
+    std::vector<std::set<int>> family;
+    for (int k = 0; k <= 3; ++k) {
+        for (auto const& s : DdStructure<TestNode>(Combination(10, k))) {
+            family.push_back(s);
+        }
+    }
+    std::sort(family.begin(), family.end(), ZddLoadOrder());
+    ZddBulkLoader<TestNode> loader(10);
+    for (auto const& s : family) {
+        loader.add(s);
+    }
+    auto       atMost = loader.finish();
+    auto       reduced = atMost;
+    reduced.reduceZdd();
+
+    loader.add(std::vector<int>{});
+    loader.add(std::vector<int>{1});
+    loader.add(std::vector<int>{2});
+    auto       small = loader.finish();
+
+    for (auto const* dd : {&atMost, &reduced, &small}) {
+        ASSERT_TRUE(dd->root().hasEmpty());
+        FrozenDd const frozen(*dd);
+        expectSameStructure(*dd, frozen);
+    }
+    ASSERT_EQ(176UL, countFrozen(FrozenDd(reduced)));
+    ASSERT_EQ(3UL, countFrozen(FrozenDd(small)));
+}
+
+TEST(FrozenTest, TerminalDiagrams) {
+    DdStructure<TestNode> one(Combination(4, 0));
+    one.reduceZdd();
+    DdStructure<TestNode> zero(Combination(4, 5));
+
+    FrozenDd const frozenOne(one);
+    FrozenDd const frozenZero(zero);
+    ASSERT_EQ(0UL, frozenOne.size());
+    ASSERT_EQ(1UL, countFrozen(frozenOne));
+    ASSERT_EQ(0UL, countFrozen(frozenZero));
+    ASSERT_EQ(0UL, countFrozen(FrozenDd()));
+}
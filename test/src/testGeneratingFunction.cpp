@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddBulkLoader.hpp>
+#include <ModernDD/NodeBddGeneratingFunction.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/util/ThreadPool.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "TestNode.hpp"
+
+/**
+ * Subsets whose weight sum is divisible by m; taking an item skips the next
+ * level.
+ */
+class WeightModulo : public DdSpec<WeightModulo, int, 2> {
+    int const n;
+    int const m;
+
+   public:
+    WeightModulo(int _n, int _m) : n(_n), m(_m) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state = (state + value * (level * 7919 % m)) % m;
+        level -= (value != 0) ? 2 : 1;
+        if (level <= 0) {
+            return (state == 0) ? -1 : 0;
+        }
+        return level;
+    }
+};
+
+/**
+ * Counts the sets of a family by weight, capping at the last bucket.
+ */
+template <typename DD>
+std::vector<uint64_t> bruteForce(DD const&                  dd,
+                                 size_t                     cap,
+                                 std::vector<size_t> const& weight) {
+    std::vector<uint64_t> count(cap + 1);
+    for (auto const& s : dd) {
+        size_t w = 0;
+        for (auto i : s) {
+            w += weight.empty() ? 1 : weight[i];
+        }
+        ++count[std::min(w, cap)];
+    }
+    return count;
+}
+
+/**
+ * Binomial coefficients of a row of Pascal's triangle.
+ */
+template <typename C>
+std::vector<C> binomials(size_t n) {
+    std::vector<C> row{C(1)};
+    row.resize(n + 1);
+    for (auto k = 1UL; k <= n; ++k) {
+        for (auto j = k; j > 0; --j) {
+            row[j] = row[j] + row[j - 1];
+        }
+    }
+    return row;
+}
+
+TEST(GeneratingFunctionTest, CountsBySize) {
+    DdStructure<TestNode> const all(12);
+    ASSERT_EQ(binomials<uint64_t>(12),
+              DdGeneratingFunction<TestNode>(12).evaluate(all));
+
+    // sizes 5 and above share the last bucket
+    auto const row = binomials<uint64_t>(12);
+    auto const capped = DdGeneratingFunction<TestNode>(5).evaluate(all);
+    ASSERT_EQ(6UL, capped.size());
+    for (auto k = 0; k < 5; ++k) {
+        ASSERT_EQ(row[k], capped[k]);
+    }
+    ASSERT_EQ(4096UL - 1 - 12 - 66 - 220 - 495, capped[5]);
+}
+
+TEST(GeneratingFunctionTest, MatchesEnumeration) {
+    DdStructure<TestNode> dd(WeightModulo(20, 5));
+    std::vector<size_t>   weight(21);
+    for (auto i = 1UL; i <= 20; ++i) {
+        weight[i] = i % 4;  // includes items of weight 0
+    }
+    for (auto const cap : {0UL, 3UL, 10UL, 40UL}) {
+        for (int reduced = 0; reduced < 2; ++reduced) {
+            ASSERT_EQ(bruteForce(dd, cap, {}),
+                      DdGeneratingFunction<TestNode>(cap).evaluate(dd));
+            ASSERT_EQ(bruteForce(dd, cap, weight),
+                      DdGeneratingFunction<TestNode>(cap, weight).evaluate(dd));
+            dd.reduceZdd();
+        }
+    }
+}
+
+TEST(GeneratingFunctionTest, LoadedFamily) {
+    std::mt19937               rng(3);
+    std::vector<std::set<int>> family(500);
+    std::vector<size_t>        weight(31);
+    for (auto& w : weight) {
+        w = rng() % 7;
+    }
+    for (auto& s : family) {
+        for (auto i = 1; i <= 30; ++i) {
+            if (rng() % 4 == 0) {
+                s.insert(i);
+            }
+        }
+    }
+    std::sort(family.begin(), family.end(), ZddLoadOrder());
+    ZddBulkLoader<TestNode> loader(30);
+    for (auto const& s : family) {
+        loader.add(s);
+    }
+    auto const dd = loader.finish();
+    ASSERT_EQ(bruteForce(dd, 60, weight),
+              DdGeneratingFunction<TestNode>(60, weight).evaluate(dd));
+}
+
+TEST(GeneratingFunctionTest, WideAndModularCoefficients) {
+    DdStructure<TestNode> const all(100);
+    __extension__ typedef unsigned __int128 Wide;
+    auto const wide = DdGeneratingFunction<TestNode, Wide>(100).evaluate(all);
+    ASSERT_EQ(binomials<Wide>(100), wide);
+    ASSERT_GT(wide[50], Wide(UINT64_MAX));
+
+    using Mod = ModularCount<1000000007>;
+    auto const mod = DdGeneratingFunction<TestNode, Mod>(100).evaluate(all);
+    ASSERT_EQ(binomials<Mod>(100), mod);
+    ASSERT_EQ(Mod(static_cast<uint64_t>(wide[50] % 1000000007)), mod[50]);
+}
+
+TEST(GeneratingFunctionTest, Executor) {
+    DdStructure<TestNode> dd(WeightModulo(40, 50));
+    dd.reduceZdd();
+    ThreadPool pool(3);
+    auto const serial = DdGeneratingFunction<TestNode>(25).evaluate(dd);
+    auto const parallel =
+        DdGeneratingFunction<TestNode>(25, &pool, 16).evaluate(dd);
+    ASSERT_EQ(serial, parallel);
+}
+
+TEST(GeneratingFunctionTest, TerminalsAndBadWeights) {
+    ZddBulkLoader<TestNode> loader(3);
+    ASSERT_EQ((std::vector<uint64_t>{0, 0, 0}),
+              DdGeneratingFunction<TestNode>(2).evaluate(loader.finish()));
+    loader.add(std::vector<int>{});
+    ASSERT_EQ((std::vector<uint64_t>{1, 0, 0}),
+              DdGeneratingFunction<TestNode>(2).evaluate(loader.finish()));
+
+    DdStructure<TestNode> const all(5);
+    ASSERT_THROW(DdGeneratingFunction<TestNode>(2, {0, 1, 1}).evaluate(all),
+                 std::runtime_error);
+}
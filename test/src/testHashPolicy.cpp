@@ -0,0 +1,174 @@
+// The whole test runs the library with the strong policy, whatever the
+// build selected.
+#undef MODERNDD_HASH_POLICY
+#define MODERNDD_HASH_POLICY Mix64Hash
+
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/PathSpec.hpp>
+#include <ModernDD/util/HashPolicy.hpp>
+#include <ModernDD/util/MyHashTable.hpp>
+#include <algorithm>
+#include <bit>
+#include <boost/container_hash/extensions.hpp>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "TestNode.hpp"
+
+/**
+ * The distinct nodes of real diagrams, the keys of the reducer's unique
+ * tables.
+ */
+std::vector<NodeBase> diagramNodes() {
+    std::vector<NodeBase> nodes;
+    DdStructure<TestNode> comb(Combination(200, 30));
+    DdStructure<TestNode> paths(SimplePathSpec(Graph::grid(6, 6), 0, 35));
+    for (auto const* dd : {&comb, &paths}) {
+        auto const& table = *dd->getDiagram();
+        for (auto i = 1UL; i < table.numRows(); ++i) {
+            for (auto j = 0UL; j < table[i].size(); ++j) {
+                nodes.emplace_back(table.child(i, j, 0), table.child(i, j, 1));
+            }
+        }
+    }
+    std::ranges::sort(nodes, [](NodeBase const& a, NodeBase const& b) {
+        return std::pair(a[0].code(), a[1].code()) <
+               std::pair(b[0].code(), b[1].code());
+    });
+    auto const dup = std::ranges::unique(nodes);
+    nodes.erase(dup.begin(), dup.end());
+    return nodes;
+}
+
+template <typename P>
+size_t hashNode(NodeBase const& n) {
+    return n.hashWith<P>();
+}
+
+/**
+ * The multiplicative fold of the spec states, applied to nodes.
+ */
+struct MultiplicativeFold : MultiplicativeHash {
+    static constexpr bool historical = false;
+};
+
+/**
+ * Chi-square statistic of the bucket loads divided by its degrees of
+ * freedom; about 1 for a uniform hash.
+ */
+template <typename P, typename BUCKET>
+double chiSquare(std::vector<NodeBase> const& nodes,
+                 size_t                       buckets,
+                 BUCKET                       bucket) {
+    std::vector<double> load(buckets);
+    for (auto const& n : nodes) {
+        load[bucket(hashNode<P>(n))] += 1;
+    }
+    double const expected = static_cast<double>(nodes.size()) / buckets;
+    double       chi = 0;
+    for (auto l : load) {
+        chi += (l - expected) * (l - expected) / expected;
+    }
+    return chi / static_cast<double>(buckets - 1);
+}
+
+template <typename P>
+struct PolicyHasher {
+    size_t operator()(NodeBase const& n) const { return hashNode<P>(n); }
+
+    bool operator()(NodeBase const& a, NodeBase const& b) const {
+        return a == b;
+    }
+};
+
+TEST(HashPolicyTest, LibraryUsesConfiguredPolicy) {
+    ASSERT_TRUE((std::is_same_v<DdHash, Mix64Hash>));
+    NodeId const f(3, 5);
+    ASSERT_EQ(Mix64Hash::hash(f.code()), f.hash());
+
+    DdStructure<TestNode> comb(Combination(30, 11));
+    comb.reduceZdd();
+    ASSERT_EQ(54627300UL, countZdd(comb));
+    ASSERT_EQ(11UL * (30 - 11 + 1), comb.size());
+
+    DdStructure<TestNode> paths(SimplePathSpec(Graph::grid(7, 7), 0, 48));
+    paths.reduceZdd();
+    ASSERT_EQ(575780564UL, countZdd(paths));
+}
+
+TEST(HashPolicyTest, OrderSensitive) {
+    for (auto const& n : diagramNodes()) {
+        if (n[0] != n[1]) {
+            NodeBase const swapped(n[1], n[0]);
+            ASSERT_NE(hashNode<Mix64Hash>(n), hashNode<Mix64Hash>(swapped));
+            ASSERT_NE(hashNode<MultiplicativeHash>(n),
+                      hashNode<MultiplicativeHash>(swapped));
+        }
+    }
+}
+
+TEST(HashPolicyTest, UniformOnDiagramNodes) {
+    auto const nodes = diagramNodes();
+    ASSERT_GT(nodes.size(), 5000UL);
+
+    for (size_t bits : {8UL, 12UL}) {
+        auto const mask = (size_t{1} << bits) - 1;
+        auto const low = [&](size_t h) { return h & mask; };
+        auto const high = [&](size_t h) { return h >> (64 - bits); };
+        EXPECT_LT(chiSquare<Mix64Hash>(nodes, mask + 1, low), 1.3);
+        EXPECT_LT(chiSquare<Mix64Hash>(nodes, mask + 1, high), 1.3);
+    }
+    for (size_t prime : {1031UL, 4099UL}) {
+        auto const mod = [&](size_t h) { return h % prime; };
+        EXPECT_LT(chiSquare<Mix64Hash>(nodes, prime, mod), 1.3);
+        EXPECT_LT(chiSquare<MultiplicativeHash>(nodes, prime, mod), 1.3);
+    }
+
+    // the low bits of the multiplicative fold ignore the high bits of the
+    // codes, so nodes differing only by the rows of their children collide
+    auto const low = [](size_t h) { return h & 4095U; };
+    EXPECT_GT(chiSquare<MultiplicativeFold>(nodes, 4096, low),
+              2 * chiSquare<Mix64Hash>(nodes, 4096, low));
+}
+
+TEST(HashPolicyTest, HistoricalHashes) {
+    NodeBase const n(NodeId(3, 5), NodeId(2, 7));
+    size_t         h = 0;
+    boost::hash_combine(h, n[0].code());
+    boost::hash_combine(h, n[1].code());
+    ASSERT_EQ(h, n.hashWith<MultiplicativeHash>());
+    ASSERT_EQ(n[0].code() * 314159257, MultiplicativeHash::hash(n[0].code()));
+}
+
+TEST(HashPolicyTest, Avalanche) {
+    double total = 0;
+    int    trials = 0;
+    for (uint64_t x = 1; x < 4096; x += 7) {
+        auto const h = Mix64Hash::hash(x);
+        for (int b = 0; b < 64; ++b) {
+            auto const flipped = Mix64Hash::hash(x ^ (uint64_t{1} << b));
+            total += std::popcount(h ^ flipped);
+            ++trials;
+        }
+    }
+    auto const mean = total / trials;
+    ASSERT_GT(mean, 30.0);
+    ASSERT_LT(mean, 34.0);
+}
+
+TEST(HashPolicyTest, ShortProbeChains) {
+    auto const nodes = diagramNodes();
+    MyHashTable<NodeBase, PolicyHasher<Mix64Hash>, PolicyHasher<Mix64Hash>>
+        table(nodes.size());
+    for (auto const& n : nodes) {
+        if (!(n == NodeBase())) {
+            table.add(n);
+        }
+    }
+    // linear probing up to 75% fill expects about 0.7 extra probes per key
+    ASSERT_LT(table.collisions(), table.size());
+}
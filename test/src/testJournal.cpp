@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <stdexcept>
+
+#include "TestNode.hpp"
+
+TEST(JournalTest, TableRollback) {
+    NodeTableEntity<TestNode> table(3);
+    table.initRow(1, 2);
+    table.initRow(2, 1);
+    table[1][0] = TestNode(NodeId(0), NodeId(1));
+    table[1][1] = TestNode(NodeId(1), NodeId(1));
+    table[2][0] = TestNode(NodeId(1, 0), NodeId(1, 1));
+
+    table.checkpoint();
+    table.setChild(2, 0, 1, NodeId(0));
+    table.setNode(1, 0, table[1][1]);
+    table.resizeRow(1, 1);
+    table.resizeRow(2, 3);
+    ASSERT_EQ(4UL, table.journalSize());
+    table.rollback();
+
+    ASSERT_FALSE(table.journaling());
+    ASSERT_EQ(2UL, table[1].size());
+    ASSERT_EQ(1UL, table[2].size());
+    ASSERT_EQ(NodeId(0), table[1][0][0]);
+    ASSERT_EQ(NodeId(1), table[1][1][0]);
+    ASSERT_EQ(NodeId(1, 1), table[2][0][1]);
+    ASSERT_THROW(table.rollback(), std::runtime_error);
+}
+
+TEST(JournalTest, NestedFixesRollBack) {
+    DdStructure<TestNode> dd(Combination(20, 6));
+    dd.reduceZdd();
+    DdStructure<TestNode> const original(dd);
+
+    dd.checkpoint();
+    dd.fix(12, true);
+    DdStructure<TestNode> const afterFirst(dd);
+
+    dd.checkpoint();
+    dd.fix(5, false);
+    dd.fix(17, true);
+    ASSERT_NE(afterFirst, dd);
+
+    dd.rollback();
+    ASSERT_EQ(afterFirst, dd);
+    ASSERT_EQ(afterFirst.size(), dd.size());
+
+    dd.rollback();
+    ASSERT_EQ(original, dd);
+    ASSERT_EQ(original.size(), dd.size());
+    ASSERT_EQ(countSets(original), countSets(dd));
+}
+
+TEST(JournalTest, CommitKeepsChangesForOuterRollback) {
+    DdStructure<TestNode> dd(Combination(16, 5));
+    dd.reduceZdd();
+    DdStructure<TestNode> const original(dd);
+
+    dd.checkpoint();
+    dd.checkpoint();
+    dd.fix(3, true);
+    dd.commit();
+    DdStructure<TestNode> const committed(dd);
+    ASSERT_NE(original, committed);
+
+    for (int level : {9, 2, 14, 7, 11}) {  // six items out of k = 5
+        dd.fix(level, true);
+    }
+    ASSERT_TRUE(dd.empty());
+
+    dd.rollback();
+    ASSERT_EQ(original, dd);
+    ASSERT_EQ(original.size(), dd.size());
+}
+
+TEST(JournalTest, TableReplacementIsRejected) {
+    DdStructure<TestNode> dd(Combination(10, 3));
+    dd.checkpoint();
+    ASSERT_THROW(dd.reduceZdd(), std::runtime_error);
+    dd.commit();
+    dd.reduceZdd();
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <ModernDD/NodeBddPartitionedBuilder.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/PathSpec.hpp>
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "TestNode.hpp"
+
+/**
+ * Sets of items without two consecutive ones whose sum is a multiple of m;
+ * taking an item skips the next level.
+ */
+class SumModulo : public DdSpec<SumModulo, int, 2> {
+    int const   n;
+    int const   m;
+    pid_t const failIn;
+
+   public:
+    SumModulo(int _n, int _m, pid_t _failIn = 0)
+        : n(_n),
+          m(_m),
+          failIn(_failIn) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        if (failIn != 0 && ::getpid() != failIn && level == n / 2) {
+            throw std::runtime_error("worker failure");
+        }
+        state = (state + value * level) % m;
+        level -= (value != 0) ? 2 : 1;
+        if (level <= 0) {
+            return (state == 0) ? -1 : 0;
+        }
+        return level;
+    }
+};
+
+template <typename DD>
+std::set<std::set<int>> sets(DD const& dd) {
+    std::set<std::set<int>> s;
+    for (auto const& x : dd) {
+        s.insert(x);
+    }
+    return s;
+}
+
+TEST(PartitionedBuilderTest, MatchesSerialBuild) {
+    DdStructure<TestNode> serial(Combination(14, 5));
+    serial.reduceZdd();
+    for (int p = 1; p <= 4; ++p) {
+        auto dd = buildPartitioned<TestNode>(Combination(14, 5), p);
+        ASSERT_EQ(2002UL, countZdd(dd));
+        dd.reduceZdd();
+        ASSERT_EQ(serial.size(), dd.size());
+        ASSERT_EQ(sets(serial), sets(dd));
+    }
+}
+
+TEST(PartitionedBuilderTest, FrontierSpec) {
+    SimplePathSpec const spec(Graph::grid(5, 5), 0, 24);
+    for (int p : {2, 3}) {
+        auto dd = buildPartitioned<TestNode>(spec, p);
+        dd.reduceZdd();
+        ASSERT_EQ(8512UL, countZdd(dd));
+    }
+}
+
+TEST(PartitionedBuilderTest, ShardsAreConsistent) {
+    int const                ranks = 3;
+    UnixSocketMesh           mesh(ranks);
+    std::vector<DdShard>     shards(ranks);
+    std::vector<std::thread> threads;
+    for (int r = 0; r < ranks; ++r) {
+        threads.emplace_back([&, r] {
+            auto transport = mesh.connect(r);
+            shards[r] =
+                DdPartitionedBuilder<SumModulo>(SumModulo(12, 5), transport)
+                    .build();
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    auto const& s0 = shards[0];
+    ASSERT_EQ(NodeId(12, 0), s0.root);
+    for (auto i = 1UL; i < s0.numRows(); ++i) {
+        size_t total = 0;
+        for (auto const& s : shards) {
+            ASSERT_EQ(s0.rowSize[i], s.rowSize[i]);
+            ASSERT_EQ(total, s.first[i]);
+            total += s.size(i);
+            for (auto const& f : s.children[i]) {
+                ASSERT_LT(f.row(), i);
+                ASSERT_LT(f.col(), s0.rowSize[f.row()]);
+            }
+        }
+        ASSERT_EQ(s0.rowSize[i], total);
+        // one node per residue
+        ASSERT_LE(s0.rowSize[i], 5UL);
+    }
+    // the states of a level are spread over the ranks
+    ASSERT_GT(shards[1].size(6) + shards[2].size(6), 0UL);
+
+    auto dd = assembleShards<TestNode>(shards);
+    auto serial = DdStructure<TestNode>(SumModulo(12, 5));
+    ASSERT_EQ(countZdd(serial), countZdd(dd));
+
+    auto again = assembleShards<TestNode>(
+        {DdShard::deserialize(shards[0].serialize()),
+         DdShard::deserialize(shards[1].serialize()),
+         DdShard::deserialize(shards[2].serialize())});
+    ASSERT_EQ(countZdd(dd), countZdd(again));
+}
+
+/**
+ * The family containing only the empty set.
+ */
+class EmptySet : public DdSpec<EmptySet, int, 2> {
+   public:
+    int getRoot(int& state) const {
+        state = 0;
+        return -1;
+    }
+
+    int getChild(int&, int, int) const { return 0; }
+};
+
+TEST(PartitionedBuilderTest, TerminalRoot) {
+    auto one = buildPartitioned<TestNode>(EmptySet(), 2);
+    ASSERT_EQ(NodeId(1), one.root());
+    auto zero = buildPartitioned<TestNode>(Combination(0, 0), 2);
+    ASSERT_EQ(NodeId(0), zero.root());
+}
+
+TEST(PartitionedBuilderTest, WorkerFailure) {
+    ASSERT_THROW(buildPartitioned<TestNode>(SumModulo(12, 5, ::getpid()), 3),
+                 std::runtime_error);
+    // the calling process is still usable
+    auto dd = buildPartitioned<TestNode>(SumModulo(12, 5), 2);
+    ASSERT_EQ(countZdd(DdStructure<TestNode>(SumModulo(12, 5))), countZdd(dd));
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/util/SpscQueue.hpp>
+#include <cstdint>
+#include <thread>
+
+#include "TestNode.hpp"
+
+/**
+ * Spec that skips levels, so children are scheduled below i - 1 as well.
+ */
+class Skipping : public DdSpec<Skipping, int, 2> {
+    int const n;
+    int const m;
+
+   public:
+    Skipping(int _n, int _m) : n(_n), m(_m) {}
+
+    int getRoot(int& state) const {
+        state = 1;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state = (state * 3 + value * level) % m;
+        if (level <= 2) {
+            return (state % 2 == 0) ? -1 : 0;
+        }
+        return (state % 5 == 0) ? level - 2 : level - 1;
+    }
+};
+
+TEST(SpscQueueTest, DeliversInOrder) {
+    SpscQueue<int, 8> queue;
+    int const         n = 100000;
+    int64_t           sum = 0;
+    bool              ordered = true;
+
+    std::thread consumer([&] {
+        int x = 0;
+        int expected = 0;
+        while (true) {
+            if (queue.pop(x)) {
+                ordered = ordered && x == expected++;
+                sum += x;
+            } else if (queue.closed()) {
+                while (queue.pop(x)) {
+                    ordered = ordered && x == expected++;
+                    sum += x;
+                }
+                break;
+            }
+        }
+    });
+    for (int i = 0; i < n; ++i) {
+        queue.push(i);
+    }
+    queue.close();
+    consumer.join();
+
+    ASSERT_TRUE(ordered);
+    ASSERT_EQ(int64_t(n) * (n - 1) / 2, sum);
+}
+
+TEST(PipelinedBuilderTest, MatchesBreadthFirst) {
+    for (int n = 1; n <= 30; n += 3) {
+        for (int k = 0; k <= n; k += 2) {
+            DdStructure<TestNode> bfs(Combination(n, k));
+            DdStructure<TestNode> pip(Combination(n, k),
+                                      DdBuildMethod::Pipelined);
+
+            ASSERT_EQ(bfs.size(), pip.size());
+            ASSERT_EQ(bfs, pip);
+            bfs.reduceZdd();
+            pip.reduceZdd();
+            ASSERT_EQ(bfs.size(), pip.size());
+            ASSERT_EQ(bfs, pip);
+        }
+    }
+}
+
+TEST(PipelinedBuilderTest, SkippedLevels) {
+    for (int m = 7; m <= 211; m += 17) {
+        DdStructure<TestNode> bfs(Skipping(40, m));
+        DdStructure<TestNode> pip(Skipping(40, m), DdBuildMethod::Pipelined);
+
+        ASSERT_EQ(bfs.size(), pip.size());
+        bfs.reduceZdd();
+        pip.reduceZdd();
+        ASSERT_EQ(bfs.size(), pip.size());
+        ASSERT_EQ(bfs, pip);
+    }
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddProfile.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "TestNode.hpp"
+
+TEST(ProfileTest, RecordsPhasesPerLevel) {
+    DdProfile profile;
+    {
+        DdProfile::Activation const on(profile);
+        ASSERT_EQ(&profile, DdProfile::active());
+
+        DdStructure<PathCountNode> dd(Combination(20, 6));
+        dd.reduceZdd();
+        PathCountEval count;
+        ASSERT_EQ(38760UL, dd.evaluate_backward(count));
+        ASSERT_EQ(1UL, profile.at(DdPhase::Evaluate, dd.root().row()).calls);
+    }
+    ASSERT_EQ(nullptr, DdProfile::active());
+
+    ASSERT_EQ(21UL, profile.numLevels(DdPhase::Construct));
+    ASSERT_EQ(21UL, profile.numLevels(DdPhase::Reduce));
+    for (auto i = 1UL; i <= 20; ++i) {
+        ASSERT_EQ(1UL, profile.at(DdPhase::Construct, i).calls);
+        ASSERT_EQ(1UL, profile.at(DdPhase::Reduce, i).calls);
+    }
+    // the sweeper does nothing at the bottom level
+    ASSERT_EQ(0UL, profile.at(DdPhase::Sweep, 1).calls);
+    ASSERT_EQ(19UL, profile.total(DdPhase::Sweep).calls);
+    ASSERT_EQ(1UL, profile.total(DdPhase::Evaluate).calls);
+    ASSERT_EQ(0UL, profile.at(DdPhase::Construct, 100).calls);
+}
+
+TEST(ProfileTest, PipelinedConstruction) {
+    DdProfile profile;
+    {
+        DdProfile::Activation const on(profile);
+        DdStructure<PathCountNode> dd(Combination(16, 4),
+                                      DdBuildMethod::Pipelined);
+    }
+    ASSERT_EQ(16UL, profile.total(DdPhase::Construct).calls);
+}
+
+TEST(ProfileTest, RecordsOnlyWhileActive) {
+    DdProfile outer;
+    DdProfile inner;
+    {
+        DdProfile::Activation const a(outer);
+        {
+            DdProfile::Activation const b(inner);
+            DdStructure<PathCountNode> dd(Combination(8, 3));
+        }
+        ASSERT_EQ(&outer, DdProfile::active());
+        DdStructure<PathCountNode> dd(Combination(5, 2));
+        dd.reduceZdd();
+    }
+    DdStructure<PathCountNode> dd(Combination(10, 3));
+    dd.reduceZdd();
+
+    ASSERT_EQ(8UL, inner.total(DdPhase::Construct).calls);
+    ASSERT_EQ(0UL, inner.total(DdPhase::Reduce).calls);
+    ASSERT_EQ(5UL, outer.total(DdPhase::Construct).calls);
+    ASSERT_EQ(5UL, outer.total(DdPhase::Reduce).calls);
+
+    outer.clear();
+    ASSERT_EQ(0UL, outer.total(DdPhase::Construct).calls);
+    ASSERT_EQ(0UL, outer.numLevels(DdPhase::Reduce));
+}
+
+TEST(ProfileTest, ActivatedOnlyOnItsThread) {
+    DdProfile profile;
+    bool      thrown = false;
+    std::thread([&] {
+        try {
+            DdProfile::Activation const on(profile);
+        } catch (std::runtime_error const&) {
+            thrown = true;
+        }
+        thrown = thrown && DdProfile::active() == nullptr;
+    }).join();
+    ASSERT_TRUE(thrown);
+    DdProfile::Activation const on(profile);
+    ASSERT_EQ(&profile, DdProfile::active());
+}
+
+TEST(ProfileTest, CountersDegradeGracefully) {
+    DdProfile profile;
+    {
+        DdProfile::Activation const on(profile);
+        DdStructure<PathCountNode> dd(Combination(60, 20));
+        dd.reduceZdd();
+    }
+    auto const construct = profile.total(DdPhase::Construct);
+    auto const sweep = profile.total(DdPhase::Sweep);
+    for (auto k = 0UL; k < PERF_EVENT_COUNT; ++k) {
+        auto const e = static_cast<PerfEvent>(k);
+        if (!profile.available(e)) {
+            ASSERT_EQ(0UL, construct[e]);
+        }
+    }
+    if (profile.available(PerfEvent::TaskClock)) {
+        ASSERT_GT(construct[PerfEvent::TaskClock], 0UL);
+        // sweeps run inside the construction of a level
+        ASSERT_LE(sweep[PerfEvent::TaskClock],
+                  construct[PerfEvent::TaskClock]);
+    }
+
+    std::ostringstream os;
+    profile.print(os);
+    auto const text = os.str();
+    ASSERT_NE(std::string::npos, text.find("construct"));
+    ASSERT_NE(std::string::npos, text.find("dtlb-misses"));
+    ASSERT_EQ(5, std::count(text.begin(), text.end(), '\n'));
+
+    std::ostringstream detailed;
+    profile.print(detailed, true);
+    ASSERT_NE(std::string::npos, detailed.str().find("  60"));
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddEval.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <algorithm>
+#include <limits>
+
+#include "TestNode.hpp"
+
+/**
+ * Node with the least number of 1-edges on a path to the 1-terminal.
+ */
+struct MinNode : NodeBase {
+    int cost{std::numeric_limits<int>::max()};
+
+    MinNode() = default;
+    MinNode(size_t i, size_t j) : NodeBase(i, j) {}
+};
+
+class MinEval : public Eval<MinNode, int> {
+   public:
+    void initialize_node(MinNode& n) const override {
+        n.cost = std::numeric_limits<int>::max();
+    }
+
+    void initialize_root_node(MinNode& n) const override { n.cost = 0; }
+
+    void evalNode(MinNode& n) const override {
+        auto* nodes = get_table();
+        auto  c0 = nodes->node(n[0]).cost;
+        auto  c1 = nodes->node(n[1]).cost;
+        if (c1 != std::numeric_limits<int>::max()) {
+            ++c1;
+        }
+        n.cost = std::min(c0, c1);
+    }
+
+    int get_objective(MinNode& n) const override { return n.cost; }
+};
+
+template <typename T, typename U>
+bool sameStructure(DdStructure<T> const& a, DdStructure<U> const& b) {
+    if (a.root() != b.root() || a.size() != b.size()) {
+        return false;
+    }
+    auto const& ta = *a.getDiagram();
+    auto const& tb = *b.getDiagram();
+    for (auto i = 1UL; i < ta.numRows(); ++i) {
+        if (ta[i].size() != tb[i].size()) {
+            return false;
+        }
+        for (auto j = 0UL; j < ta[i].size(); ++j) {
+            for (auto c = 0UL; c < 2; ++c) {
+                if (ta[i][j][c].code() != tb[i][j][c].code()) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+TEST(RebindTest, EvaluatesWithSeveralPayloads) {
+    DdStructure<TestNode> dd(Combination(10, 4));
+    dd.reduceZdd();
+
+    auto counted = dd.rebind<PathCountNode>();
+    auto minimum = dd.rebind<MinNode>();
+    ASSERT_TRUE(sameStructure(dd, counted));
+    ASSERT_TRUE(sameStructure(dd, minimum));
+
+    PathCountEval count;
+    MinEval       min;
+    ASSERT_EQ(210UL, counted.evaluate_backward(count));
+    ASSERT_EQ(countSets(dd), counted.evaluate_backward(count));
+    ASSERT_EQ(4, minimum.evaluate_backward(min));
+}
+
+TEST(RebindTest, MoveReleasesSource) {
+    DdStructure<TestNode> dd(Combination(12, 5));
+    DdStructure<TestNode> copy(dd);
+
+    auto counted = std::move(dd).rebind<PathCountNode>();
+    ASSERT_TRUE(sameStructure(copy, counted));
+    ASSERT_EQ(0UL, dd.size());
+    ASSERT_TRUE(dd.empty());
+
+    PathCountEval count;
+    ASSERT_EQ(792UL, counted.evaluate_backward(count));
+}
+
+TEST(RebindTest, MoveRejectsOpenCheckpoint) {
+    DdStructure<TestNode> dd(Combination(6, 2));
+    dd.reduceZdd();
+    dd.checkpoint();
+    ASSERT_THROW(std::move(dd).rebind<PathCountNode>(), std::runtime_error);
+    dd.rollback();
+
+    auto counted = dd.rebind<PathCountNode>();
+    ASSERT_TRUE(sameStructure(dd, counted));
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddStructure.hpp>
+#include <stdexcept>
+
+#include "TestNode.hpp"
+
+/**
+ * Weighted subsets with a global capacity and a tighter capacity that only
+ * applies to the decisions at or below level k.
+ */
+class Capacity : public DdSpec<Capacity, int, 2> {
+    int const n;
+    int const k;
+    int const cap;
+    int const lowCap;
+
+   public:
+    Capacity(int _n, int _k, int _cap, int _lowCap)
+        : n(_n),
+          k(_k),
+          cap(_cap),
+          lowCap(_lowCap) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state += value * (level % 5 + 1);
+        if (state > cap || (level <= k && state > lowCap)) {
+            return 0;
+        }
+        if (--level == 0) {
+            return -1;
+        }
+        if (level % 7 == 0 && state % 2 == 1) {
+            return (level > 1) ? level - 1 : -1;
+        }
+        return level;
+    }
+};
+
+/**
+ * Capacity with a cut: the nodes at level cut holding an odd sum are dead,
+ * so the builder sweeps them and cuts the edges above them.
+ */
+class OddCut : public DdSpec<OddCut, int, 2> {
+    Capacity const base;
+    int const      cut;
+
+   public:
+    OddCut(Capacity const& _base, int _cut) : base(_base), cut(_cut) {}
+
+    int getRoot(int& state) const { return base.getRoot(state); }
+
+    int getChild(int& state, int level, int value) const {
+        if (level == cut && state % 2 == 1) {
+            return 0;
+        }
+        return base.getChild(state, level, value);
+    }
+};
+
+TEST(RebuildBelowTest, MatchesFreshBuild) {
+    int const n = 24;
+    for (int k = 1; k < n; k += 4) {
+        for (int lowCap : {0, 7, 15, 40}) {
+            DdStructure<TestNode> dd(Capacity(n, k, 30, 40));
+            dd.rebuildBelow(Capacity(n, k, 30, lowCap), k);
+
+            DdStructure<TestNode> fresh(Capacity(n, k, 30, lowCap));
+            dd.reduceZdd();
+            fresh.reduceZdd();
+            ASSERT_EQ(fresh.size(), dd.size());
+            ASSERT_EQ(fresh, dd);
+        }
+    }
+}
+
+TEST(RebuildBelowTest, WholeDiagram) {
+    DdStructure<TestNode> dd(Capacity(12, 12, 30, 40));
+    dd.rebuildBelow(Capacity(12, 12, 30, 9), 12);
+
+    DdStructure<TestNode> fresh(Capacity(12, 12, 30, 9));
+    dd.reduceZdd();
+    fresh.reduceZdd();
+    ASSERT_EQ(fresh, dd);
+}
+
+TEST(RebuildBelowTest, RejectsChangesAboveLevel) {
+    DdStructure<TestNode> dd(Capacity(20, 5, 30, 40));
+    ASSERT_THROW(dd.rebuildBelow(Capacity(20, 5, 10, 40), 5),
+                 std::runtime_error);
+    ASSERT_EQ(0UL, dd.size());
+}
+
+TEST(RebuildBelowTest, ExpandsSweptEdges) {
+    int const n = 24;
+    for (int cut : {3, 5, 8}) {
+        for (int k : {1, 2}) {
+            for (int lowCap : {7, 40}) {
+                // the same spec above k
+                DdStructure<TestNode> dd(OddCut(Capacity(n, k, 30, 40), cut));
+                dd.rebuildBelow(OddCut(Capacity(n, k, 30, lowCap), cut), k);
+                DdStructure<TestNode> fresh(
+                    OddCut(Capacity(n, k, 30, lowCap), cut));
+                dd.reduceZdd();
+                fresh.reduceZdd();
+                ASSERT_EQ(fresh, dd);
+
+                // a looser spec restores the swept subdiagrams
+                DdStructure<TestNode> cutDd(
+                    OddCut(Capacity(n, k, 30, 40), cut));
+                cutDd.rebuildBelow(Capacity(n, k, 30, lowCap), k);
+                DdStructure<TestNode> full(Capacity(n, k, 30, lowCap));
+                cutDd.reduceZdd();
+                full.reduceZdd();
+                ASSERT_EQ(full, cutDd);
+            }
+        }
+    }
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddStatistics.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <ModernDD/spec/FrontierManager.hpp>
+#include <ModernDD/spec/PathSpec.hpp>
+#include <ModernDD/util/ThreadPool.hpp>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "TestNode.hpp"
+
+/**
+ * Straightforward serial computation of the statistics.
+ */
+DdStatistics reference(DdStructure<TestNode> const& dd) {
+    auto const&                         table = *dd.getDiagram();
+    auto const                          rows = table.numRows();
+    DdStatistics                        s;
+    std::set<std::pair<size_t, size_t>> reached;
+    std::vector<std::vector<size_t>>    parents(rows);
+    std::vector<std::vector<char>>      live(rows);
+
+    s.width.assign(rows, 0);
+    s.outDegree.assign(3, 0);
+    s.edgeLength.assign(rows, 0);
+    for (auto i = 1UL; i < rows; ++i) {
+        s.width[i] = table[i].size();
+        s.nodes += table[i].size();
+        parents[i].assign(table[i].size(), 0);
+        live[i].assign(table[i].size(), 0);
+    }
+    for (auto i = 1UL; i < rows; ++i) {
+        for (auto j = 0UL; j < table[i].size(); ++j) {
+            int d = 0;
+            for (int b = 0; b < 2; ++b) {
+                NodeId f = table.child(i, j, b);
+                if (f == 0) {
+                    ++s.zeroEdges;
+                    continue;
+                }
+                ++d;
+                ++s.edges;
+                ++s.edgeLength[i - f.row()];
+                if (f == 1) {
+                    ++s.oneEdges;
+                    live[i][j] = 1;
+                } else {
+                    ++parents[f.row()][f.col()];
+                    live[i][j] |= live[f.row()][f.col()];
+                }
+            }
+            ++s.outDegree[d];
+            s.live += live[i][j];
+        }
+    }
+    std::vector<NodeId> stack{dd.root()};
+    while (!stack.empty()) {
+        auto f = stack.back();
+        stack.pop_back();
+        if (f.row() == 0 || !reached.emplace(f.row(), f.col()).second) {
+            continue;
+        }
+        ++s.reachable;
+        s.useful += live[f.row()][f.col()];
+        stack.push_back(dd.child(f, 0));
+        stack.push_back(dd.child(f, 1));
+    }
+    for (auto i = 1UL; i < rows; ++i) {
+        for (auto d : parents[i]) {
+            if (s.inDegree.size() <= d) {
+                s.inDegree.resize(d + 1);
+            }
+            ++s.inDegree[d];
+        }
+    }
+    return s;
+}
+
+void expectEqual(DdStatistics const& a, DdStatistics const& b) {
+    ASSERT_EQ(a.width, b.width);
+    ASSERT_EQ(a.inDegree, b.inDegree);
+    ASSERT_EQ(a.outDegree, b.outDegree);
+    ASSERT_EQ(a.edgeLength, b.edgeLength);
+    ASSERT_EQ(a.nodes, b.nodes);
+    ASSERT_EQ(a.edges, b.edges);
+    ASSERT_EQ(a.zeroEdges, b.zeroEdges);
+    ASSERT_EQ(a.oneEdges, b.oneEdges);
+    ASSERT_EQ(a.reachable, b.reachable);
+    ASSERT_EQ(a.live, b.live);
+    ASSERT_EQ(a.useful, b.useful);
+}
+
+size_t countOf(std::string const& text, std::string const& token) {
+    size_t n = 0;
+    for (auto p = text.find(token); p != std::string::npos;
+         p = text.find(token, p + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+TEST(StatisticsTest, MatchesReference) {
+    DdStructure<TestNode> unreduced(Combination(12, 5));
+    DdStructure<TestNode> reduced(unreduced);
+    reduced.reduceZdd();
+    auto const            g = Graph::grid(5, 5);
+    DdStructure<TestNode> paths(SimplePathSpec(g, 0, 24));
+    paths.reduceZdd();
+
+    ThreadPool pool(3);
+    for (auto const* dd : {&unreduced, &reduced, &paths}) {
+        auto const expected = reference(*dd);
+        expectEqual(expected, DdStatisticsCollector<TestNode>().collect(*dd));
+        expectEqual(expected,
+                    DdStatisticsCollector<TestNode>(&pool).collect(*dd));
+    }
+
+    auto const s = DdStatisticsCollector<TestNode>().collect(reduced);
+    ASSERT_EQ(s.nodes, reduced.size());
+    ASSERT_EQ(s.nodes, s.useful);
+    ASSERT_EQ(1UL, s.inDegree[0]);
+    ASSERT_GT(s.longEdges(), 0UL);
+}
+
+TEST(StatisticsTest, ParallelChunksOnWideLevels) {
+    auto const            g = Graph::grid(7, 7);
+    DdStructure<TestNode> dd(SimplePathSpec(g, 0, 48));
+    dd.reduceZdd();
+
+    auto const s = DdStatisticsCollector<TestNode>().collect(dd);
+    expectEqual(reference(dd), s);
+    ThreadPool pool(4);
+    for (size_t grain : {1, 7, 64}) {
+        expectEqual(s, DdStatisticsCollector<TestNode>(&pool, grain)
+                           .collect(dd));
+    }
+}
+
+TEST(StatisticsTest, TerminalDiagrams) {
+    DdStructure<TestNode> one(Combination(4, 0));
+    one.reduceZdd();
+    DdStructure<TestNode> zero(Combination(4, 5));
+    for (auto const* dd : {&one, &zero}) {
+        auto const s = DdStatisticsCollector<TestNode>().collect(*dd);
+        expectEqual(reference(*dd), s);
+        ASSERT_EQ(0UL, s.reachable);
+    }
+}
+
+TEST(StatisticsTest, WritesWholeDiagram) {
+    DdStructure<TestNode> dd(Combination(10, 4));
+    dd.reduceZdd();
+    auto const s = DdStatisticsCollector<TestNode>().collect(dd);
+
+    std::ostringstream dot;
+    {
+        DdGraphWriter writer(dot, 64);
+        writer.write(dd, DdGraphFormat::Dot);
+    }
+    auto const text = dot.str();
+    ASSERT_EQ(0UL, text.find("digraph DD {\n"));
+    ASSERT_EQ(s.edges, countOf(text, " -> "));
+    ASSERT_EQ(s.nodes + 1, countOf(text, ";\n") - s.edges);
+    ASSERT_EQ(0UL, countOf(text, "L"));
+
+    std::ostringstream xml;
+    DdGraphWriter(xml).write(dd, DdGraphFormat::GraphML);
+    ASSERT_EQ(s.edges, countOf(xml.str(), "<edge "));
+    ASSERT_EQ(s.nodes + 1, countOf(xml.str(), "<node "));
+    ASSERT_EQ(1UL, countOf(xml.str(), "</graphml>"));
+}
+
+TEST(StatisticsTest, WritesSampledWindow) {
+    auto const            g = Graph::grid(5, 5);
+    DdStructure<TestNode> dd(SimplePathSpec(g, 0, 24));
+    dd.reduceZdd();
+    auto const& table = *dd.getDiagram();
+    auto const  window = DdGraphWindow::around(20, 2, 5);
+
+    std::ostringstream xml;
+    DdGraphWriter(xml).write(dd, DdGraphFormat::GraphML, window);
+    auto const text = xml.str();
+
+    size_t sampled = 0;
+    for (auto i = 18UL; i <= 22; ++i) {
+        sampled += std::min<size_t>(table[i].size(), 5);
+        ASSERT_NE(std::string::npos,
+                  text.find("<node id=\"n" + std::to_string(i) + "_0\""));
+    }
+    ASSERT_EQ(0UL, countOf(text, "<node id=\"n23_"));
+    ASSERT_EQ(0UL, countOf(text, "<node id=\"n17_"));
+    ASSERT_LE(countOf(text, "<node id=\"n"), sampled);
+    ASSERT_EQ(1UL, countOf(text, "<node id=\"L17\""));
+    ASSERT_EQ(0UL, countOf(text, "t1"));
+}
@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+
+#include <ModernDD/NodeBddFile.hpp>
+#include <ModernDD/NodeBddStreamSubsetter.hpp>
+#include <ModernDD/NodeBddStructure.hpp>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include "TestNode.hpp"
+
+/**
+ * Sets without two consecutive items; taking an item skips the next level.
+ */
+class NoNeighbours : public DdSpec<NoNeighbours, int, 2> {
+    int const n;
+
+   public:
+    explicit NoNeighbours(int _n) : n(_n) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int&, int level, int value) const {
+        level -= (value != 0) ? 2 : 1;
+        return (level <= 0) ? -1 : level;
+    }
+};
+
+/**
+ * Sets of the largest weight: the 1-terminal keeps only the heaviest
+ * state merged into it.
+ */
+class Heaviest : public DdSpec<Heaviest, int, 2> {
+    int const n;
+
+   public:
+    explicit Heaviest(int _n) : n(_n) {}
+
+    int getRoot(int& state) const {
+        state = 0;
+        return n;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state += value * (level % 3 + 1);
+        return (--level == 0) ? -1 : level;
+    }
+
+    int mergeStates(int& s1, int& s2) const {
+        return (s1 < s2) ? 1 : (s1 > s2) ? 2 : 0;
+    }
+};
+
+/**
+ * All subsets of {1,2,3}, where the four states reaching level 1 are equal
+ * and the first merge among them replaces the representative; the state
+ * records whether it took part in a merge, which equalTo ignores. The
+ * states reaching the 1-terminal are all kept.
+ */
+class ReplaceOnce : public DdSpec<ReplaceOnce, int, 2> {
+   public:
+    int getRoot(int& state) const {
+        state = 0;
+        return 3;
+    }
+
+    int getChild(int& state, int level, int value) const {
+        state = (level == 3) ? value * 2 : (level == 2) ? 4 : 6;
+        return (--level == 0) ? -1 : level;
+    }
+
+    size_t hashCode(int const& state) const {
+        return static_cast<size_t>(state / 2);
+    }
+
+    bool equalTo(int const& s1, int const& s2) const {
+        return s1 / 2 == s2 / 2;
+    }
+
+    int mergeStates(int& s1, int& s2) const {
+        if (s1 != 4) {
+            return 0;
+        }
+        s1 |= 1;
+        s2 |= 1;
+        return 1;
+    }
+};
+
+template <typename DD>
+std::set<std::set<int>> sets(DD const& dd) {
+    std::set<std::set<int>> s;
+    for (auto const& x : dd) {
+        s.insert(x);
+    }
+    return s;
+}
+
+class StreamSubsetTest : public ::testing::Test {
+   protected:
+    std::string const in = ::testing::TempDir() + "stream_subset_in.dd";
+    std::string const out = ::testing::TempDir() + "stream_subset_out.dd";
+
+    void TearDown() override {
+        std::remove(in.c_str());
+        std::remove(out.c_str());
+    }
+
+    template <typename SPEC>
+    void compare(DdStructure<TestNode> input, SPEC const& spec) {
+        saveDd(input, in);
+        {
+            DdFile const file(in);
+            zddSubsetFile(file, spec, out);
+        }
+        auto streamed = DdFile(out).load<TestNode>();
+        input.zddSubset(spec);
+        ASSERT_EQ(sets(input), sets(streamed));
+        input.reduceZdd();
+        streamed.reduceZdd();
+        ASSERT_EQ(input.size(), streamed.size());
+        ASSERT_EQ(input, streamed);
+        ASSERT_EQ(nullptr, std::fopen((out + ".rows.tmp").c_str(), "r"));
+    }
+};
+
+TEST_F(StreamSubsetTest, RoundTrip) {
+    DdStructure<TestNode> dd(Combination(10, 4));
+    dd.reduceZdd();
+    saveDd(dd, in);
+    DdFile const file(in);
+    ASSERT_EQ(dd.root(), file.root());
+    ASSERT_EQ(11UL, file.numRows());
+    auto const loaded = file.load<TestNode>();
+    ASSERT_EQ(dd.size(), loaded.size());
+    ASSERT_EQ(sets(dd), sets(loaded));
+    file.release(5);
+    ASSERT_EQ(dd.getDiagram()->child(5, 0, 1), file.child(5, 0, 1));
+}
+
+TEST_F(StreamSubsetTest, KeepsEdgeAttributes) {
+    DdStructure<TestNode> dd(NoNeighbours(12));
+    dd.reduceZdd();
+    ASSERT_TRUE(dd.root().getAttr());
+    saveDd(dd, in);
+    {
+        DdFile const file(in);
+        auto const&  table = *dd.getDiagram();
+        ASSERT_TRUE(file.root().getAttr());
+        for (auto i = 1UL; i < table.numRows(); ++i) {
+            for (auto j = 0UL; j < table[i].size(); ++j) {
+                for (int b = 0; b < 2; ++b) {
+                    ASSERT_EQ(table.child(i, j, b).getAttr(),
+                              file.child(i, j, b).getAttr());
+                }
+            }
+        }
+        auto const loaded = file.load<TestNode>();
+        ASSERT_EQ(dd, loaded);
+        ASSERT_EQ(sets(dd), sets(loaded));
+    }
+    compare(dd, Combination(12, 3));
+}
+
+TEST_F(StreamSubsetTest, MatchesInMemorySubset) {
+    DdStructure<TestNode> dd(Combination(16, 5));
+    dd.reduceZdd();
+    compare(dd, NoNeighbours(16));
+    compare(dd, Combination(16, 5));
+}
+
+TEST_F(StreamSubsetTest, LevelSkippingInput) {
+    compare(DdStructure<TestNode>(NoNeighbours(18)), Combination(18, 4));
+}
+
+TEST_F(StreamSubsetTest, MergesIntoTerminal) {
+    DdStructure<TestNode> dd(Combination(12, 4));
+    dd.reduceZdd();
+    compare(dd, Heaviest(12));
+    auto const streamed = DdFile(out).load<TestNode>();
+    ASSERT_EQ((std::set<std::set<int>>{{2, 5, 8, 11}}), sets(streamed));
+}
+
+TEST_F(StreamSubsetTest, MergesIntoReplacedRepresentative) {
+    // one level-1 node is dropped by the replacing merge; the two later
+    // states must share its replacement rather than the dropped node
+    DdStructure<TestNode> dd(ReplaceOnce{});
+    ASSERT_EQ(6UL, sets(dd).size());
+    compare(DdStructure<TestNode>(3), ReplaceOnce{});
+    ASSERT_EQ(6UL, sets(DdFile(out).load<TestNode>()).size());
+}
+
+TEST_F(StreamSubsetTest, TerminalResult) {
+    DdStructure<TestNode> dd(Combination(8, 9));
+    dd.reduceZdd();
+    saveDd(dd, in);
+    DdFile const file(in);
+    zddSubsetFile(file, NoNeighbours(8), out);
+    DdFile const result(out);
+    ASSERT_EQ(NodeId(0), result.root());
+    ASSERT_EQ(1UL, result.numRows());
+}
+
+TEST_F(StreamSubsetTest, RejectsBadFiles) {
+    ASSERT_THROW(DdFile{in}, std::runtime_error);
+    {
+        std::ofstream os(in, std::ios::binary);
+        os << "not a diagram file at all, but long enough";
+    }
+    ASSERT_THROW(DdFile{in}, std::runtime_error);
+}